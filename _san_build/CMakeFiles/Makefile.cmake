@@ -0,0 +1,72 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/host/CMakeLists.txt"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "host/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "host/CMakeFiles/pingpong_host.dir/DependInfo.cmake"
+  "host/CMakeFiles/pingpong_host_prof.dir/DependInfo.cmake"
+  "host/CMakeFiles/bench_pingpong.dir/DependInfo.cmake"
+  "host/CMakeFiles/bench_physics.dir/DependInfo.cmake"
+  "host/CMakeFiles/bench_multiball.dir/DependInfo.cmake"
+  "host/CMakeFiles/bench_ai.dir/DependInfo.cmake"
+  "host/CMakeFiles/bench_font.dir/DependInfo.cmake"
+  "host/CMakeFiles/bench_i2c.dir/DependInfo.cmake"
+  "host/CMakeFiles/bench_input.dir/DependInfo.cmake"
+  "host/CMakeFiles/bench_replay.dir/DependInfo.cmake"
+  "host/CMakeFiles/bench_panels.dir/DependInfo.cmake"
+  "host/CMakeFiles/bench_transport.dir/DependInfo.cmake"
+  "host/CMakeFiles/bench_netplay.dir/DependInfo.cmake"
+  "host/CMakeFiles/bench_profiler.dir/DependInfo.cmake"
+  "host/CMakeFiles/bench_power.dir/DependInfo.cmake"
+  "host/CMakeFiles/bench_stream.dir/DependInfo.cmake"
+  "host/CMakeFiles/bench_tearing.dir/DependInfo.cmake"
+  "host/CMakeFiles/bench_spsc.dir/DependInfo.cmake"
+  "host/CMakeFiles/bench_scheduler.dir/DependInfo.cmake"
+  "host/CMakeFiles/bench_spi_pio.dir/DependInfo.cmake"
+  "host/CMakeFiles/prof2chrome.dir/DependInfo.cmake"
+  "host/CMakeFiles/fbview.dir/DependInfo.cmake"
+  "host/CMakeFiles/ssd1306_dynamic.dir/DependInfo.cmake"
+  "host/CMakeFiles/ssd1306_fixed.dir/DependInfo.cmake"
+  "host/CMakeFiles/bench_draw.dir/DependInfo.cmake"
+  "host/CMakeFiles/bench_draw_fixed.dir/DependInfo.cmake"
+  "host/CMakeFiles/footprint.dir/DependInfo.cmake"
+  "host/CMakeFiles/trace.dir/DependInfo.cmake"
+  )
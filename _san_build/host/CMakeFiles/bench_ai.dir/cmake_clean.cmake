@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_ai.dir/bench_ai.c.o"
+  "CMakeFiles/bench_ai.dir/bench_ai.c.o.d"
+  "bench_ai"
+  "bench_ai.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/bench_ai.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/host/bench_draw.c" "host/CMakeFiles/bench_draw_fixed.dir/bench_draw.c.o" "gcc" "host/CMakeFiles/bench_draw_fixed.dir/bench_draw.c.o.d"
+  "/root/repo/host/hal.c" "host/CMakeFiles/bench_draw_fixed.dir/hal.c.o" "gcc" "host/CMakeFiles/bench_draw_fixed.dir/hal.c.o.d"
+  "/root/repo/host/ssd1306_emu.c" "host/CMakeFiles/bench_draw_fixed.dir/ssd1306_emu.c.o" "gcc" "host/CMakeFiles/bench_draw_fixed.dir/ssd1306_emu.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_draw_fixed.dir/bench_draw.c.o"
+  "CMakeFiles/bench_draw_fixed.dir/bench_draw.c.o.d"
+  "CMakeFiles/bench_draw_fixed.dir/hal.c.o"
+  "CMakeFiles/bench_draw_fixed.dir/hal.c.o.d"
+  "CMakeFiles/bench_draw_fixed.dir/ssd1306_emu.c.o"
+  "CMakeFiles/bench_draw_fixed.dir/ssd1306_emu.c.o.d"
+  "bench_draw_fixed"
+  "bench_draw_fixed.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/bench_draw_fixed.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_font.dir/bench_font.c.o"
+  "CMakeFiles/bench_font.dir/bench_font.c.o.d"
+  "bench_font"
+  "bench_font.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/bench_font.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
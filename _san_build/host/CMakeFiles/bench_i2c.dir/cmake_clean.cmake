@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_i2c.dir/bench_i2c.c.o"
+  "CMakeFiles/bench_i2c.dir/bench_i2c.c.o.d"
+  "bench_i2c"
+  "bench_i2c.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/bench_i2c.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
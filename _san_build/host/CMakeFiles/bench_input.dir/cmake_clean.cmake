@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_input.dir/bench_input.c.o"
+  "CMakeFiles/bench_input.dir/bench_input.c.o.d"
+  "bench_input"
+  "bench_input.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/bench_input.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_multiball.dir/bench_multiball.c.o"
+  "CMakeFiles/bench_multiball.dir/bench_multiball.c.o.d"
+  "bench_multiball"
+  "bench_multiball.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/bench_multiball.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
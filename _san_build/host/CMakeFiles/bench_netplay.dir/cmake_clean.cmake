@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_netplay.dir/bench_netplay.c.o"
+  "CMakeFiles/bench_netplay.dir/bench_netplay.c.o.d"
+  "bench_netplay"
+  "bench_netplay.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/bench_netplay.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_physics.dir/bench_physics.c.o"
+  "CMakeFiles/bench_physics.dir/bench_physics.c.o.d"
+  "bench_physics"
+  "bench_physics.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/bench_physics.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_spi_pio.dir/bench_spi_pio.c.o"
+  "CMakeFiles/bench_spi_pio.dir/bench_spi_pio.c.o.d"
+  "bench_spi_pio"
+  "bench_spi_pio.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/bench_spi_pio.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_tearing.dir/bench_tearing.c.o"
+  "CMakeFiles/bench_tearing.dir/bench_tearing.c.o.d"
+  "bench_tearing"
+  "bench_tearing.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/bench_tearing.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
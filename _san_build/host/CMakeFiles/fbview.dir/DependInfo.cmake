@@ -0,0 +1,20 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/libs/fbstream/fbstream.c" "host/CMakeFiles/fbview.dir/__/libs/fbstream/fbstream.c.o" "gcc" "host/CMakeFiles/fbview.dir/__/libs/fbstream/fbstream.c.o.d"
+  "/root/repo/host/fbview.c" "host/CMakeFiles/fbview.dir/fbview.c.o" "gcc" "host/CMakeFiles/fbview.dir/fbview.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/fbview.dir/__/libs/fbstream/fbstream.c.o"
+  "CMakeFiles/fbview.dir/__/libs/fbstream/fbstream.c.o.d"
+  "CMakeFiles/fbview.dir/fbview.c.o"
+  "CMakeFiles/fbview.dir/fbview.c.o.d"
+  "fbview"
+  "fbview.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/fbview.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
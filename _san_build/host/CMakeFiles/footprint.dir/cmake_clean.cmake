@@ -0,0 +1,8 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/footprint"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/footprint.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "libpingpong_host.a"
+)
@@ -0,0 +1,35 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/jogo.c" "host/CMakeFiles/pingpong_host_prof.dir/__/jogo.c.o" "gcc" "host/CMakeFiles/pingpong_host_prof.dir/__/jogo.c.o.d"
+  "/root/repo/libs/ai/ai.c" "host/CMakeFiles/pingpong_host_prof.dir/__/libs/ai/ai.c.o" "gcc" "host/CMakeFiles/pingpong_host_prof.dir/__/libs/ai/ai.c.o.d"
+  "/root/repo/libs/fbstream/fbstream.c" "host/CMakeFiles/pingpong_host_prof.dir/__/libs/fbstream/fbstream.c.o" "gcc" "host/CMakeFiles/pingpong_host_prof.dir/__/libs/fbstream/fbstream.c.o.d"
+  "/root/repo/libs/input/input.c" "host/CMakeFiles/pingpong_host_prof.dir/__/libs/input/input.c.o" "gcc" "host/CMakeFiles/pingpong_host_prof.dir/__/libs/input/input.c.o.d"
+  "/root/repo/libs/input/input_filter.c" "host/CMakeFiles/pingpong_host_prof.dir/__/libs/input/input_filter.c.o" "gcc" "host/CMakeFiles/pingpong_host_prof.dir/__/libs/input/input_filter.c.o.d"
+  "/root/repo/libs/netplay/netplay.c" "host/CMakeFiles/pingpong_host_prof.dir/__/libs/netplay/netplay.c.o" "gcc" "host/CMakeFiles/pingpong_host_prof.dir/__/libs/netplay/netplay.c.o.d"
+  "/root/repo/libs/physics/physics.c" "host/CMakeFiles/pingpong_host_prof.dir/__/libs/physics/physics.c.o" "gcc" "host/CMakeFiles/pingpong_host_prof.dir/__/libs/physics/physics.c.o.d"
+  "/root/repo/libs/physics/physics_balls.c" "host/CMakeFiles/pingpong_host_prof.dir/__/libs/physics/physics_balls.c.o" "gcc" "host/CMakeFiles/pingpong_host_prof.dir/__/libs/physics/physics_balls.c.o.d"
+  "/root/repo/libs/profiler/profiler.c" "host/CMakeFiles/pingpong_host_prof.dir/__/libs/profiler/profiler.c.o" "gcc" "host/CMakeFiles/pingpong_host_prof.dir/__/libs/profiler/profiler.c.o.d"
+  "/root/repo/libs/replay/replay.c" "host/CMakeFiles/pingpong_host_prof.dir/__/libs/replay/replay.c.o" "gcc" "host/CMakeFiles/pingpong_host_prof.dir/__/libs/replay/replay.c.o.d"
+  "/root/repo/libs/scheduler/scheduler.c" "host/CMakeFiles/pingpong_host_prof.dir/__/libs/scheduler/scheduler.c.o" "gcc" "host/CMakeFiles/pingpong_host_prof.dir/__/libs/scheduler/scheduler.c.o.d"
+  "/root/repo/libs/spsc/spsc.c" "host/CMakeFiles/pingpong_host_prof.dir/__/libs/spsc/spsc.c.o" "gcc" "host/CMakeFiles/pingpong_host_prof.dir/__/libs/spsc/spsc.c.o.d"
+  "/root/repo/libs/ssd1306/ssd1306.c" "host/CMakeFiles/pingpong_host_prof.dir/__/libs/ssd1306/ssd1306.c.o" "gcc" "host/CMakeFiles/pingpong_host_prof.dir/__/libs/ssd1306/ssd1306.c.o.d"
+  "/root/repo/libs/ssd1306/ssd1306_spi.c" "host/CMakeFiles/pingpong_host_prof.dir/__/libs/ssd1306/ssd1306_spi.c.o" "gcc" "host/CMakeFiles/pingpong_host_prof.dir/__/libs/ssd1306/ssd1306_spi.c.o.d"
+  "/root/repo/host/hal.c" "host/CMakeFiles/pingpong_host_prof.dir/hal.c.o" "gcc" "host/CMakeFiles/pingpong_host_prof.dir/hal.c.o.d"
+  "/root/repo/host/ssd1306_emu.c" "host/CMakeFiles/pingpong_host_prof.dir/ssd1306_emu.c.o" "gcc" "host/CMakeFiles/pingpong_host_prof.dir/ssd1306_emu.c.o.d"
+  "/root/repo/host/transport_mock.c" "host/CMakeFiles/pingpong_host_prof.dir/transport_mock.c.o" "gcc" "host/CMakeFiles/pingpong_host_prof.dir/transport_mock.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
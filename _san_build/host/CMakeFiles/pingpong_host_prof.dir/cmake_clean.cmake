@@ -0,0 +1,43 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/pingpong_host_prof.dir/__/jogo.c.o"
+  "CMakeFiles/pingpong_host_prof.dir/__/jogo.c.o.d"
+  "CMakeFiles/pingpong_host_prof.dir/__/libs/ai/ai.c.o"
+  "CMakeFiles/pingpong_host_prof.dir/__/libs/ai/ai.c.o.d"
+  "CMakeFiles/pingpong_host_prof.dir/__/libs/fbstream/fbstream.c.o"
+  "CMakeFiles/pingpong_host_prof.dir/__/libs/fbstream/fbstream.c.o.d"
+  "CMakeFiles/pingpong_host_prof.dir/__/libs/input/input.c.o"
+  "CMakeFiles/pingpong_host_prof.dir/__/libs/input/input.c.o.d"
+  "CMakeFiles/pingpong_host_prof.dir/__/libs/input/input_filter.c.o"
+  "CMakeFiles/pingpong_host_prof.dir/__/libs/input/input_filter.c.o.d"
+  "CMakeFiles/pingpong_host_prof.dir/__/libs/netplay/netplay.c.o"
+  "CMakeFiles/pingpong_host_prof.dir/__/libs/netplay/netplay.c.o.d"
+  "CMakeFiles/pingpong_host_prof.dir/__/libs/physics/physics.c.o"
+  "CMakeFiles/pingpong_host_prof.dir/__/libs/physics/physics.c.o.d"
+  "CMakeFiles/pingpong_host_prof.dir/__/libs/physics/physics_balls.c.o"
+  "CMakeFiles/pingpong_host_prof.dir/__/libs/physics/physics_balls.c.o.d"
+  "CMakeFiles/pingpong_host_prof.dir/__/libs/profiler/profiler.c.o"
+  "CMakeFiles/pingpong_host_prof.dir/__/libs/profiler/profiler.c.o.d"
+  "CMakeFiles/pingpong_host_prof.dir/__/libs/replay/replay.c.o"
+  "CMakeFiles/pingpong_host_prof.dir/__/libs/replay/replay.c.o.d"
+  "CMakeFiles/pingpong_host_prof.dir/__/libs/scheduler/scheduler.c.o"
+  "CMakeFiles/pingpong_host_prof.dir/__/libs/scheduler/scheduler.c.o.d"
+  "CMakeFiles/pingpong_host_prof.dir/__/libs/spsc/spsc.c.o"
+  "CMakeFiles/pingpong_host_prof.dir/__/libs/spsc/spsc.c.o.d"
+  "CMakeFiles/pingpong_host_prof.dir/__/libs/ssd1306/ssd1306.c.o"
+  "CMakeFiles/pingpong_host_prof.dir/__/libs/ssd1306/ssd1306.c.o.d"
+  "CMakeFiles/pingpong_host_prof.dir/__/libs/ssd1306/ssd1306_spi.c.o"
+  "CMakeFiles/pingpong_host_prof.dir/__/libs/ssd1306/ssd1306_spi.c.o.d"
+  "CMakeFiles/pingpong_host_prof.dir/hal.c.o"
+  "CMakeFiles/pingpong_host_prof.dir/hal.c.o.d"
+  "CMakeFiles/pingpong_host_prof.dir/ssd1306_emu.c.o"
+  "CMakeFiles/pingpong_host_prof.dir/ssd1306_emu.c.o.d"
+  "CMakeFiles/pingpong_host_prof.dir/transport_mock.c.o"
+  "CMakeFiles/pingpong_host_prof.dir/transport_mock.c.o.d"
+  "libpingpong_host_prof.a"
+  "libpingpong_host_prof.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/pingpong_host_prof.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/prof2chrome.dir/prof2chrome.c.o"
+  "CMakeFiles/prof2chrome.dir/prof2chrome.c.o.d"
+  "prof2chrome"
+  "prof2chrome.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/prof2chrome.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ssd1306_fixed.dir/__/libs/ssd1306/ssd1306.c.o"
+  "CMakeFiles/ssd1306_fixed.dir/__/libs/ssd1306/ssd1306.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/ssd1306_fixed.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,182 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "libs/ai/ai.h"
+
+// Ralis simulados contra a IA da raquete direita. A raquete esquerda nunca
+// erra e devolve a bola com um desvio aleatório no ponto de contato, para
+// variar ângulos. Mede a taxa de rebatidas da IA em cada nível (e da IA
+// antiga, que só perseguia a bola) e depois o custo por decisão, repetindo
+// as bolas gravadas durante os ralis num laço sem nada além da IA.
+
+#define FIELD_W 128
+#define FIELD_H 64
+#define PADDLE_W 4
+#define PADDLE_H 16
+#define BALL 4
+#define MAX_TICKS_PER_POINT 20000
+#define TRACE_LEN (1 << 20)
+
+static phys_ball_t trace[TRACE_LEN];
+static unsigned long trace_len;
+
+static uint32_t rng_state = 1;
+
+static uint32_t rng(void) {
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 17;
+  rng_state ^= rng_state << 5;
+  return rng_state;
+}
+
+static double wall_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static const phys_config_t cfg = {
+  .width = Q16_FROM_INT(FIELD_W),
+  .height = Q16_FROM_INT(FIELD_H),
+  .speed_base = Q16_FROM_INT(2),
+  .speed_step = Q16_FRAC(1, 8),
+  .speed_max = Q16_FROM_INT(12),
+  .max_slope = Q16_ONE,
+};
+
+static q16_t clamp_paddle(q16_t y) {
+  q16_t limit = Q16_FROM_INT(FIELD_H - PADDLE_H);
+  return y < 0 ? 0 : y > limit ? limit : y;
+}
+
+// IA antiga: centro da raquete perseguindo a bola a 2 px/tick
+static q16_t chase(q16_t y, const phys_ball_t *ball) {
+  q16_t center = y + Q16_FROM_INT(PADDLE_H / 2);
+  if (center < ball->y)
+    y += Q16_FROM_INT(2);
+  else if (center > ball->y)
+    y -= Q16_FROM_INT(2);
+  return clamp_paddle(y);
+}
+
+typedef struct {
+  unsigned long hits, misses;
+  uint32_t predictions;
+} result_t;
+
+static result_t play(int level, unsigned long points) {
+  result_t r = { 0 };
+  phys_box_t pads[PHYS_PADDLE_COUNT] = {
+    { 0, 0, Q16_FROM_INT(PADDLE_W), Q16_FROM_INT(PADDLE_H) },
+    { Q16_FROM_INT(FIELD_W - PADDLE_W), 0, Q16_FROM_INT(PADDLE_W), Q16_FROM_INT(PADDLE_H) },
+  };
+  phys_ball_t ball = { .size = Q16_FROM_INT(BALL) };
+  ai_t ai;
+  q16_t offset = 0;
+
+  rng_state = 1;
+  ai_init(&ai, level < 0 ? AI_MEDIUM : level, false, 0, 1);
+
+  for (unsigned long p = 0; p < points; ++p) {
+    q16_t start = Q16_FROM_INT((FIELD_H - PADDLE_H) / 2);
+    ai_reset(&ai, start);
+    pads[PHYS_PADDLE_RIGHT].y = start;
+    phys_serve(&cfg, &ball, -1, (rng() & 1) ? 1 : -1);
+
+    for (int t = 0; t < MAX_TICKS_PER_POINT; ++t) {
+      // Raquete esquerda perfeita, com o contato sorteado ao longo da face
+      pads[PHYS_PADDLE_LEFT].y = clamp_paddle(ball.y + ball.size / 2 - pads[0].h / 2 + offset);
+
+      if (trace_len < TRACE_LEN)
+        trace[trace_len++] = ball;
+      if (level < 0) {
+        pads[PHYS_PADDLE_RIGHT].y = chase(pads[PHYS_PADDLE_RIGHT].y, &ball);
+      } else {
+        ai_update(&ai, &cfg, &ball, &pads[PHYS_PADDLE_RIGHT]);
+        pads[PHYS_PADDLE_RIGHT].y = ai.y;
+      }
+
+      unsigned events = phys_step(&cfg, &ball, pads);
+      if (events & PHYS_EVENT_HIT_LEFT)
+        offset = (q16_t)(rng() % Q16_FROM_INT(PADDLE_H + BALL - 2)) - Q16_FROM_INT(PADDLE_H + BALL - 2) / 2;
+      if (events & PHYS_EVENT_HIT_RIGHT)
+        r.hits++;
+      if (events & PHYS_EVENT_OUT_RIGHT) {
+        r.misses++;
+        break;
+      }
+      if (events & PHYS_EVENT_OUT_LEFT)
+        break;
+    }
+  }
+  r.predictions = ai.predictions;
+  return r;
+}
+
+// Custo da decisão: a IA de cada nível sobre a sequência gravada de bolas
+static double ns_per_decision(int level) {
+  phys_box_t pad = { Q16_FROM_INT(FIELD_W - PADDLE_W), 0, Q16_FROM_INT(PADDLE_W), Q16_FROM_INT(PADDLE_H) };
+  volatile q16_t sink = 0;
+  ai_t ai;
+
+  ai_init(&ai, level, false, 0, 1);
+  double start = wall_seconds();
+  for (int rep = 0; rep < 8; ++rep) {
+    for (unsigned long i = 0; i < trace_len; ++i) {
+      ai_update(&ai, &cfg, &trace[i], &pad);
+      pad.y = ai.y;
+    }
+  }
+  sink += ai.y;
+  return (wall_seconds() - start) * 1e9 / (8.0 * trace_len);
+}
+
+// Bola sacada de novo com a mesma velocidade, de outra altura, sem ai_reset
+// (a multibola e a demonstração sacam assim): a previsão em cache não vale
+static bool check_reserve(void) {
+  phys_box_t pads[PHYS_PADDLE_COUNT] = {
+    { 0, 0, Q16_FROM_INT(PADDLE_W), Q16_FROM_INT(PADDLE_H) },
+    { Q16_FROM_INT(FIELD_W - PADDLE_W), 0, Q16_FROM_INT(PADDLE_W), Q16_FROM_INT(PADDLE_H) },
+  };
+  const phys_box_t *pad = &pads[PHYS_PADDLE_RIGHT];
+  phys_ball_t ball = { .size = Q16_FROM_INT(BALL) };
+  ai_t ai;
+
+  ai_init(&ai, AI_HARD, false, 0, 1);
+  phys_serve(&cfg, &ball, 1, 1);
+  for (int t = 0; t < 20; ++t) {
+    ai_update(&ai, &cfg, &ball, pad);
+    phys_step(&cfg, &ball, pads);
+  }
+  uint32_t before = ai.predictions;
+  phys_serve(&cfg, &ball, 1, 1);
+  ball.y = Q16_FROM_INT(4);
+  ai_update(&ai, &cfg, &ball, pad);
+  q16_t expected = ai_predict_y(&cfg, &ball, pad->x) + ball.size / 2 - pad->h / 2;
+  q16_t error = ai.pending_target - clamp_paddle(expected);
+  bool ok = ai.predictions == before + 1 && error <= ai_levels[AI_HARD].max_error &&
+            error >= -ai_levels[AI_HARD].max_error;
+  printf("novo saque com a mesma velocidade: %s\n", ok ? "previsao refeita, ok" : "previsao velha, ERRO");
+  return ok;
+}
+
+int main(int argc, char **argv) {
+  unsigned long points = argc > 1 ? strtoul(argv[1], NULL, 0) : 5000;
+  static const char *names[] = { "perseguicao", "facil", "medio", "dificil" };
+
+  printf("%lu pontos por nivel\n", points);
+  for (int level = -1; level < AI_LEVEL_COUNT; ++level) {
+    result_t r = play(level, points);
+    unsigned long returns = r.hits + r.misses;
+    printf("%-12s rebatidas %6lu  erros %5lu  acerto %5.1f%%  rebatidas/ponto %6.1f",
+           names[level + 1], r.hits, r.misses, returns ? 100.0 * r.hits / returns : 0.0,
+           (double)r.hits / points);
+    if (level >= 0)
+      printf("  %7u previsoes", r.predictions);
+    printf("\n");
+  }
+  for (int level = 0; level < AI_LEVEL_COUNT; ++level)
+    printf("custo %-8s %.1f ns/decisao (%lu bolas gravadas)\n", names[level + 1], ns_per_decision(level), trace_len);
+  return check_reserve() ? 0 : 1;
+}
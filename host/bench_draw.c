@@ -0,0 +1,302 @@
+#include <malloc.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "host_hal.h"
+#include "libs/ssd1306/ssd1306.h"
+
+// Mede as rotinas de desenho e a varredura de regiões alteradas do driver.
+// O mesmo programa é compilado contra a variante dinâmica (bench_draw) e a
+// de geometria fixa (bench_draw_fixed); os dois imprimem o hash do buffer
+// final, que precisa ser igual, e a memória que o painel ocupa dentro do
+// ssd1306_t e no heap.
+//
+// Antes de medir, confere byte a byte os caminhos por bytes e máscaras de
+// rect, hline, vline, blit e fill contra versões pixel a pixel (as rotinas
+// antigas, com recorte): operações aleatórias sobre um buffer aleatório,
+// com bordas recortadas em x e y, páginas parciais e larguras que não são
+// múltiplas de 4. A tabela de tempos mostra as duas versões.
+
+#define REPEAT 200000
+#define GOLDEN_OPS 200000
+
+static double wall_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint32_t fnv1a(const uint8_t *data, size_t len) {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < len; ++i)
+    hash = (hash ^ data[i]) * 16777619u;
+  return hash;
+}
+
+static ssd1306_t disp, ref;
+static ssd1306_emu_t emu;
+static volatile uint8_t sink;
+
+// Referências pixel a pixel; ssd1306_pixel descarta o que sai da tela
+static void ref_pixel(ssd1306_t *ssd, int x, int y, bool value) {
+  if (x >= 0 && x < 256 && y >= 0 && y < 256)
+    ssd1306_pixel(ssd, x, y, value);
+}
+
+static void ref_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value,
+                     bool fill) {
+  for (int x = left; x < left + width; ++x)
+    for (int y = top; y < top + height; ++y)
+      if (fill || x == left || x == left + width - 1 || y == top || y == top + height - 1)
+        ref_pixel(ssd, x, y, value);
+}
+
+static void ref_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
+  for (int x = x0; x <= x1; ++x)
+    ref_pixel(ssd, x, y, value);
+}
+
+static void ref_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
+  for (int y = y0; y <= y1; ++y)
+    ref_pixel(ssd, x, y, value);
+}
+
+static void ref_blit(ssd1306_t *ssd, const uint8_t *sprite, uint8_t width, uint8_t height, int x, int y,
+                     bool value) {
+  uint8_t src_pages = (height + 7) / 8;
+  for (int col = 0; col < width; ++col)
+    for (int row = 0; row < height; ++row)
+      if (sprite[col * src_pages + row / 8] >> (row & 7) & 1)
+        ref_pixel(ssd, x + col, y + row, value);
+}
+
+static void ref_fill(ssd1306_t *ssd, bool value) {
+  for (int y = 0; y < ssd->height; ++y)
+    for (int x = 0; x < ssd->width; ++x)
+      ref_pixel(ssd, x, y, value);
+}
+
+static uint32_t lcg(uint32_t *state) {
+  *state = *state * 1664525u + 1013904223u;
+  return *state >> 8;
+}
+
+// Coordenada perto das bordas com frequência: dentro, na borda ou além dela
+static uint8_t edge_coord(uint32_t *rng, unsigned limit) {
+  switch (lcg(rng) % 4) {
+  case 0: return lcg(rng) % 8;
+  case 1: return limit - 1 - lcg(rng) % 8;
+  case 2: return limit + lcg(rng) % 8;
+  default: return lcg(rng) % limit;
+  }
+}
+
+// Operações aleatórias nos dois buffers; devolve quantas deixaram o buffer
+// diferente da referência (e imprime a primeira)
+static unsigned golden_check(void) {
+  static const char *const names[] = { "rect", "rect cheio", "hline", "vline", "blit", "fill" };
+  uint32_t rng = 12345;
+  unsigned mismatches = 0, counts[6] = { 0 };
+  uint8_t sprite[16 * 3];
+
+  for (size_t i = 1; i < disp.bufsize; ++i)
+    disp.ram_buffer[i] = ref.ram_buffer[i] = lcg(&rng);
+
+  for (int n = 0; n < GOLDEN_OPS; ++n) {
+    unsigned op = lcg(&rng) % 6;
+    bool value = lcg(&rng) & 1;
+    uint8_t x = edge_coord(&rng, WIDTH), y = edge_coord(&rng, HEIGHT);
+    uint8_t w = 1 + lcg(&rng) % 23, h = 1 + lcg(&rng) % 23;
+    if (lcg(&rng) % 16 == 0)
+      w = 250 + lcg(&rng) % 6;                    // left + width passa de 255
+
+    switch (op) {
+    case 0:
+    case 1:
+      ssd1306_rect(&disp, y, x, w, h, value, op == 1);
+      ref_rect(&ref, y, x, w, h, value, op == 1);
+      break;
+    case 2: {
+      uint8_t x1 = x + lcg(&rng) % 40;
+      ssd1306_hline(&disp, x, x1, y, value);
+      ref_hline(&ref, x, x1, y, value);
+      break;
+    }
+    case 3: {
+      uint8_t y1 = y + lcg(&rng) % 30;
+      ssd1306_vline(&disp, x, y, y1, value);
+      ref_vline(&ref, x, y, y1, value);
+      break;
+    }
+    case 4: {
+      uint8_t sw = 1 + lcg(&rng) % 16, sh = 1 + lcg(&rng) % 20;
+      int sx = (int)(lcg(&rng) % (WIDTH + 32)) - 16, sy = (int)(lcg(&rng) % (HEIGHT + 32)) - 16;
+      for (unsigned b = 0; b < sizeof(sprite); ++b)
+        sprite[b] = lcg(&rng);
+      ssd1306_blit(&disp, sprite, sw, sh, sx, sy, value);
+      ref_blit(&ref, sprite, sw, sh, sx, sy, value);
+      break;
+    }
+    default:
+      if (lcg(&rng) % 64)                         // Fill raro, senão apaga o que os outros testam
+        continue;
+      ssd1306_fill(&disp, value);
+      ref_fill(&ref, value);
+      for (size_t i = 1; i < disp.bufsize; i += 1 + lcg(&rng) % 5)
+        disp.ram_buffer[i] = ref.ram_buffer[i] = lcg(&rng);
+      break;
+    }
+
+    counts[op]++;
+    if (memcmp(disp.ram_buffer + 1, ref.ram_buffer + 1, disp.bufsize - 1)) {
+      if (!mismatches++)
+        printf("ERRO: %s (x %u, y %u, %ux%u, cor %d) difere da referência pixel a pixel\n", names[op], x, y, w, h,
+               value);
+      memcpy(ref.ram_buffer + 1, disp.ram_buffer + 1, disp.bufsize - 1);
+    }
+  }
+  printf("referência pixel a pixel: %d operações (rect %u, cheio %u, hline %u, vline %u, blit %u, fill %u), "
+         "%u diferenças\n",
+         GOLDEN_OPS, counts[0], counts[1], counts[2], counts[3], counts[4], counts[5], mismatches);
+  return mismatches;
+}
+
+static void op_pixel(int i) {
+  for (uint8_t y = 0; y < HEIGHT; y += 4)
+    ssd1306_pixel(&disp, (i + y) & 127, y, (i >> 3) & 1);
+}
+
+static void op_rect(int i) {
+  ssd1306_rect(&disp, i & 31, 3, 4, 20, true, true);
+  ssd1306_rect(&disp, 0, 0, WIDTH, HEIGHT, true, false);
+}
+
+static void op_rect_ref(int i) {
+  ref_rect(&disp, i & 31, 3, 4, 20, true, true);
+  ref_rect(&disp, 0, 0, WIDTH, HEIGHT, true, false);
+}
+
+static void op_lines(int i) {
+  ssd1306_vline(&disp, WIDTH / 2, 0, HEIGHT - 1, i & 1);
+  ssd1306_hline(&disp, 0, WIDTH - 1, i & 63, true);
+}
+
+static void op_lines_ref(int i) {
+  ref_vline(&disp, WIDTH / 2, 0, HEIGHT - 1, i & 1);
+  ref_hline(&disp, 0, WIDTH - 1, i & 63, true);
+}
+
+static void op_line(int i) {
+  ssd1306_line(&disp, 0, 0, WIDTH - 1, i & 63, true);
+}
+
+static const uint8_t ball[4] = { 0x06, 0x0F, 0x0F, 0x06 };
+
+static void op_blit(int i) {
+  ssd1306_blit(&disp, ball, 4, 4, i & 127, (i >> 2) & 63, true);
+}
+
+static void op_blit_ref(int i) {
+  ref_blit(&disp, ball, 4, 4, i & 127, (i >> 2) & 63, true);
+}
+
+static void op_text(int i) {
+  ssd1306_draw_string(&disp, "12 - 34", (i & 7) * 8, 24 + (i & 3));
+}
+
+static void op_fill(int i) {
+  ssd1306_fill(&disp, i & 1);
+}
+
+static void op_fill_ref(int i) {
+  ref_fill(&disp, i & 1);
+}
+
+static double time_op(void (*op)(int)) {
+  double start = wall_seconds();
+  for (int i = 0; i < REPEAT; ++i)
+    op(i);
+  sink = disp.ram_buffer[1 + (REPEAT & 1023)];
+  return (wall_seconds() - start) * 1e9 / REPEAT;
+}
+
+// Cena de raquetes e bola como a do jogo: a cada quadro só algumas colunas
+// mudam e a varredura de regiões alteradas decide o que enviar
+static void draw_scene(int frame) {
+  ssd1306_fill(&disp, false);
+  ssd1306_rect(&disp, 0, 0, WIDTH, HEIGHT, true, false);
+  ssd1306_rect(&disp, 10 + (frame % 30), 2, 2, 16, true, true);
+  ssd1306_rect(&disp, 40 - (frame % 30), WIDTH - 4, 2, 16, true, true);
+  ssd1306_rect(&disp, 8 + (frame * 3) % 48, 8 + (frame * 5) % 112, 3, 3, true, true);
+  ssd1306_draw_string(&disp, "3 - 2", 44, 2);
+}
+
+int main(void) {
+  static const struct { const char *name; void (*op)(int); void (*ref)(int); } ops[] = {
+    { "pixel (16)", op_pixel, NULL },
+    { "rect", op_rect, op_rect_ref },
+    { "hline/vline", op_lines, op_lines_ref },
+    { "line", op_line, NULL },
+    { "blit 4x4", op_blit, op_blit_ref },
+    { "texto 7 car.", op_text, NULL },
+    { "fill", op_fill, op_fill_ref },
+  };
+
+  hal_reset();
+  ssd1306_emu_reset(&emu);
+  i2c_init(i2c1, 400000);
+  hal_i2c_attach(i2c1, 0x3C, &emu);
+
+  size_t heap_before = mallinfo2().uordblks;
+  bool ok = ssd1306_init(&disp, WIDTH, HEIGHT, false, 0x3C, i2c1);
+  ssd1306_config(&disp);
+  ssd1306_fill(&disp, false);
+  ssd1306_send_data_async(&disp);
+  ssd1306_wait(&disp);
+  size_t heap = mallinfo2().uordblks - heap_before;
+
+  printf("variante %s: ssd1306_t %zu bytes, heap %zu bytes\n",
+         SSD1306_FIXED ? "fixa" : "dinâmica", sizeof(ssd1306_t), heap);
+  if (!ok) {
+    printf("ERRO: ssd1306_init falhou\n");
+    return 1;
+  }
+
+  if (!ssd1306_init(&ref, WIDTH, HEIGHT, false, 0x3C, NULL) || golden_check()) {
+    ssd1306_deinit(&ref);
+    return 1;
+  }
+  ssd1306_deinit(&ref);
+  ssd1306_fill(&disp, false);
+
+  printf("%-18s %10s %10s\n", "rotina", "pixel a px", "atual");
+  for (size_t i = 0; i < sizeof(ops) / sizeof(ops[0]); ++i) {
+    if (!ops[i].ref) {
+      printf("%-18s %10s %7.1f ns\n", ops[i].name, "", time_op(ops[i].op));
+      continue;
+    }
+    double old = time_op(ops[i].ref), now = time_op(ops[i].op);
+    printf("%-18s %7.1f ns %7.1f ns  (%.1fx)\n", ops[i].name, old, now, old / now);
+  }
+
+  double encode = 0;
+  for (int frame = 0; frame < REPEAT / 10; ++frame) {
+    draw_scene(frame);
+    double start = wall_seconds();
+    ssd1306_send_data_async(&disp);
+    encode += wall_seconds() - start;
+    ssd1306_wait(&disp);
+  }
+  printf("%-18s %7.1f ns\n", "varredura+DMA", encode * 1e9 / (REPEAT / 10));
+
+  for (uint8_t x = 0; x < WIDTH; ++x)
+    for (uint8_t page = 0; page < HEIGHT / 8; ++page)
+      if (ssd1306_emu_column_byte(&emu, x, page) != disp.ram_buffer[1 + x * (HEIGHT / 8) + page])
+        ok = false;
+  printf("hash do buffer %08x  GRAM %s\n", fnv1a(disp.ram_buffer, disp.bufsize), ok ? "ok" : "DIFERENTE");
+
+  ssd1306_deinit(&disp);
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,108 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "libs/ssd1306/ssd1306.h"
+#include "libs/ssd1306/font.h"
+
+// Compara o desenho de texto antigo (busca do glifo por faixas if/else e 64
+// chamadas a ssd1306_pixel por caractere) com o atlas ASCII em colunas:
+// confere que os dois geram o mesmo buffer para letras e dígitos e mede ns
+// por string nas variantes fixa, proporcional e pré-renderizada.
+
+#define REPEAT 2000000
+
+static double wall_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// ssd1306_draw_char como era antes do atlas
+static void legacy_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y) {
+  const uint8_t *glyph;
+
+  if (c >= 'A' && c <= 'Z')
+    glyph = font['A' - FONT_FIRST + (c - 'A')];
+  else if (c >= 'a' && c <= 'z')
+    glyph = font['a' - FONT_FIRST + (c - 'a')];
+  else if (c >= '0' && c <= '9')
+    glyph = font['0' - FONT_FIRST + (c - '0')];
+  else
+    glyph = font[0];
+
+  for (uint8_t i = 0; i < 8; ++i) {
+    uint8_t line = glyph[i];
+    for (uint8_t j = 0; j < 8; ++j)
+      ssd1306_pixel(ssd, x + i, y + j, (line & (1 << j)) ? 1 : 0);
+  }
+}
+
+static void legacy_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y) {
+  while (*str) {
+    legacy_draw_char(ssd, *str++, x, y);
+    x += 8;
+    if (x + 8 >= ssd->width) {
+      x = 0;
+      y += 8;
+    }
+    if (y + 8 >= ssd->height)
+      break;
+  }
+}
+
+static double time_string(void (*draw)(ssd1306_t *, const char *, uint8_t, uint8_t), ssd1306_t *ssd,
+                          const char *str, uint8_t y) {
+  double start = wall_seconds();
+  for (int i = 0; i < REPEAT; ++i)
+    draw(ssd, str, 8, y);
+  return (wall_seconds() - start) * 1e9 / REPEAT;
+}
+
+static void draw_prop(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y) {
+  ssd1306_draw_string_prop(ssd, str, x, y);
+}
+
+int main(void) {
+  static const char *strings[] = { "0 - 0", "12 - 34", "Ping Pong RP2040" };
+  ssd1306_t a, b;
+  int mismatches = 0;
+
+  ssd1306_init(&a, WIDTH, HEIGHT, false, 0x3C, NULL);
+  ssd1306_init(&b, WIDTH, HEIGHT, false, 0x3C, NULL);
+
+  // Mesmo resultado para os caracteres que a fonte antiga tinha
+  for (uint8_t y = 0; y < 16; ++y) {
+    memset(a.ram_buffer + 1, 0x5A, a.bufsize - 1);
+    memset(b.ram_buffer + 1, 0x5A, b.bufsize - 1);
+    legacy_draw_string(&a, "AZaz09 Pong", 3, y);
+    ssd1306_draw_string(&b, "AZaz09 Pong", 3, y);
+    if (memcmp(a.ram_buffer, b.ram_buffer, a.bufsize)) {
+      printf("buffer diferente com y=%u\n", y);
+      mismatches++;
+    }
+  }
+  printf("equivalencia com o desenho antigo: %s\n", mismatches ? "FALHOU" : "ok");
+
+  for (size_t s = 0; s < sizeof(strings) / sizeof(strings[0]); ++s) {
+    const char *str = strings[s];
+    ssd1306_text_t text;
+    ssd1306_text_render(&text, str, true);
+
+    for (uint8_t y = 0; y <= 5; y += 5) {
+      double legacy = time_string(legacy_draw_string, &a, str, y);
+      double fixed = time_string(ssd1306_draw_string, &b, str, y);
+      double prop = time_string(draw_prop, &b, str, y);
+      double start = wall_seconds();
+      for (int i = 0; i < REPEAT; ++i)
+        ssd1306_draw_text(&b, &text, 8, y);
+      double cached = (wall_seconds() - start) * 1e9 / REPEAT;
+
+      printf("\"%s\" y=%u: antigo %.1f ns, atlas %.1f ns (%.1fx), proporcional %.1f ns, pre-renderizado %.1f ns\n",
+             str, y, legacy, fixed, legacy / fixed, prop, cached);
+    }
+  }
+  ssd1306_deinit(&a);
+  ssd1306_deinit(&b);
+  return mismatches ? 1 : 0;
+}
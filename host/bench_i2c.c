@@ -0,0 +1,88 @@
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "host_hal.h"
+#include "libs/ssd1306/ssd1306.h"
+
+// Contagem de transações e bytes I2C da inicialização e de uma janela de
+// envio, comparando um comando por transação (como o driver fazia) com as
+// listas de comandos (Co = 0). Confere que o painel emulado termina no mesmo
+// estado nos dois casos.
+
+// Mesma sequência de ssd1306_config
+static const uint8_t init_sequence[] = {
+  SET_DISP | 0x00, SET_MEM_ADDR, 0x01, SET_DISP_START_LINE | 0x00, SET_SEG_REMAP | 0x01,
+  SET_MUX_RATIO, HEIGHT - 1, SET_COM_OUT_DIR | 0x08, SET_DISP_OFFSET, 0x00, SET_COM_PIN_CFG, 0x12,
+  SET_DISP_CLK_DIV, 0x80, SET_PRECHARGE, 0xF1, SET_VCOM_DESEL, 0x30, SET_CONTRAST, 0xFF,
+  SET_ENTIRE_ON, SET_NORM_INV, SET_CHARGE_PUMP, 0x14, SET_DISP | 0x01,
+};
+
+// Janela pequena, do tamanho da bola: 4 colunas em uma página
+static const uint8_t window[] = { SET_COL_ADDR, 60, 63, SET_PAGE_ADDR, 3, 3 };
+static const uint8_t window_data[] = { 0x40, 0x3C, 0x3C, 0x3C, 0x3C };
+
+static ssd1306_emu_t panel;
+static ssd1306_t disp;
+
+static void setup(void) {
+  hal_reset();
+  ssd1306_emu_reset(&panel);
+  i2c_init(i2c1, 400000);
+  hal_i2c_attach(i2c1, 0x3C, &panel);
+  ssd1306_init(&disp, WIDTH, HEIGHT, false, 0x3C, i2c1);
+}
+
+static hal_i2c_stats_t measure_init(bool list) {
+  hal_i2c_reset_stats(i2c1);
+  if (list) {
+    ssd1306_config(&disp);
+  } else {
+    for (size_t i = 0; i < sizeof(init_sequence); ++i)
+      ssd1306_command(&disp, init_sequence[i]);
+  }
+  return hal_i2c_stats(i2c1);
+}
+
+static hal_i2c_stats_t measure_window(bool list) {
+  hal_i2c_reset_stats(i2c1);
+  if (list) {
+    ssd1306_command_list(&disp, window, sizeof(window));
+  } else {
+    for (size_t i = 0; i < sizeof(window); ++i)
+      ssd1306_command(&disp, window[i]);
+  }
+  i2c_write_blocking(i2c1, 0x3C, window_data, sizeof(window_data), false);
+  return hal_i2c_stats(i2c1);
+}
+
+static void print_row(const char *name, hal_i2c_stats_t before, hal_i2c_stats_t after) {
+  printf("%-14s antes: %3u transações %4u bytes %7.1f us | depois: %3u transações %4u bytes %7.1f us\n",
+         name, before.transactions, before.bytes, before.busy_us, after.transactions, after.bytes, after.busy_us);
+}
+
+int main(void) {
+  ssd1306_emu_t reference;
+
+  setup();
+  hal_i2c_stats_t init_before = measure_init(false);
+  hal_i2c_stats_t window_before = measure_window(false);
+  reference = panel;
+  ssd1306_deinit(&disp);
+
+  setup();
+  hal_i2c_stats_t init_after = measure_init(true);
+  hal_i2c_stats_t window_after = measure_window(true);
+
+  ssd1306_deinit(&disp);
+
+  print_row("inicialização", init_before, init_after);
+  print_row("janela 4x1", window_before, window_after);
+
+  bool same = !memcmp(reference.gram, panel.gram, sizeof(panel.gram)) &&
+              reference.mem_mode == panel.mem_mode && reference.mux_ratio == panel.mux_ratio &&
+              reference.contrast == panel.contrast && reference.display_on == panel.display_on &&
+              reference.col_start == panel.col_start && reference.page_end == panel.page_end;
+  printf("estado do painel: %s\n", same ? "igual" : "DIFERENTE");
+  return same ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "libs/input/input_filter.h"
+
+// Filtro do joystick contra fluxos sintéticos de amostras: ruído em repouso
+// (a zona morta precisa segurar o centro), ruído fora do centro (desvio
+// padrão comparado a uma leitura única por quadro), resposta a degrau e
+// extremos da calibração. Sai com 1 se alguma verificação falhar.
+
+#define SAMPLES_PER_FRAME 133       // 8 kHz por eixo a 60 quadros/s
+
+static uint32_t rng_state = 1;
+
+static double gaussian(void) {
+  double u = 0, v = 0;
+  while (u == 0) {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    u = rng_state / 4294967296.0;
+  }
+  rng_state = rng_state * 1664525u + 1013904223u;
+  v = rng_state / 4294967296.0;
+  return sqrt(-2 * log(u)) * cos(2 * M_PI * v);
+}
+
+static uint16_t sample(double level, double noise) {
+  double raw = level + noise * gaussian();
+  return raw < 0 ? 0 : raw > 4095 ? 4095 : (uint16_t)raw;
+}
+
+static const input_filter_config_t config = {
+  .oversample_shift = 3, .smoothing_shift = 2, .deadzone = 64,
+  .cal_min = 0, .cal_center = 2048, .cal_max = 4095,
+};
+
+// Desvio padrão por quadro do valor filtrado e de uma leitura bruta única
+static void jitter(double level, double noise, double *filtered, double *single, double *mean) {
+  input_filter_t f;
+  double sum = 0, sum2 = 0, raw_sum = 0, raw_sum2 = 0;
+  const int frames = 2000;
+
+  input_filter_init(&f, &config);
+  for (int i = 0; i < 100 * SAMPLES_PER_FRAME; ++i)
+    input_filter_push(&f, sample(level, noise));
+  for (int frame = 0; frame < frames; ++frame) {
+    for (int i = 0; i < SAMPLES_PER_FRAME; ++i)
+      input_filter_push(&f, sample(level, noise));
+    double v = input_filter_value(&f);
+    double r = input_filter_calibrate(&config, sample(level, noise));
+    sum += v;
+    sum2 += v * v;
+    raw_sum += r;
+    raw_sum2 += r * r;
+  }
+  *mean = sum / frames;
+  *filtered = sqrt(sum2 / frames - *mean * *mean);
+  *single = sqrt(raw_sum2 / frames - (raw_sum / frames) * (raw_sum / frames));
+}
+
+int main(void) {
+  int failures = 0;
+  double filtered, single, mean;
+
+  jitter(2048, 20, &filtered, &single, &mean);
+  printf("repouso (ruído 20): filtrado %.2f, leitura única %.2f (desvio padrão), média %.1f\n", filtered, single, mean);
+  if (filtered != 0 || mean != INPUT_FILTER_CENTER) {
+    printf("ERRO: zona morta não segurou o centro\n");
+    failures++;
+  }
+
+  jitter(3000, 40, &filtered, &single, &mean);
+  printf("fora do centro (ruído 40): filtrado %.2f, leitura única %.2f (desvio padrão), média %.1f\n",
+         filtered, single, mean);
+  if (filtered * 4 > single) {
+    printf("ERRO: filtro reduziu o ruído menos de 4x\n");
+    failures++;
+  }
+
+  // Degrau de 1000 para 3500: amostras por eixo até 90% do novo valor
+  input_filter_t f;
+  input_filter_init(&f, &config);
+  for (int i = 0; i < 1000; ++i)
+    input_filter_push(&f, 1000);
+  uint16_t start = input_filter_value(&f);
+  uint16_t target = input_filter_calibrate(&config, 3500);
+  int steps = 0;
+  while (input_filter_value(&f) < start + (target - start) * 9 / 10 && steps < 100000) {
+    input_filter_push(&f, 3500);
+    steps++;
+  }
+  printf("degrau: 90%% em %d amostras por eixo (%.2f ms a 8 kHz)\n", steps, steps / 8.0);
+  if (steps > SAMPLES_PER_FRAME) {
+    printf("ERRO: resposta ao degrau mais lenta que um quadro\n");
+    failures++;
+  }
+
+  uint16_t low = input_filter_calibrate(&config, 0), high = input_filter_calibrate(&config, 4095);
+  printf("calibração: extremos %u e %u\n", low, high);
+  if (low != 0 || high != INPUT_FILTER_MAX) {
+    printf("ERRO: calibração não alcança os extremos\n");
+    failures++;
+  }
+
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,192 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "host_hal.h"
+#include "jogo.h"
+
+// Multibola: primeiro confere a física em lote (phys_balls_step) contra
+// phys_step bola a bola em estados sorteados, com as raquetes em qualquer
+// posição; depois mede ns por tick do jogo com 1 a 64 bolas (IA e física,
+// e o desenho à parte) e compara a física em lote com o laço por bola.
+
+#define TRIALS 20000
+#define TICKS 200000
+#define TOLERANCE 32                              // LSBs de Q16: phys_step arredonda o instante do choque com a parede
+
+static const phys_config_t cfg = {
+  .width = Q16_FROM_INT(LARGURA),
+  .height = Q16_FROM_INT(ALTURA),
+  .speed_base = Q16_FROM_INT(VELOCIDADE_BOLA),
+  .speed_step = ACRESCIMO_VELOCIDADE_BOLA,
+  .speed_max = Q16_FROM_INT(VELOCIDADE_MAXIMA_BOLA),
+  .max_slope = INCLINACAO_MAXIMA_BOLA,
+};
+
+static uint32_t rng_state = 1;
+
+static uint32_t rng(void) {
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 17;
+  rng_state ^= rng_state << 5;
+  return rng_state;
+}
+
+static q16_t rng_q16(q16_t lo, q16_t hi) {
+  return lo + (q16_t)(rng() % (uint32_t)(hi - lo + 1));
+}
+
+static double wall_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void random_paddles(phys_box_t pads[PHYS_PADDLE_COUNT]) {
+  q16_t travel = Q16_FROM_INT(ALTURA - ALTURA_RAQUETE);
+  pads[PHYS_PADDLE_LEFT] = (phys_box_t){ 0, rng_q16(0, travel), Q16_FROM_INT(LARGURA_RAQUETE), Q16_FROM_INT(ALTURA_RAQUETE) };
+  pads[PHYS_PADDLE_RIGHT] = (phys_box_t){ Q16_FROM_INT(LARGURA - LARGURA_RAQUETE), rng_q16(0, travel),
+                                          Q16_FROM_INT(LARGURA_RAQUETE), Q16_FROM_INT(ALTURA_RAQUETE) };
+}
+
+// Bolas em qualquer ponto do campo (inclusive atrás das raquetes), com
+// |vx| até a velocidade máxima e |vy| até a inclinação máxima
+static void random_balls(phys_balls_t *balls, unsigned n) {
+  balls->count = n;
+  balls->size = Q16_FROM_INT(TAMANHO_BOLA);
+  for (unsigned i = 0; i < n; ++i) {
+    q16_t speed = rng_q16(Q16_FRAC(1, 4), cfg.speed_max);
+    q16_t slope = rng_q16(-cfg.max_slope, cfg.max_slope);
+    balls->x[i] = rng_q16(-balls->size + 1, cfg.width - 1);
+    balls->y[i] = rng_q16(0, cfg.height - balls->size);
+    balls->vx[i] = rng() & 1 ? speed : -speed;
+    balls->vy[i] = q16_mul(speed, slope);
+    balls->rally[i] = rng() % 100;
+  }
+}
+
+static bool near_enough(q16_t a, q16_t b) {
+  return abs(a - b) <= TOLERANCE;
+}
+
+// Bola que termina o tick rente à parede: pelo arredondamento, phys_step
+// pode ter contado o choque e o lote não (ou o contrário); as duas valem
+static bool same_vy(const phys_ball_t *ref, q16_t y, q16_t vy) {
+  if (ref->vy == vy)
+    return true;
+  return ref->vy == -vy && (y <= TOLERANCE || y >= cfg.height - ref->size - TOLERANCE);
+}
+
+// Mesmo tick pelo lote e por phys_step em cada bola
+static unsigned differential(void) {
+  static phys_balls_t balls, before;
+  unsigned errors = 0, hits = 0, outs = 0;
+  for (unsigned trial = 0; trial < TRIALS; ++trial) {
+    phys_box_t pads[PHYS_PADDLE_COUNT];
+    phys_balls_result_t result;
+    random_paddles(pads);
+    random_balls(&balls, PHYS_BALLS_MAX);
+    before = balls;
+    phys_balls_step(&cfg, &balls, pads, &result);
+
+    unsigned events = 0;
+    for (unsigned i = 0; i < balls.count; ++i) {
+      phys_ball_t ball;
+      phys_balls_get(&before, i, &ball);
+      unsigned e = phys_step(&cfg, &ball, pads);
+      events |= e;
+      bool left = (result.out_left >> i) & 1, right = (result.out_right >> i) & 1;
+      if (!near_enough(ball.x, balls.x[i]) || !near_enough(ball.y, balls.y[i]) || ball.vx != balls.vx[i] ||
+          !same_vy(&ball, balls.y[i], balls.vy[i]) || ball.rally != balls.rally[i] || left != !!(e & PHYS_EVENT_OUT_LEFT) ||
+          right != !!(e & PHYS_EVENT_OUT_RIGHT)) {
+        if (errors++ < 5)
+          printf("divergência na tentativa %u, bola %u: lote (%d, %d, %d, %d) contra (%d, %d, %d, %d)\n", trial, i,
+                 balls.x[i], balls.y[i], balls.vx[i], balls.vy[i], ball.x, ball.y, ball.vx, ball.vy);
+      }
+    }
+    if ((events & ~(unsigned)PHYS_EVENT_WALL) != (result.events & ~(unsigned)PHYS_EVENT_WALL))
+      errors++;
+    hits += !!(events & (PHYS_EVENT_HIT_LEFT | PHYS_EVENT_HIT_RIGHT));
+    outs += !!(events & (PHYS_EVENT_OUT_LEFT | PHYS_EVENT_OUT_RIGHT));
+  }
+  printf("lote contra phys_step: %u tentativas de %u bolas, %u com rebatidas, %u com saídas, %u divergências\n",
+         TRIALS, PHYS_BALLS_MAX, hits, outs, errors);
+  return errors;
+}
+
+// Raquete do jogador num vaivém, para as bolas baterem e passarem
+static uint16_t sweep_joystick(unsigned tick) {
+  unsigned phase = tick % 256;
+  return (phase < 128 ? phase : 255 - phase) * 32;
+}
+
+int main(void) {
+  static ssd1306_emu_t emu;
+  static ssd1306_t disp;
+  static struct EstadoJogo estado;
+
+  if (differential())
+    return 1;
+
+  hal_reset();
+  ssd1306_emu_reset(&emu);
+  i2c_init(i2c1, 400000);
+  hal_i2c_attach(i2c1, 0x3C, &emu);
+  ssd1306_init(&disp, LARGURA, ALTURA, false, 0x3C, i2c1);
+
+  printf("%6s %12s %10s %14s %14s %12s %13s\n", "bolas", "ns/tick", "ns/bola", "física lote", "por bola",
+         "candidatas", "desenho (ns)");
+  for (unsigned n = 1; n <= PHYS_BALLS_MAX; n *= 2) {
+    inicializar_multibola(&estado, n);
+
+    double start = wall_seconds();
+    for (unsigned tick = 0; tick < TICKS; ++tick) {
+      aplicar_joystick(&estado, sweep_joystick(tick));
+      atualizar_ia(&estado);
+      atualizar_bola(&estado);
+    }
+    double tick_ns = (wall_seconds() - start) * 1e9 / TICKS;
+
+    // Só a física, a partir do mesmo estado: lote contra o laço por bola
+    phys_box_t pads[PHYS_PADDLE_COUNT] = {
+      { 0, Q16_FROM_INT(estado.jogador_y), Q16_FROM_INT(LARGURA_RAQUETE), Q16_FROM_INT(ALTURA_RAQUETE) },
+      { Q16_FROM_INT(LARGURA - LARGURA_RAQUETE), Q16_FROM_INT(estado.ia_y), Q16_FROM_INT(LARGURA_RAQUETE),
+        Q16_FROM_INT(ALTURA_RAQUETE) },
+    };
+    phys_balls_t balls = estado.bolas;
+    phys_balls_result_t result;
+    uint64_t candidates = 0;
+    start = wall_seconds();
+    for (unsigned tick = 0; tick < TICKS; ++tick) {
+      phys_balls_step(&cfg, &balls, pads, &result);
+      candidates += result.candidates;
+      for (uint64_t out = result.out_left | result.out_right; out; out &= out - 1)
+        phys_balls_serve(&cfg, &balls, __builtin_ctzll(out), 1, 1);
+    }
+    double batch_ns = (wall_seconds() - start) * 1e9 / TICKS;
+
+    phys_ball_t each[PHYS_BALLS_MAX];
+    for (unsigned i = 0; i < n; ++i)
+      phys_balls_get(&estado.bolas, i, &each[i]);
+    start = wall_seconds();
+    for (unsigned tick = 0; tick < TICKS; ++tick) {
+      for (unsigned i = 0; i < n; ++i)
+        if (phys_step(&cfg, &each[i], pads) & (PHYS_EVENT_OUT_LEFT | PHYS_EVENT_OUT_RIGHT))
+          phys_serve(&cfg, &each[i], 1, 1);
+    }
+    double scalar_ns = (wall_seconds() - start) * 1e9 / TICKS;
+
+    start = wall_seconds();
+    for (unsigned frame = 0; frame < TICKS / 100; ++frame)
+      desenhar_jogo(&disp, &estado);
+    double draw_ns = (wall_seconds() - start) * 1e9 / (TICKS / 100);
+
+    printf("%6u %12.1f %10.1f %14.1f %14.1f %12.2f %13.0f\n", n, tick_ns, tick_ns / n, batch_ns, scalar_ns,
+           (double)candidates / TICKS, draw_ns);
+  }
+  printf("placar com %u bolas: %d - %d\n", PHYS_BALLS_MAX, estado.pontuacao_jogador, estado.pontuacao_ia);
+  ssd1306_deinit(&disp);
+  return 0;
+}
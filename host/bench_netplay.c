@@ -0,0 +1,336 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <pty.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "jogo.h"
+#include "libs/netplay/netplay.h"
+
+// Dois processos jogam uma partida pelo protocolo de libs/netplay, ligados
+// por um socketpair (ou um pty em modo raw, como a UART), cada um com o seu
+// jogador roteirizado seguindo a bola no estado que ele mesmo simula. Os
+// pacotes de saída ficam retidos alguns quadros (latência do enlace) e
+// bytes podem ser corrompidos. No fim, os dois precisam chegar ao mesmo
+// hash do estado no último tick e sem divergências nas verificações
+// periódicas. Mede banda por tick, rollbacks, ticks refeitos e o custo de
+// cada ressincronização.
+
+#define QUEUE_PACKETS 256
+#define LINGER_FRAMES 200                   // Quadros servindo o outro lado depois de terminar
+
+typedef struct {
+  unsigned long ticks;
+  unsigned latency;                         // Quadros de atraso em cada sentido
+  unsigned long corrupt_ppm;                // Bytes corrompidos por milhão
+  unsigned period_us;                       // Duração de um quadro
+  bool pty;
+} bench_opts_t;
+
+typedef struct {
+  uint64_t release;                         // Quadro em que o pacote entra no enlace
+  size_t len, sent;
+  uint8_t data[NETPLAY_PACKET_MAX];
+} queued_packet_t;
+
+// Ponta do enlace de um processo
+typedef struct {
+  int fd;
+  uint64_t frame;
+  unsigned latency;
+  unsigned long corrupt_ppm;
+  uint32_t rng;
+  queued_packet_t queue[QUEUE_PACKETS];
+  unsigned head, tail;
+  uint32_t dropped;                         // Fila cheia
+  uint32_t corrupted;
+} link_t;
+
+typedef struct {
+  bool ok;
+  uint8_t local;
+  uint32_t tick;
+  uint32_t hash;
+  uint32_t dropped, corrupted;
+  uint32_t play_bytes;                      // Enviados até o último tick, sem os acks finais
+  double rollback_us;                       // Tempo de parede das chamadas em que houve rollback
+  double seconds;
+  netplay_stats_t stats;
+} result_t;
+
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "uso: %s [-n ticks] [-l quadros] [-e ppm] [-p us] [-t]\n"
+          "  -n  ticks da partida (padrão 3000)\n"
+          "  -l  latência do enlace em quadros, em cada sentido (padrão 3)\n"
+          "  -e  bytes corrompidos por milhão (padrão 0)\n"
+          "  -p  duração de um quadro em microssegundos (padrão 1000)\n"
+          "  -t  liga os processos por um pty em modo raw em vez de um socketpair\n",
+          prog);
+}
+
+static bool parse_args(int argc, char **argv, bench_opts_t *o) {
+  o->ticks = 3000;
+  o->latency = 3;
+  o->corrupt_ppm = 0;
+  o->period_us = 1000;
+  o->pty = false;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "-n") && i + 1 < argc)
+      o->ticks = strtoul(argv[++i], NULL, 0);
+    else if (!strcmp(argv[i], "-l") && i + 1 < argc)
+      o->latency = strtoul(argv[++i], NULL, 0);
+    else if (!strcmp(argv[i], "-e") && i + 1 < argc)
+      o->corrupt_ppm = strtoul(argv[++i], NULL, 0);
+    else if (!strcmp(argv[i], "-p") && i + 1 < argc)
+      o->period_us = strtoul(argv[++i], NULL, 0);
+    else if (!strcmp(argv[i], "-t"))
+      o->pty = true;
+    else
+      return false;
+  }
+  return o->ticks > 0 && o->ticks < UINT32_MAX / 2;
+}
+
+static double wall_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint32_t lcg(uint32_t *state) {
+  *state = *state * 1664525u + 1013904223u;
+  return *state >> 16;
+}
+
+// Jogador roteirizado do bench_pingpong, para a raquete de qualquer lado
+static uint16_t script_joystick(const struct EstadoJogo *estado, uint8_t local, uint32_t *rng) {
+  int curso = ALTURA - ALTURA_RAQUETE;
+  int raquete = local ? estado->ia_y : estado->jogador_y;
+  int alvo = estado->bola_y - ALTURA_RAQUETE / 2 + (int)(lcg(rng) % 13) - 6;
+  if (lcg(rng) % 4 == 0)
+    alvo = raquete;                         // Reage com atraso de vez em quando
+  if (alvo < 0) alvo = 0;
+  if (alvo > curso) alvo = curso;
+  int adc = (curso - alvo) * 4096 / curso;
+  return adc > 4095 ? 4095 : adc;
+}
+
+static size_t link_read(void *io, uint8_t *data, size_t len) {
+  link_t *link = io;
+  ssize_t n = read(link->fd, data, len);
+  return n > 0 ? (size_t)n : 0;             // EAGAIN, ou o outro lado já fechou
+}
+
+static void link_write(void *io, const uint8_t *data, size_t len) {
+  link_t *link = io;
+  if (link->tail - link->head == QUEUE_PACKETS) {
+    link->dropped++;
+    return;
+  }
+  queued_packet_t *p = &link->queue[link->tail++ % QUEUE_PACKETS];
+  p->release = link->frame + link->latency;
+  p->len = len;
+  p->sent = 0;
+  memcpy(p->data, data, len);
+  for (size_t i = 0; i < len && link->corrupt_ppm; ++i) {
+    if ((lcg(&link->rng) << 16 | lcg(&link->rng)) % 1000000 < link->corrupt_ppm) {
+      p->data[i] ^= 1 << (lcg(&link->rng) & 7);
+      link->corrupted++;
+    }
+  }
+}
+
+// Entrega ao enlace os pacotes cuja latência já passou
+static void link_flush(link_t *link) {
+  while (link->head != link->tail) {
+    queued_packet_t *p = &link->queue[link->head % QUEUE_PACKETS];
+    if (p->release > link->frame)
+      return;
+    ssize_t n = write(link->fd, p->data + p->sent, p->len - p->sent);
+    if (n < 0)
+      return;                               // Buffer do enlace cheio: tenta no próximo quadro
+    p->sent += n;
+    if (p->sent < p->len)
+      return;
+    link->head++;
+  }
+}
+
+static void sleep_until_s(double deadline) {
+  double now = wall_seconds();
+  if (deadline > now) {
+    struct timespec ts = { (time_t)(deadline - now), (long)((deadline - now - (time_t)(deadline - now)) * 1e9) };
+    nanosleep(&ts, NULL);
+  }
+}
+
+static result_t play(int fd, const bench_opts_t *o, uint32_t nonce) {
+  static struct EstadoJogo estado;
+  static uint8_t snapshots[NETPLAY_SNAPSHOTS][sizeof(struct EstadoJogo)];
+  static link_t link;
+  static netplay_t np;
+  result_t r = { 0 };
+  uint32_t rng = nonce;
+  uint64_t max_frames = o->ticks * 4 + 10000;
+  unsigned linger = 0;
+
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+  link.fd = fd;
+  link.latency = o->latency;
+  link.corrupt_ppm = o->corrupt_ppm;
+  link.rng = nonce ^ 0x9E3779B9u;
+
+  inicializar_jogo(&estado);
+  netplay_init(&np, &estado, sizeof(estado), &snapshots[0][0], passo_em_rede, hash_estado, link_read, link_write,
+               &link, nonce);
+
+  double start = wall_seconds();
+  for (; link.frame < max_frames; ++link.frame) {
+    uint32_t rollbacks = np.stats.rollbacks;
+    double call = wall_seconds();
+    if (np.tick < o->ticks)
+      netplay_tick(&np, np.connected ? script_joystick(&estado, np.local, &rng) : 2048);
+    else
+      netplay_poll(&np);
+    if (np.stats.rollbacks != rollbacks)
+      r.rollback_us += (wall_seconds() - call) * 1e6;
+    link_flush(&link);
+
+    if (np.tick >= o->ticks && !r.play_bytes)
+      r.play_bytes = np.stats.bytes_sent;
+    bool done = np.tick >= o->ticks && netplay_confirmed(&np) >= o->ticks && np.peer_ack >= o->ticks;
+    if (done && ++linger >= LINGER_FRAMES) {
+      r.ok = true;
+      break;
+    }
+    sleep_until_s(start + (link.frame + 1) * o->period_us * 1e-6);
+  }
+  r.seconds = wall_seconds() - start;
+  r.local = np.local;
+  r.tick = np.tick;
+  r.hash = hash_estado(&estado);
+  r.dropped = link.dropped;
+  r.corrupted = link.corrupted;
+  r.stats = np.stats;
+  return r;
+}
+
+static bool open_link(bool pty, int fds[2]) {
+  if (!pty)
+    return socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0;
+
+  struct termios raw;
+  if (openpty(&fds[0], &fds[1], NULL, NULL, NULL) != 0)
+    return false;
+  for (int i = 0; i < 2; ++i) {
+    tcgetattr(fds[i], &raw);
+    cfmakeraw(&raw);
+    tcsetattr(fds[i], TCSANOW, &raw);
+  }
+  return true;
+}
+
+static pid_t spawn(int fd, int other, const bench_opts_t *o, uint32_t nonce, int *result_fd) {
+  int pipe_fds[2];
+  if (pipe(pipe_fds) != 0)
+    return -1;
+  pid_t pid = fork();
+  if (pid == 0) {
+    close(other);
+    close(pipe_fds[0]);
+    result_t r = play(fd, o, nonce);
+    ssize_t written = write(pipe_fds[1], &r, sizeof(r));
+    _exit(written == sizeof(r) ? 0 : 1);
+  }
+  close(pipe_fds[1]);
+  *result_fd = pipe_fds[0];
+  return pid;
+}
+
+static bool collect(pid_t pid, int fd, result_t *r) {
+  int status;
+  bool ok = read(fd, r, sizeof(*r)) == sizeof(*r);
+  close(fd);
+  waitpid(pid, &status, 0);
+  return ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+static void print_result(const result_t *r, unsigned long ticks) {
+  const netplay_stats_t *s = &r->stats;
+  printf("jogador %u: tick %lu, hash %08x, %.2f s\n", r->local, (unsigned long)r->tick, r->hash, r->seconds);
+  printf("  enviados %lu pacotes, %lu bytes (%.2f bytes/tick na partida); recebidos %lu pacotes, %lu ruins\n",
+         (unsigned long)s->packets_sent, (unsigned long)s->bytes_sent, (double)r->play_bytes / ticks,
+         (unsigned long)s->packets_received, (unsigned long)s->bad_packets);
+  printf("  %lu rollbacks, %.2f ticks refeitos em média (máx %lu), %.1f us por rollback; %lu paradas\n",
+         (unsigned long)s->rollbacks, s->rollbacks ? (double)s->resimulated / s->rollbacks : 0.0,
+         (unsigned long)s->max_resimulated, s->rollbacks ? r->rollback_us / s->rollbacks : 0.0,
+         (unsigned long)s->stalls);
+  printf("  %lu verificações de hash, %lu divergências; %lu bytes corrompidos, %lu pacotes perdidos na fila\n",
+         (unsigned long)s->hash_checks, (unsigned long)s->desyncs, (unsigned long)r->corrupted,
+         (unsigned long)r->dropped);
+}
+
+int main(int argc, char **argv) {
+  bench_opts_t opts;
+  int link_fds[2], result_fds[2];
+  result_t results[2];
+
+  if (!parse_args(argc, argv, &opts)) {
+    usage(argv[0]);
+    return 2;
+  }
+  if (!open_link(opts.pty, link_fds)) {
+    perror("enlace");
+    return 1;
+  }
+  signal(SIGPIPE, SIG_IGN);
+
+  pid_t pids[2];
+  pids[0] = spawn(link_fds[0], link_fds[1], &opts, 0x1234567u, &result_fds[0]);
+  pids[1] = spawn(link_fds[1], link_fds[0], &opts, 0x89ABCDEu, &result_fds[1]);
+  close(link_fds[0]);
+  close(link_fds[1]);
+
+  bool ok = pids[0] > 0 && pids[1] > 0;
+  for (int i = 0; i < 2 && ok; ++i)
+    ok = collect(pids[i], result_fds[i], &results[i]);
+  if (!ok) {
+    printf("ERRO: processo do jogador falhou\n");
+    return 1;
+  }
+
+  printf("enlace %s, %lu ticks, latência %u quadros de %u us, %lu ppm corrompidos\n",
+         opts.pty ? "pty" : "socketpair", opts.ticks, opts.latency, opts.period_us, opts.corrupt_ppm);
+  for (int i = 0; i < 2; ++i)
+    print_result(&results[i], opts.ticks);
+
+  for (int i = 0; i < 2; ++i) {
+    if (!results[i].ok) {
+      printf("ERRO: o processo %d não terminou a partida (tick %lu)\n", i, (unsigned long)results[i].tick);
+      ok = false;
+    }
+    if (results[i].stats.desyncs || !results[i].stats.hash_checks) {
+      printf("ERRO: processo %d com %lu divergências em %lu verificações\n", i,
+             (unsigned long)results[i].stats.desyncs, (unsigned long)results[i].stats.hash_checks);
+      ok = false;
+    }
+  }
+  if (results[0].local == results[1].local) {
+    printf("ERRO: os dois processos ficaram com o jogador %u\n", results[0].local);
+    ok = false;
+  }
+  if (results[0].hash != results[1].hash) {
+    printf("ERRO: estados finais diferentes (%08x e %08x)\n", results[0].hash, results[1].hash);
+    ok = false;
+  }
+  if (ok)
+    printf("estados finais iguais\n");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,135 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "host_hal.h"
+#include "jogo.h"
+
+// Dois painéis emulados, um em cada controlador I2C: roda o jogo com a cena
+// espelhada e dividida (dois 128x32), confere a GRAM de cada painel contra a
+// parte da cena que ele deveria mostrar e mede o tempo virtual por quadro
+// com um painel, com dois enviados por DMA em paralelo e com dois enviados
+// um depois do outro (bloqueante). Na cena dividida a bola fica quase
+// sempre em uma metade só, então a carga dos dois barramentos raramente
+// coincide e a sobreposição medida é pequena mesmo com o envio em paralelo.
+
+#define FRAMES 20000
+
+typedef enum { MODE_SINGLE, MODE_MIRROR, MODE_SPLIT } panel_mode_t;
+
+static ssd1306_emu_t emus[2];
+static ssd1306_t panels[2];
+static ssd1306_t scene;
+
+static uint32_t lcg(uint32_t *state) {
+  *state = *state * 1664525u + 1013904223u;
+  return *state >> 16;
+}
+
+static uint16_t script_joystick(const struct EstadoJogo *estado, uint32_t *rng) {
+  int curso = ALTURA - ALTURA_RAQUETE;
+  int alvo = estado->bola_y - ALTURA_RAQUETE / 2 + (int)(lcg(rng) % 13) - 6;
+  if (alvo < 0) alvo = 0;
+  if (alvo > curso) alvo = curso;
+  int adc = (curso - alvo) * 4096 / curso;
+  return adc > 4095 ? 4095 : adc;
+}
+
+// GRAM do painel contra a cena a partir da página first_page
+static bool gram_matches_scene(const ssd1306_emu_t *emu, const ssd1306_t *panel, uint8_t first_page) {
+  for (uint8_t x = 0; x < panel->width; ++x)
+    for (uint8_t page = 0; page < panel->pages; ++page)
+      if (ssd1306_emu_column_byte(emu, x, page) != scene.ram_buffer[1 + x * scene.pages + first_page + page])
+        return false;
+  return true;
+}
+
+typedef struct {
+  double frame_us;
+  double busy_us[2];
+  bool gram_ok;
+} run_t;
+
+static run_t run(panel_mode_t mode, bool async) {
+  unsigned count = mode == MODE_SINGLE ? 1 : 2;
+  uint8_t height = mode == MODE_SPLIT ? 32 : 64;
+  i2c_inst_t *buses[2] = { i2c1, i2c0 };
+  struct EstadoJogo estado;
+  uint32_t rng = 1;
+  run_t r = { 0 };
+
+  hal_reset();
+  input_init(&configuracao_joystick);
+  ssd1306_init(&scene, LARGURA, ALTURA, false, 0x3C, NULL);
+  for (unsigned i = 0; i < count; ++i) {
+    ssd1306_emu_reset(&emus[i]);
+    i2c_init(buses[i], 400000);
+    hal_i2c_attach(buses[i], 0x3C, &emus[i]);
+    ssd1306_init(&panels[i], LARGURA, height, false, 0x3C, buses[i]);
+    ssd1306_config(&panels[i]);
+    hal_i2c_reset_stats(buses[i]);
+  }
+
+  inicializar_jogo(&estado);
+  uint64_t start = time_us_64();
+  r.gram_ok = true;
+  for (unsigned frame = 0; frame < FRAMES; ++frame) {
+    hal_adc_set(1, script_joystick(&estado, &rng));
+    ler_joystick(&estado);
+    atualizar_ia(&estado);
+    atualizar_bola(&estado);
+    desenhar_jogo(&scene, &estado);
+    for (unsigned i = 0; i < count; ++i)
+      ssd1306_copy_view(&panels[i], &scene, 0, mode == MODE_SPLIT ? i * 4 : 0, false);
+    for (unsigned i = 0; i < count; ++i) {
+      if (async)
+        ssd1306_send_data_async(&panels[i]);
+      else
+        ssd1306_send_data(&panels[i]);
+    }
+    for (unsigned i = 0; i < count; ++i)
+      ssd1306_wait(&panels[i]);
+    for (unsigned i = 0; i < count && frame % 97 == 0; ++i)
+      r.gram_ok &= gram_matches_scene(&emus[i], &panels[i], mode == MODE_SPLIT ? i * 4 : 0);
+  }
+  for (unsigned i = 0; i < count; ++i) {
+    r.gram_ok &= gram_matches_scene(&emus[i], &panels[i], mode == MODE_SPLIT ? i * 4 : 0);
+    r.gram_ok &= emus[i].mux_ratio == height - 1 && emus[i].com_pins == (height == 64 ? 0x12 : 0x02);
+    r.busy_us[i] = hal_i2c_stats(buses[i]).busy_us / FRAMES;
+  }
+  r.frame_us = (double)(time_us_64() - start) / FRAMES;
+  for (unsigned i = 0; i < count; ++i)
+    ssd1306_deinit(&panels[i]);
+  ssd1306_deinit(&scene);
+  return r;
+}
+
+static void print_run(const char *name, run_t r) {
+  printf("%-28s %7.1f us/quadro  barramento i2c1 %7.1f us  i2c0 %7.1f us", name, r.frame_us, r.busy_us[0], r.busy_us[1]);
+  if (r.busy_us[1] > 0) {
+    double overlap = (r.busy_us[0] + r.busy_us[1] - r.frame_us) / (r.busy_us[0] < r.busy_us[1] ? r.busy_us[0] : r.busy_us[1]);
+    printf("  sobreposição %3.0f%%", overlap < 0 ? 0 : 100 * overlap);
+  }
+  printf("  GRAM %s\n", r.gram_ok ? "ok" : "DIFERENTE");
+}
+
+int main(void) {
+  run_t single = run(MODE_SINGLE, true);
+  run_t mirror = run(MODE_MIRROR, true);
+  run_t mirror_blocking = run(MODE_MIRROR, false);
+  run_t split = run(MODE_SPLIT, true);
+
+  print_run("um painel (DMA)", single);
+  print_run("espelho em dois (DMA)", mirror);
+  print_run("espelho em dois (bloqueante)", mirror_blocking);
+  print_run("dividido em 2x 128x32 (DMA)", split);
+
+  bool ok = single.gram_ok && mirror.gram_ok && mirror_blocking.gram_ok && split.gram_ok;
+  // Com os dois barramentos em paralelo o quadro não pode custar bem mais que o de um painel
+  if (mirror.frame_us > single.frame_us * 1.2) {
+    printf("ERRO: dois painéis por DMA custam %.2fx o tempo de um\n", mirror.frame_us / single.frame_us);
+    ok = false;
+  }
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "libs/physics/physics.h"
+
+// Fuzz da física: sorteia bolas em qualquer velocidade e confere contra um
+// oráculo em ponto flutuante que a bola nunca atravessa a face de uma
+// raquete nem sai do campo pelas paredes. Depois mede ns por tick.
+
+#define FIELD_W 128
+#define FIELD_H 64
+#define PADDLE_W 4
+#define PADDLE_H 16
+#define BALL 4
+
+static uint32_t rng_state = 1;
+
+static uint32_t rng(void) {
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 17;
+  rng_state ^= rng_state << 5;
+  return rng_state;
+}
+
+static double rng_range(double lo, double hi) {
+  return lo + (hi - lo) * (rng() / 4294967296.0);
+}
+
+static double wall_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static double q(q16_t v) {
+  return v / 65536.0;
+}
+
+static void random_setup(phys_config_t *cfg, phys_ball_t *ball, phys_box_t pads[2], double max_speed) {
+  cfg->width = Q16_FROM_INT(FIELD_W);
+  cfg->height = Q16_FROM_INT(FIELD_H);
+  cfg->speed_base = Q16_FROM_INT(2);
+  cfg->speed_step = Q16_FRAC(1, 8);
+  cfg->speed_max = (q16_t)(max_speed * 65536);
+  cfg->max_slope = Q16_ONE;
+
+  pads[0].x = 0;
+  pads[0].y = (q16_t)(rng_range(0, FIELD_H - PADDLE_H) * 65536);
+  pads[1].x = Q16_FROM_INT(FIELD_W - PADDLE_W);
+  pads[1].y = (q16_t)(rng_range(0, FIELD_H - PADDLE_H) * 65536);
+  pads[0].w = pads[1].w = Q16_FROM_INT(PADDLE_W);
+  pads[0].h = pads[1].h = Q16_FROM_INT(PADDLE_H);
+
+  ball->size = Q16_FROM_INT(BALL);
+  ball->x = (q16_t)(rng_range(PADDLE_W, FIELD_W - PADDLE_W - BALL) * 65536);
+  ball->y = (q16_t)(rng_range(0, FIELD_H - BALL) * 65536);
+  ball->vx = (q16_t)(rng_range(-max_speed, max_speed) * 65536);
+  ball->vy = (q16_t)(rng_range(-max_speed, max_speed) * 65536);
+  ball->rally = rng() % 64;
+}
+
+// Oráculo: se, antes de qualquer parede, a trajetória reta cruza a face de
+// uma raquete sobrepondo-a verticalmente, o passo precisa reportar o
+// impacto. Casos rentes (margem < 0.01 px) são ignorados. Retorna -1 se o
+// caso não se aplica, 0 se passou e 1 se a bola atravessou.
+static int check_paddle(const phys_ball_t *b, const phys_box_t pads[2], unsigned events) {
+  double x = q(b->x), y = q(b->y), vx = q(b->vx), vy = q(b->vy), s = BALL;
+  double t_face, t_wall = INFINITY;
+  int side;
+
+  if (vx < 0) {
+    t_face = (PADDLE_W - x) / vx;
+    side = 0;
+  } else if (vx > 0) {
+    t_face = (FIELD_W - PADDLE_W - (x + s)) / vx;
+    side = 1;
+  } else {
+    return -1;
+  }
+  if (t_face < 0 || t_face > 1)
+    return -1;
+  if (vy < 0)
+    t_wall = -y / vy;
+  else if (vy > 0)
+    t_wall = (FIELD_H - (y + s)) / vy;
+  if (t_wall <= t_face + 1e-6)
+    return -1;
+
+  double yc = y + vy * t_face;
+  double top = q(pads[side].y), bottom = top + PADDLE_H;
+  double margin = fmin(fabs(yc + s - top), fabs(yc - bottom));
+  if (margin < 0.01)
+    return -1;
+  bool overlap = yc + s > top && yc < bottom;
+  if (!overlap)
+    return -1;
+  return (events & (side ? PHYS_EVENT_HIT_RIGHT : PHYS_EVENT_HIT_LEFT)) ? 0 : 1;
+}
+
+int main(int argc, char **argv) {
+  unsigned long cases = argc > 1 ? strtoul(argv[1], NULL, 0) : 2000000;
+  unsigned long checked = 0, tunnels = 0, escapes = 0;
+
+  for (unsigned long i = 0; i < cases; ++i) {
+    phys_config_t cfg;
+    phys_ball_t ball, before;
+    phys_box_t pads[2];
+    double max_speed = (i & 1) ? rng_range(0.5, 8) : rng_range(8, 120);
+    random_setup(&cfg, &ball, pads, max_speed);
+    before = ball;
+
+    unsigned events = phys_step(&cfg, &ball, pads);
+
+    int r = check_paddle(&before, pads, events);
+    if (r >= 0)
+      checked++;
+    if (r == 1 && tunnels++ < 5)
+      printf("atravessou: x=%.3f y=%.3f vx=%.3f vy=%.3f\n", q(before.x), q(before.y), q(before.vx), q(before.vy));
+    if (ball.y < 0 || ball.y + ball.size > cfg.height) {
+      if (escapes++ < 5)
+        printf("saiu pela parede: y=%.3f vy=%.3f -> y=%.3f\n", q(before.y), q(before.vy), q(ball.y));
+    }
+  }
+  printf("fuzz: %lu casos, %lu com cruzamento de raquete, %lu travessias, %lu fugas pela parede\n",
+         cases, checked, tunnels, escapes);
+
+  // Desempenho: rali contínuo com as raquetes seguindo a bola
+  phys_config_t cfg;
+  phys_ball_t ball;
+  phys_box_t pads[2];
+  random_setup(&cfg, &ball, pads, 12);
+  phys_serve(&cfg, &ball, 1, 1);
+  unsigned long ticks = 10000000;
+  volatile unsigned sink = 0;
+  double start = wall_seconds();
+  for (unsigned long i = 0; i < ticks; ++i) {
+    q16_t center = ball.y + ball.size / 2 - pads[0].h / 2;
+    pads[0].y = pads[1].y = center;
+    sink += phys_step(&cfg, &ball, pads);
+    if (ball.x + ball.size <= 0 || ball.x >= cfg.width)
+      phys_serve(&cfg, &ball, 1, 1);
+  }
+  double elapsed = wall_seconds() - start;
+  printf("desempenho: %.1f ns/tick (%lu ticks)\n", elapsed * 1e9 / ticks, ticks);
+
+  return tunnels || escapes ? 1 : 0;
+}
@@ -0,0 +1,219 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "host_hal.h"
+#include "jogo.h"
+
+// Grava uma sessão com o joystick roteirizado (ou carrega uma gravada na
+// placa com o comando 'd') e a reproduz duas vezes, desenhando e enviando
+// cada tick ao painel emulado: com janelas sujas e com o quadro inteiro a
+// cada envio. As duas reproduções precisam terminar com o mesmo hash da
+// sessão (a mesma partida) antes de comparar quadros/s e o tráfego no
+// barramento simulado.
+
+#define MAX_WORDS (1u << 20)
+#define MAX_CHECKPOINTS (MAX_WORDS * REPLAY_RUN_MAX / REPLAY_CHECKPOINT_TICKS)
+
+typedef struct {
+  unsigned long frames;
+  unsigned seed;
+  const char *input;
+  bool async;
+} bench_opts_t;
+
+typedef struct {
+  replay_result_t replay;
+  hal_i2c_stats_t bus;
+  double elapsed;
+  uint64_t virtual_us;
+  bool gram_ok;
+  int score[2];
+} run_t;
+
+static struct EstadoJogo snapshot, work;
+static uint16_t words[MAX_WORDS];
+static replay_checkpoint_t checkpoints[MAX_CHECKPOINTS];
+static ssd1306_emu_t panel;
+static ssd1306_t disp;
+static bool send_async, send_full;
+
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "uso: %s [-n quadros] [-s semente] [-i arquivo] [-a]\n"
+          "  -n  quadros gravados com o joystick roteirizado (padrão 1000000)\n"
+          "  -s  semente do roteiro do joystick (padrão 1)\n"
+          "  -i  reproduz uma gravação da placa (saída do comando 'd')\n"
+          "  -a  envia por DMA (ssd1306_send_data_async)\n",
+          prog);
+}
+
+static bool parse_args(int argc, char **argv, bench_opts_t *o) {
+  o->frames = 1000000;
+  o->seed = 1;
+  o->input = NULL;
+  o->async = false;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "-n") && i + 1 < argc)
+      o->frames = strtoul(argv[++i], NULL, 0);
+    else if (!strcmp(argv[i], "-s") && i + 1 < argc)
+      o->seed = strtoul(argv[++i], NULL, 0);
+    else if (!strcmp(argv[i], "-i") && i + 1 < argc)
+      o->input = argv[++i];
+    else if (!strcmp(argv[i], "-a"))
+      o->async = true;
+    else
+      return false;
+  }
+  return true;
+}
+
+static double wall_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint32_t lcg(uint32_t *state) {
+  *state = *state * 1664525u + 1013904223u;
+  return *state >> 16;
+}
+
+// Jogador roteirizado: persegue a bola com um erro pseudoaleatório e
+// converte a posição desejada no valor de ADC que ler_joystick espera
+static uint16_t script_joystick(const struct EstadoJogo *estado, uint32_t *rng) {
+  int curso = ALTURA - ALTURA_RAQUETE;
+  int alvo = estado->bola_y - ALTURA_RAQUETE / 2 + (int)(lcg(rng) % 13) - 6;
+  if (alvo < 0) alvo = 0;
+  if (alvo > curso) alvo = curso;
+  int adc = (curso - alvo) * 4096 / curso;
+  return adc > 4095 ? 4095 : adc;
+}
+
+static bool gram_matches(const ssd1306_t *ssd, const ssd1306_emu_t *emu) {
+  for (uint8_t x = 0; x < ssd->width; ++x)
+    for (uint8_t page = 0; page < ssd->pages; ++page)
+      if (ssd->ram_buffer[1 + x * ssd->pages + page] != ssd1306_emu_column_byte(emu, x, page))
+        return false;
+  return true;
+}
+
+// Mesma gravação do bench_replay
+static void record(replay_t *r, const bench_opts_t *o) {
+  struct EstadoJogo estado;
+  uint32_t rng = o->seed;
+
+  hal_reset();
+  input_init(&configuracao_joystick);
+  inicializar_jogo(&estado);
+  replay_start(r, &estado);
+  for (unsigned long t = 0; t < o->frames; ++t) {
+    hal_adc_set(1, script_joystick(&estado, &rng));
+    uint16_t entrada = ler_joystick(&estado);
+    atualizar_ia(&estado);
+    atualizar_bola(&estado);
+    if (!replay_record(r, entrada, hash_estado(&estado)))
+      break;
+  }
+  replay_stop(r);
+}
+
+static bool load(replay_t *r, const char *path) {
+  static uint8_t packed[TAMANHO_ESTADO_SERIALIZADO];
+  size_t len;
+  FILE *f = fopen(path, "r");
+  if (!f)
+    return false;
+  bool ok = replay_load(r, f, packed, sizeof(packed), &len) && desserializar_estado(&snapshot, packed, len);
+  fclose(f);
+  return ok;
+}
+
+// Passo da reprodução que também desenha e envia o quadro
+static void step_send(void *estado, uint16_t entrada) {
+  reproduzir_passo(estado, entrada);
+  desenhar_jogo(&disp, estado);
+  if (send_full)
+    ssd1306_invalidate(&disp);
+  if (send_async)
+    ssd1306_send_data_async(&disp);
+  else
+    ssd1306_send_data(&disp);
+}
+
+static void run(const replay_t *r, bool full, run_t *out) {
+  hal_reset();
+  ssd1306_emu_reset(&panel);
+  i2c_init(i2c1, 400000);
+  hal_i2c_attach(i2c1, 0x3C, &panel);
+  ssd1306_init(&disp, LARGURA, ALTURA, false, 0x3C, i2c1);
+  ssd1306_config(&disp);
+  ssd1306_fill(&disp, false);
+  ssd1306_send_data(&disp);
+  hal_i2c_reset_stats(i2c1);
+
+  send_full = full;
+  uint64_t virtual_start = time_us_64();
+  double start = wall_seconds();
+  replay_run(r, &work, step_send, hash_estado, &out->replay);
+  ssd1306_wait(&disp);
+  out->elapsed = wall_seconds() - start;
+  out->virtual_us = time_us_64() - virtual_start;
+  out->bus = hal_i2c_stats(i2c1);
+  out->gram_ok = gram_matches(&disp, &panel);
+  out->score[0] = work.pontuacao_jogador;
+  out->score[1] = work.pontuacao_ia;
+  ssd1306_deinit(&disp);
+}
+
+static void print_run(const char *name, const run_t *run) {
+  double frames = run->replay.ticks ? (double)run->replay.ticks : 1.0;
+  printf("  %-15s %10.0f %13.1f %12.2f %10.3f %10.3f\n", name, frames / run->elapsed, run->bus.bytes / frames,
+         run->bus.transactions / frames, run->bus.busy_us / frames / 1000.0, run->virtual_us / frames / 1000.0);
+}
+
+int main(int argc, char **argv) {
+  bench_opts_t opts;
+  replay_t r;
+  if (!parse_args(argc, argv, &opts)) {
+    usage(argv[0]);
+    return 2;
+  }
+  replay_init(&r, &snapshot, sizeof(snapshot), words, MAX_WORDS, checkpoints, MAX_CHECKPOINTS);
+  if (opts.input) {
+    if (!load(&r, opts.input)) {
+      fprintf(stderr, "não foi possível ler a gravação de %s\n", opts.input);
+      return 2;
+    }
+  } else {
+    record(&r, &opts);
+  }
+  send_async = opts.async;
+
+  run_t dirty, full;
+  run(&r, false, &dirty);
+  run(&r, true, &full);
+
+  printf("bench_pingpong: %lu quadros da sessão%s\n", (unsigned long)r.ticks, opts.async ? ", envio por DMA" : "");
+  printf("  envio            quadros/s  bytes/quadro  transações  ms ocupado  ms virtual\n");
+  print_run("janelas sujas", &dirty);
+  print_run("quadro inteiro", &full);
+  printf("placar final: %d - %d, hash da sessão %08lx (janelas sujas) e %08lx (quadro inteiro)\n", dirty.score[0],
+         dirty.score[1], (unsigned long)dirty.replay.chain, (unsigned long)full.replay.chain);
+
+  if (dirty.replay.mismatches || full.replay.mismatches || dirty.replay.chain != full.replay.chain) {
+    printf("ERRO: as duas reproduções não jogaram a mesma partida (%lu e %lu divergências)\n",
+           (unsigned long)dirty.replay.mismatches, (unsigned long)full.replay.mismatches);
+    return 1;
+  }
+  printf("mesma partida nos dois envios: janelas sujas mandam %.1f%% dos bytes do quadro inteiro\n",
+         100.0 * dirty.bus.bytes / full.bus.bytes);
+  if (!dirty.gram_ok || !full.gram_ok) {
+    printf("ERRO: GRAM do painel difere do buffer do driver\n");
+    return 1;
+  }
+  printf("GRAM confere com o buffer do driver\n");
+  return 0;
+}
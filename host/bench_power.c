@@ -0,0 +1,268 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "host_hal.h"
+#include "jogo.h"
+#include "libs/scheduler/scheduler.h"
+
+// Ciclo de trabalho do laço de um núcleo no relógio virtual da HAL: a mesma
+// sessão (partida, partida pausada pelo SEL, joystick parado até a
+// demonstração, joystick de volta) roda na configuração antiga (desenha e
+// envia todo quadro, sem demonstração) e na econômica (pula quadros iguais,
+// demonstração a 20Hz com o painel escurecido, acorda pelo joystick). O
+// corpo do laço é o do firmware (passo_jogo, verificar_espera e
+// apresentar_quadro, em jogo.c). Na pausa a cena não muda: a configuração
+// econômica não pode enviar nenhum quadro ali. O tempo acordado é o do
+// barramento simulado mais o de CPU medido no host vezes -k; o sono avança
+// o relógio até o prazo, parando a cada bloco do ADC (como as interrupções
+// de DMA acordam o núcleo na placa). A leitura do ADC no host é síncrona e
+// conta como tempo acordado nas duas configurações.
+
+#define FASE_JOGO_US 8000000ull
+#define FASE_PAUSA_US 3000000ull
+#define FASE_ESPERA_US 10000000ull
+#define FASE_VOLTA_US 2000000ull
+#define JOYSTICK_PARADO 2048
+#define EMPURRAO_US 100000                        // Joystick no fim do curso ao voltar, antes do roteiro
+#define APERTO_US 100000                          // SEL apertado para pausar (antes da pausa) e para retomar
+
+enum { FASE_JOGO, FASE_PAUSA, FASE_PARADO, FASE_ESPERA, FASE_VOLTA, FASES };
+static const char *const nomes_fases[FASES] = { "jogo", "pausa", "parado", "demo", "volta" };
+// Início de cada fase no relógio virtual. O SEL pausa um pouco antes da fase de pausa (a pausa inteira tem
+// a cena parada) e retoma no começo da fase parada; a demonstração começa TEMPO_INATIVIDADE_US depois
+static const uint64_t limites[FASES + 1] = {
+  0,
+  FASE_JOGO_US,
+  FASE_JOGO_US + FASE_PAUSA_US,
+  FASE_JOGO_US + FASE_PAUSA_US + APERTO_US + TEMPO_INATIVIDADE_US,
+  FASE_JOGO_US + FASE_PAUSA_US + APERTO_US + TEMPO_INATIVIDADE_US + FASE_ESPERA_US,
+  FASE_JOGO_US + FASE_PAUSA_US + APERTO_US + TEMPO_INATIVIDADE_US + FASE_ESPERA_US + FASE_VOLTA_US,
+};
+
+typedef struct {
+  uint64_t total_us, slept_us;
+  uint32_t wakeups, flushed, unchanged;
+  uint32_t bus_bytes;
+} fase_t;
+
+typedef struct {
+  fase_t fases[FASES];
+  uint64_t wake_latency_us;                       // Do empurrão até sair da demonstração
+  uint8_t contrast_espera, contrast_volta;        // Do painel no fim das fases
+  uint32_t sched_permille;                        // Último segundo da demonstração, pelo agendador
+  bool pausado;                                   // A partida ficou pausada a fase de pausa inteira
+} resultado_t;
+
+static ssd1306_emu_t emu;
+static ssd1306_t disp;
+static sched_t agendador;
+static double cpu_scale = 1.0;
+
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "uso: %s [-k fator] [-s semente]\n"
+          "  -k  multiplica o tempo de CPU medido no host (aproxima um núcleo mais lento; padrão 1)\n"
+          "  -s  semente do roteiro do joystick (padrão 1)\n",
+          prog);
+}
+
+static double wall_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint32_t lcg(uint32_t *state) {
+  *state = *state * 1664525u + 1013904223u;
+  return *state >> 16;
+}
+
+// Mesmo jogador roteirizado do bench_pingpong
+static uint16_t script_joystick(const struct EstadoJogo *estado, uint32_t *rng) {
+  int curso = ALTURA - ALTURA_RAQUETE;
+  int alvo = estado->bola_y - ALTURA_RAQUETE / 2 + (int)(lcg(rng) % 13) - 6;
+  if (alvo < 0) alvo = 0;
+  if (alvo > curso) alvo = curso;
+  int adc = (curso - alvo) * 4096 / curso;
+  return adc > 4095 ? 4095 : adc;
+}
+
+static void passo_partida(struct EstadoJogo *estado) {
+  ler_joystick(estado);
+  atualizar_ia(estado);
+  atualizar_bola(estado);
+}
+
+static uint64_t relogio(void *ctx) {
+  (void)ctx;
+  return time_us_64();
+}
+
+static unsigned fase_em(uint64_t t) {
+  unsigned fase = 0;
+  while (fase + 1 < FASES && t >= limites[fase + 1])
+    ++fase;
+  return fase;
+}
+
+static void rodar(bool economia, unsigned seed, resultado_t *r) {
+  const uint64_t volta = limites[FASE_VOLTA], fim = limites[FASES];
+  const uint64_t pausa = limites[FASE_PAUSA] - APERTO_US, retomada = limites[FASE_PARADO];
+  const uint64_t bloco_adc_us = 64 * 1000000ull / configuracao_joystick.sample_rate_hz;
+  static struct EstadoJogo estado;
+  static struct Laco laco;
+  static struct Apresentacao apresentacao;
+  uint8_t contraste = CONTRASTE_NORMAL;
+  uint32_t rng = seed;
+
+  memset(r, 0, sizeof(*r));
+  r->pausado = true;
+  hal_reset();
+  ssd1306_emu_reset(&emu);
+  i2c_init(i2c1, 400000);
+  hal_i2c_attach(i2c1, 0x3C, &emu);
+  input_init(&configuracao_joystick);
+  ssd1306_init(&disp, LARGURA, ALTURA, false, 0x3C, i2c1);
+  ssd1306_config(&disp);
+  ssd1306_fill(&disp, false);
+  ssd1306_send_data(&disp);
+  hal_i2c_reset_stats(i2c1);
+
+  inicializar_jogo(&estado);
+  sched_init(&agendador, 16667, 16667, relogio, NULL);
+  iniciar_laco(&laco, economia, true, time_us_64(), input_latest());
+  iniciar_apresentacao(&apresentacao, economia);
+
+  uint64_t agora;
+  while ((agora = time_us_64()) < fim) {
+    fase_t *f = &r->fases[fase_em(agora)];
+    uint32_t bytes = hal_i2c_stats(i2c1).bytes;
+    double inicio = wall_seconds();
+
+    if (agora >= volta)
+      hal_adc_set(1, agora < volta + EMPURRAO_US ? 4095 : script_joystick(&estado, &rng));
+    else if (agora >= pausa)
+      hal_adc_set(1, JOYSTICK_PARADO);
+    else
+      hal_adc_set(1, script_joystick(&estado, &rng));
+    bool apertado = (agora >= pausa && agora < pausa + APERTO_US) || (agora >= retomada && agora < retomada + APERTO_US);
+    hal_gpio_set(configuracao_joystick.select_gpio, !apertado);  // Ativo em nível baixo
+
+    uint32_t passos = sched_ticks_due(&agendador);
+    while (passos--)
+      passo_jogo(&laco, &estado, passo_partida);
+
+    if (verificar_espera(&laco, &estado, time_us_64(), input_latest())) {
+      if (laco.espera.ativa) {
+        sched_set_periods(&agendador, PERIODO_ESPERA_US, PERIODO_ESPERA_US);
+        contraste = CONTRASTE_ESPERA;
+      } else {
+        sched_set_periods(&agendador, 16667, 16667);
+        contraste = CONTRASTE_NORMAL;
+        r->wake_latency_us = time_us_64() - volta;
+      }
+    }
+    if (fase_em(agora) == FASE_PAUSA)
+      r->pausado &= laco.pausado;
+
+    if (sched_frame_due(&agendador)) {
+      if (apresentar_quadro(&apresentacao, &estado, contraste, &disp, 1, &agendador)) {
+        desenhar_jogo(&disp, &estado);
+        ssd1306_send_data(&disp);
+        f->flushed++;
+      } else {
+        f->unchanged++;
+      }
+    }
+    hal_advance_us((wall_seconds() - inicio) * 1e6 * cpu_scale);
+    f->bus_bytes += hal_i2c_stats(i2c1).bytes - bytes;
+
+    // Sono até o prazo, acordando a cada bloco do ADC
+    uint64_t prazo = sched_next_deadline(&agendador);
+    uint64_t dormiu = time_us_64();
+    sched_sleep_begin(&agendador, 0);
+    while ((agora = time_us_64()) < prazo) {
+      uint64_t passo = prazo - agora < bloco_adc_us ? prazo - agora : bloco_adc_us;
+      hal_advance_us(passo);
+      f->wakeups++;
+      if (agora + passo >= volta && agora < volta + EMPURRAO_US)
+        hal_adc_set(1, 4095);                       // Mexeram no joystick durante o sono
+      if (laco.espera.ativa && joystick_mexeu(&laco.espera, input_latest()))
+        break;
+    }
+    sched_sleep_end(&agendador, 0);
+    f->slept_us += time_us_64() - dormiu;
+
+    if (f == &r->fases[FASE_ESPERA] && fase_em(time_us_64()) != FASE_ESPERA) {
+      sched_report_t rep;
+      sched_report(&agendador, &rep);
+      r->sched_permille = rep.active_permille[0];
+      r->contrast_espera = emu.contrast;
+    }
+  }
+  r->contrast_volta = emu.contrast;
+  for (unsigned i = 0; i < FASES; ++i)
+    r->fases[i].total_us = limites[i + 1] - limites[i];
+  ssd1306_deinit(&disp);
+}
+
+static uint32_t permille_ativo(const fase_t *f) {
+  return f->slept_us >= f->total_us ? 0 : (uint32_t)((f->total_us - f->slept_us) * 1000 / f->total_us);
+}
+
+static void imprimir(const char *titulo, const resultado_t *r) {
+  printf("%s\n", titulo);
+  printf("  %-14s %9s %11s %10s %10s %12s\n", "fase", "ativo (%)", "acordadas/s", "quadros", "iguais", "bytes/s");
+  for (unsigned i = 0; i < FASES; ++i) {
+    const fase_t *f = &r->fases[i];
+    double s = f->total_us / 1e6;
+    printf("  %-14s %9.1f %11.1f %10lu %10lu %12.0f\n", nomes_fases[i], permille_ativo(f) / 10.0, f->wakeups / s,
+           (unsigned long)f->flushed, (unsigned long)f->unchanged, f->bus_bytes / s);
+  }
+}
+
+int main(int argc, char **argv) {
+  unsigned seed = 1;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "-k") && i + 1 < argc) {
+      cpu_scale = atof(argv[++i]);
+    } else if (!strcmp(argv[i], "-s") && i + 1 < argc) {
+      seed = strtoul(argv[++i], NULL, 0);
+    } else {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+
+  static resultado_t referencia, economia;
+  rodar(false, seed, &referencia);
+  rodar(true, seed, &economia);
+  imprimir("referência (todo quadro enviado, sem demonstração)", &referencia);
+  imprimir("econômico (quadros iguais pulados, demonstração a 20Hz)", &economia);
+
+  uint32_t ref = permille_ativo(&referencia.fases[FASE_ESPERA]);
+  uint32_t eco = permille_ativo(&economia.fases[FASE_ESPERA]);
+  printf("demonstração: %.1f%% ativo (agendador: %.1f%% no último segundo) contra %.1f%% (%.1fx menos)\n",
+         eco / 10.0, economia.sched_permille / 10.0, ref / 10.0, eco ? (double)ref / eco : 0.0);
+  printf("volta ao jogo %.1f ms depois do joystick; contraste %u na demonstração, %u depois\n",
+         economia.wake_latency_us / 1000.0, economia.contrast_espera, economia.contrast_volta);
+
+  const fase_t *pausa = &economia.fases[FASE_PAUSA];
+  printf("pausa: %lu quadros iguais e %lu enviados (referência: %lu enviados)\n", (unsigned long)pausa->unchanged,
+         (unsigned long)pausa->flushed, (unsigned long)referencia.fases[FASE_PAUSA].flushed);
+
+  if (eco >= ref || !economia.wake_latency_us || economia.wake_latency_us > 5000 ||
+      economia.contrast_espera != CONTRASTE_ESPERA || economia.contrast_volta != CONTRASTE_NORMAL) {
+    printf("ERRO: economia de energia não confere\n");
+    return 1;
+  }
+  if (!economia.pausado || !referencia.pausado || !pausa->unchanged || pausa->flushed || pausa->bus_bytes ||
+      !referencia.fases[FASE_PAUSA].flushed) {
+    printf("ERRO: na pausa a cena parada não pode ir ao painel\n");
+    return 1;
+  }
+  return 0;
+}
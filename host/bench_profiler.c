@@ -0,0 +1,120 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "host_hal.h"
+#include "jogo.h"
+
+// Roda o jogo com o perfil por zonas ligado (PROFILER_ENABLED) e exporta o
+// anel no mesmo formato do comando 'p' da placa, para o prof2chrome
+// converter. Mede o custo de um par PROF_BEGIN/PROF_END e confere que as
+// zonas gravadas se aninham direito (cada fim fecha a última zona aberta).
+
+#define FRAMES 2000
+#define PAIRS 1000000
+
+static ssd1306_emu_t emu;
+static ssd1306_t disp;
+
+static double wall_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint32_t lcg(uint32_t *state) {
+  *state = *state * 1664525u + 1013904223u;
+  return *state >> 16;
+}
+
+static uint16_t script_joystick(const struct EstadoJogo *estado, uint32_t *rng) {
+  int curso = ALTURA - ALTURA_RAQUETE;
+  int alvo = estado->bola_y - ALTURA_RAQUETE / 2 + (int)(lcg(rng) % 13) - 6;
+  if (alvo < 0) alvo = 0;
+  if (alvo > curso) alvo = curso;
+  int adc = (curso - alvo) * 4096 / curso;
+  return adc > 4095 ? 4095 : adc;
+}
+
+static void write_file(void *ctx, const uint8_t *data, size_t len) {
+  fwrite(data, 1, len, ctx);
+}
+
+// Eventos do núcleo 0 fora de ordem: um fim que não fecha a zona aberta mais
+// recente. Fins sem começo no início do anel (sobrescrito) não contam.
+static unsigned nesting_errors(void) {
+  const profiler_ring_t *ring = &profiler_rings[0];
+  uint32_t count = ring->head < PROFILER_EVENTS ? ring->head : PROFILER_EVENTS;
+  uint8_t stack[64];
+  unsigned depth = 0, errors = 0;
+  for (uint32_t i = ring->head - count; i != ring->head; ++i) {
+    uint32_t tag = ring->events[i % PROFILER_EVENTS].tag;
+    uint8_t zone = (tag >> PROFILER_ZONE_SHIFT) & 0x7F;
+    if (!(tag & PROFILER_END_BIT)) {
+      if (depth < sizeof(stack))
+        stack[depth++] = zone;
+    } else if (depth) {
+      errors += stack[--depth] != zone;
+    }
+  }
+  return errors;
+}
+
+int main(int argc, char **argv) {
+  const char *path = argc > 1 ? argv[1] : "perfil.bin";
+  struct EstadoJogo estado;
+  uint32_t rng = 1;
+
+  PROF_INIT_CORE();
+  double start = wall_seconds();
+  for (int i = 0; i < PAIRS; ++i) {
+    PROF_BEGIN(PROF_ATUALIZAR_IA);
+    PROF_END(PROF_ATUALIZAR_IA);
+  }
+  double event_ns = (wall_seconds() - start) * 1e9 / (2.0 * PAIRS);
+  profiler_reset();
+
+  hal_reset();
+  input_init(&configuracao_joystick);
+  ssd1306_emu_reset(&emu);
+  i2c_init(i2c1, 400000);
+  hal_i2c_attach(i2c1, 0x3C, &emu);
+  ssd1306_init(&disp, LARGURA, ALTURA, false, 0x3C, i2c1);
+  ssd1306_config(&disp);
+  desenhar_tela_inicial(&disp);
+  ssd1306_send_data(&disp);
+
+  inicializar_jogo(&estado);
+  for (unsigned frame = 0; frame < FRAMES; ++frame) {
+    hal_adc_set(1, script_joystick(&estado, &rng));
+    ler_joystick(&estado);
+    atualizar_ia(&estado);
+    atualizar_bola(&estado);
+    desenhar_jogo(&disp, &estado);
+    ssd1306_send_data_async(&disp);
+    ssd1306_wait(&disp);
+  }
+  ssd1306_deinit(&disp);
+
+  uint32_t events = profiler_rings[0].head;
+  unsigned errors = nesting_errors();
+  printf("%.1f ns por evento (host), %.1f eventos por quadro, %u no anel\n", event_ns, (double)events / FRAMES,
+         events < PROFILER_EVENTS ? events : PROFILER_EVENTS);
+
+  FILE *out = fopen(path, "wb");
+  if (!out) {
+    perror(path);
+    return 1;
+  }
+  profiler_dump(write_file, out);
+  fclose(out);
+  printf("perfil em %s (prof2chrome %s perfil.json)\n", path, path);
+
+  if (errors || events <= PROFILER_EVENTS) {
+    printf("ERRO: %u zonas fora de ordem, %lu eventos\n", errors, (unsigned long)events);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,228 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "pico/stdlib.h"
+#include "host_hal.h"
+#include "jogo.h"
+
+// Grava uma sessão com o joystick roteirizado (ou carrega uma gravada na
+// placa com o comando 'd') e a reproduz o mais rápido possível, conferindo
+// os hashes do estado. Também confere que o texto do 'd' (instantâneo
+// serializado campo a campo) volta igual pelo replay_load. O hash encadeado impresso no fim identifica a sessão:
+// se ele muda depois de uma otimização, o comportamento do jogo mudou.
+
+#define MAX_WORDS (1u << 20)
+#define MAX_CHECKPOINTS (MAX_WORDS * REPLAY_RUN_MAX / REPLAY_CHECKPOINT_TICKS)
+
+typedef struct {
+  unsigned long ticks;
+  unsigned seed;
+  const char *input;
+  bool dump;
+  bool render;
+} bench_opts_t;
+
+static struct EstadoJogo snapshot, work;
+static uint16_t words[MAX_WORDS];
+static replay_checkpoint_t checkpoints[MAX_CHECKPOINTS];
+static ssd1306_t disp;
+
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "uso: %s [-n ticks] [-s semente] [-i arquivo] [-d] [-r]\n"
+          "  -n  ticks gravados com o joystick roteirizado (padrão 100000)\n"
+          "  -s  semente do roteiro do joystick (padrão 1)\n"
+          "  -i  reproduz uma gravação da placa (saída do comando 'd')\n"
+          "  -d  imprime a gravação no mesmo formato do comando 'd'\n"
+          "  -r  também desenha cada tick no buffer do display\n",
+          prog);
+}
+
+static bool parse_args(int argc, char **argv, bench_opts_t *o) {
+  o->ticks = 100000;
+  o->seed = 1;
+  o->input = NULL;
+  o->dump = false;
+  o->render = false;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "-n") && i + 1 < argc)
+      o->ticks = strtoul(argv[++i], NULL, 0);
+    else if (!strcmp(argv[i], "-s") && i + 1 < argc)
+      o->seed = strtoul(argv[++i], NULL, 0);
+    else if (!strcmp(argv[i], "-i") && i + 1 < argc)
+      o->input = argv[++i];
+    else if (!strcmp(argv[i], "-d"))
+      o->dump = true;
+    else if (!strcmp(argv[i], "-r"))
+      o->render = true;
+    else
+      return false;
+  }
+  return true;
+}
+
+static double wall_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint32_t lcg(uint32_t *state) {
+  *state = *state * 1664525u + 1013904223u;
+  return *state >> 16;
+}
+
+// Mesmo jogador roteirizado do bench_pingpong
+static uint16_t script_joystick(const struct EstadoJogo *estado, uint32_t *rng) {
+  int curso = ALTURA - ALTURA_RAQUETE;
+  int alvo = estado->bola_y - ALTURA_RAQUETE / 2 + (int)(lcg(rng) % 13) - 6;
+  if (alvo < 0) alvo = 0;
+  if (alvo > curso) alvo = curso;
+  int adc = (curso - alvo) * 4096 / curso;
+  return adc > 4095 ? 4095 : adc;
+}
+
+static void record(replay_t *r, const bench_opts_t *o) {
+  struct EstadoJogo estado;
+  uint32_t rng = o->seed;
+
+  hal_reset();
+  input_init(&configuracao_joystick);
+  inicializar_jogo(&estado);
+  replay_start(r, &estado);
+  for (unsigned long t = 0; t < o->ticks; ++t) {
+    hal_adc_set(1, script_joystick(&estado, &rng));
+    uint16_t entrada = ler_joystick(&estado);
+    atualizar_ia(&estado);
+    atualizar_bola(&estado);
+    if (!replay_record(r, entrada, hash_estado(&estado)))
+      break;
+  }
+  replay_stop(r);
+}
+
+// Carrega o texto do comando 'd' e desserializa o instantâneo
+static bool load(replay_t *r, const char *path) {
+  static uint8_t packed[TAMANHO_ESTADO_SERIALIZADO];
+  size_t len;
+  FILE *f = fopen(path, "r");
+  if (!f)
+    return false;
+  bool ok = replay_load(r, f, packed, sizeof(packed), &len);
+  fclose(f);
+  if (ok && !desserializar_estado(&snapshot, packed, len)) {
+    fprintf(stderr, "instantâneo de %zu bytes ou versão %u não reconhecidos (este programa lê a versão %u)\n", len,
+            len ? packed[0] : 0, VERSAO_ESTADO);
+    ok = false;
+  }
+  return ok;
+}
+
+// O texto de replay_dump volta pelo replay_load igual: mesmo instantâneo,
+// mesmas palavras e pontos, e outra versão do formato é recusada
+static bool check_dump_roundtrip(const replay_t *r) {
+  static struct EstadoJogo loaded_snapshot;
+  static uint16_t loaded_words[MAX_WORDS];
+  static replay_checkpoint_t loaded_checkpoints[MAX_CHECKPOINTS];
+  static uint8_t packed[TAMANHO_ESTADO_SERIALIZADO];
+  replay_t loaded;
+  char *text = NULL;
+  size_t text_len = 0, len;
+
+  FILE *out = open_memstream(&text, &text_len);
+  replay_dump(r, out, packed, serializar_estado(&snapshot, packed));
+  fclose(out);
+
+  replay_init(&loaded, &loaded_snapshot, sizeof(loaded_snapshot), loaded_words, MAX_WORDS, loaded_checkpoints,
+              MAX_CHECKPOINTS);
+  FILE *in = fmemopen(text, text_len, "r");
+  bool ok = replay_load(&loaded, in, packed, sizeof(packed), &len) &&
+            desserializar_estado(&loaded_snapshot, packed, len);
+  fclose(in);
+  ok = ok && hash_estado(&loaded_snapshot) == hash_estado(&snapshot) && loaded.ticks == r->ticks &&
+       loaded.len == r->len && loaded.final_hash == r->final_hash &&
+       !memcmp(loaded_words, r->words, r->len * sizeof(uint16_t)) &&
+       !memcmp(loaded_checkpoints, r->checkpoints, r->checkpoints_len * sizeof(replay_checkpoint_t));
+
+  text[8] = '1';                                  // "replay v1": struct crua de versões antigas
+  in = fmemopen(text, text_len, "r");
+  bool old_accepted = replay_load(&loaded, in, packed, sizeof(packed), &len);
+  fclose(in);
+  free(text);
+
+  struct EstadoJogo multi, back;                  // Multibola: 18 bytes por bola
+  inicializar_multibola(&multi, PHYS_BALLS_MAX);
+  for (int t = 0; t < 200; ++t)
+    reproduzir_passo(&multi, 2048);
+  len = serializar_estado(&multi, packed);
+  ok = ok && len == TAMANHO_ESTADO_SERIALIZADO && desserializar_estado(&back, packed, len) &&
+       hash_estado(&back) == hash_estado(&multi) && !desserializar_estado(&back, packed, len - 1);
+  return ok && !old_accepted;
+}
+
+static void step_render(void *estado, uint16_t entrada) {
+  reproduzir_passo(estado, entrada);
+  desenhar_jogo(&disp, estado);
+}
+
+int main(int argc, char **argv) {
+  bench_opts_t opts;
+  replay_t r;
+
+  if (!parse_args(argc, argv, &opts)) {
+    usage(argv[0]);
+    return 2;
+  }
+  replay_init(&r, &snapshot, sizeof(snapshot), words, MAX_WORDS, checkpoints, MAX_CHECKPOINTS);
+  if (opts.input) {
+    if (!load(&r, opts.input)) {
+      fprintf(stderr, "não foi possível ler a gravação de %s\n", opts.input);
+      return 2;
+    }
+  } else {
+    record(&r, &opts);
+  }
+  if (opts.dump) {
+    static uint8_t packed[TAMANHO_ESTADO_SERIALIZADO];
+    replay_dump(&r, stdout, packed, serializar_estado(&snapshot, packed));
+    return 0;
+  }
+  printf("gravação: %lu ticks em %lu palavras (%.2f bytes/tick), %lu pontos de verificação\n",
+         (unsigned long)r.ticks, (unsigned long)r.len, r.ticks ? 2.0 * r.len / r.ticks : 0.0,
+         (unsigned long)r.checkpoints_len);
+
+  replay_step_t step = reproduzir_passo;
+  if (opts.render) {
+    ssd1306_init(&disp, LARGURA, ALTURA, false, 0x3C, NULL);
+    step = step_render;
+  }
+
+  replay_result_t first, second;
+  double start = wall_seconds();
+  replay_run(&r, &work, step, hash_estado, &first);
+  double elapsed = wall_seconds() - start;
+  replay_run(&r, &work, step, hash_estado, &second);
+  if (opts.render)
+    ssd1306_deinit(&disp);
+
+  printf("reprodução: %lu ticks em %.3f s (%.0f ns/tick)\n", (unsigned long)first.ticks, elapsed,
+         first.ticks ? elapsed * 1e9 / first.ticks : 0.0);
+  printf("verificações %lu, divergências %lu", (unsigned long)first.checked, (unsigned long)first.mismatches);
+  if (first.mismatches)
+    printf(" (primeira no tick %lu)", (unsigned long)first.first_mismatch_tick);
+  printf("\nplacar final: %d - %d, hash da sessão %08lx\n", work.pontuacao_jogador, work.pontuacao_ia,
+         (unsigned long)first.chain);
+
+  if (first.chain != second.chain) {
+    printf("ERRO: duas reproduções deram hashes diferentes\n");
+    return 1;
+  }
+  printf("texto do comando 'd': ida e volta, e uma gravação v1 (struct crua) tem de ser recusada\n");
+  fflush(stdout);
+  if (!check_dump_roundtrip(&r)) {
+    printf("ERRO: a gravação não volta igual pelo texto do comando 'd'\n");
+    return 1;
+  }
+  return first.mismatches ? 1 : 0;
+}
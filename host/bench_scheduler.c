@@ -0,0 +1,115 @@
+#include <stdio.h>
+#include "libs/scheduler/scheduler.h"
+
+// Testes do agendador com um relógio falso, avançado à mão: ticks em dia,
+// recuperação de atraso até o limite (SCHED_MAX_CATCHUP, 4) com o excesso
+// contado em missed_ticks, quadros atrasados pulados sem perder a fase e a
+// troca de cadência, que recomeça os prazos no instante da troca.
+
+static uint64_t fake_now;
+static unsigned failures;
+
+static uint64_t fake_clock(void *ctx) {
+  return *(const uint64_t *)ctx;
+}
+
+// Cada valor é avaliado uma vez só (muitos são chamadas ao agendador)
+static void check_eq(const char *what, unsigned long got, unsigned long expected) {
+  if (got != expected) {
+    printf("ERRO: %s: %lu (esperado %lu)\n", what, got, expected);
+    failures++;
+  }
+}
+
+#define CHECK_EQ(what, got, expected) check_eq(what, (unsigned long)(got), (unsigned long)(expected))
+
+static void test_ticks(void) {
+  sched_t s;
+  fake_now = 1000;
+  sched_init(&s, 1000, 2000, fake_clock, &fake_now);
+
+  CHECK_EQ("tick no início", sched_ticks_due(&s), 1);
+  fake_now = 1999;
+  CHECK_EQ("antes do prazo", sched_ticks_due(&s), 0);
+  fake_now = 2000;
+  CHECK_EQ("no prazo", sched_ticks_due(&s), 1);
+
+  fake_now = 5500;                                // Prazos 3000, 4000 e 5000 vencidos
+  CHECK_EQ("recupera 3 ticks", sched_ticks_due(&s), 3);
+  CHECK_EQ("sem ticks perdidos", s.missed_ticks, 0);
+  CHECK_EQ("fase mantida", s.next_tick, 6000);
+
+  fake_now = 16000;                               // 11 prazos vencidos (6000 a 16000)
+  CHECK_EQ("recuperação limitada", sched_ticks_due(&s), 4);
+  CHECK_EQ("excesso descartado", s.missed_ticks, 7);
+  CHECK_EQ("recomeça depois do limite", s.next_tick, 17000);
+  fake_now = 16999;
+  CHECK_EQ("sem rajada depois do limite", sched_ticks_due(&s), 0);
+  fake_now = 17000;
+  CHECK_EQ("volta à cadência", sched_ticks_due(&s), 1);
+  CHECK_EQ("ticks executados", s.ticks, 10);
+}
+
+static void test_frames(void) {
+  sched_t s;
+  fake_now = 1000;
+  sched_init(&s, 1000, 2000, fake_clock, &fake_now);
+
+  CHECK_EQ("quadro no início", sched_frame_due(&s), true);
+  CHECK_EQ("um quadro por prazo", sched_frame_due(&s), false);
+  fake_now = 3000;
+  CHECK_EQ("quadro no prazo", sched_frame_due(&s), true);
+
+  fake_now = 9700;                                // Prazo 5000 atrasado; 7000 e 9000 já passaram
+  CHECK_EQ("quadro atrasado sai", sched_frame_due(&s), true);
+  CHECK_EQ("quadros pulados", s.dropped_frames, 2);
+  CHECK_EQ("fase mantida", s.next_frame, 11000);
+  fake_now = 10999;
+  CHECK_EQ("sem quadro antes da fase", sched_frame_due(&s), false);
+  fake_now = 11000;
+  CHECK_EQ("quadro na fase", sched_frame_due(&s), true);
+  CHECK_EQ("quadros desenhados", s.frames, 4);
+
+  sched_report_t r;                               // Intervalos 2000, 6700 e 1300
+  sched_report(&s, &r);
+  CHECK_EQ("intervalo mínimo", r.frame_min_us, 1300);
+  CHECK_EQ("intervalo máximo", r.frame_max_us, 6700);
+  CHECK_EQ("intervalo médio", r.frame_avg_us, 3333);
+}
+
+static void test_set_periods(void) {
+  sched_t s;
+  fake_now = 0;
+  sched_init(&s, 16667, 16667, fake_clock, &fake_now);
+  sched_ticks_due(&s);
+  sched_frame_due(&s);
+
+  fake_now = 20345;                               // Mais de um período depois: não conta como atraso
+  sched_set_periods(&s, 50000, 50000);
+  CHECK_EQ("tick na troca", sched_ticks_due(&s), 1);
+  CHECK_EQ("quadro na troca", sched_frame_due(&s), true);
+  CHECK_EQ("troca sem ticks perdidos", s.missed_ticks, 0);
+  CHECK_EQ("troca sem quadros pulados", s.dropped_frames, 0);
+  CHECK_EQ("próximo prazo na nova cadência", sched_next_deadline(&s), 70345);
+  fake_now = 70344;
+  CHECK_EQ("nada antes da nova cadência", sched_ticks_due(&s) + sched_frame_due(&s), 0);
+  fake_now = 70345;
+  CHECK_EQ("tick na nova cadência", sched_ticks_due(&s), 1);
+
+  fake_now = 80000;                               // Volta à cadência normal no meio de um período
+  sched_set_periods(&s, 1000, 4000);
+  CHECK_EQ("tick na volta", sched_ticks_due(&s), 1);
+  CHECK_EQ("quadro na volta", sched_frame_due(&s), true);
+  fake_now = 83500;
+  CHECK_EQ("ticks com a fase da troca", sched_ticks_due(&s), 3);
+  CHECK_EQ("próximo tick", s.next_tick, 84000);
+  CHECK_EQ("próximo quadro", s.next_frame, 84000);
+}
+
+int main(void) {
+  test_ticks();
+  test_frames();
+  test_set_periods();
+  printf("bench_scheduler: %s\n", failures ? "ERRO" : "ticks, recuperação, quadros pulados e troca de cadência ok");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,173 @@
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "host_hal.h"
+#include "jogo.h"
+#include "libs/ssd1306/ssd1306_spi.h"
+
+// Codificação das palavras do SPI por PIO conferida contra um modelo da
+// máquina de estados, e não contra a conta inversa (como no transport_mock):
+// OSR deslocando para a esquerda com autopull de 16 bits, "out pins, 2
+// side 0" põe OSR[31:30] em D/C# (base) e MOSI (base + 1), "nop side 1"
+// sobe o SCK. Do outro lado, o painel amostra MOSI na borda de subida, bit
+// mais significativo primeiro, e D/C# no oitavo bit.
+//   bytes:  os 256 valores, em comando e em dado, escritos como o
+//           pio_sm_put_blocking (palavra << 16) e como o DMA de 16 bits
+//           (replicada nas duas metades); D/C# tem de ficar no mesmo nível
+//           nos 8 bits e cada palavra dá exatamente 8 bordas de SCK
+//   quadros: o driver com um transporte que passa cada palavra pelo modelo
+//           (ssd1306_spi_queue de verdade no envio por DMA); a GRAM do
+//           painel tem de ser igual ao ram_buffer depois de cada quadro
+
+#define FRAMES 200
+
+typedef struct {
+  uint32_t osr;
+  ssd1306_emu_t *panel;                           // NULL: só registra o último byte
+  uint8_t shifter;
+  unsigned bits;
+  bool dc_first;
+  unsigned long edges, bytes, dc_glitches;
+  uint8_t last_byte;
+  bool last_data;
+} pio_model_t;
+
+static pio_model_t model;
+static ssd1306_emu_t panel;
+static ssd1306_t disp;
+
+// Uma palavra do FIFO: o autopull recarrega o OSR depois de 16 bits, então
+// a metade de baixo de uma escrita replicada nunca sai
+static void pio_model_push(pio_model_t *m, uint32_t fifo_word) {
+  m->osr = fifo_word;
+  for (unsigned shifted = 0; shifted < 16; shifted += 2) {
+    uint32_t pins = m->osr >> 30;                 // out pins, 2 side 0
+    m->osr <<= 2;
+    bool dc = pins & 1, mosi = pins >> 1;
+    m->edges++;                                   // nop side 1
+    if (m->bits == 0)
+      m->dc_first = dc;
+    else if (dc != m->dc_first)
+      m->dc_glitches++;
+    m->shifter = m->shifter << 1 | mosi;
+    if (++m->bits == 8) {
+      m->bits = 0;
+      m->bytes++;
+      m->last_byte = m->shifter;
+      m->last_data = dc;
+      if (m->panel)
+        ssd1306_emu_spi_byte(m->panel, dc, m->shifter);
+    }
+  }
+}
+
+static bool check_bytes(bool replicated) {
+  unsigned long wrong = 0;
+  memset(&model, 0, sizeof(model));
+  for (unsigned command = 0; command < 2; ++command)
+    for (unsigned value = 0; value < 256; ++value) {
+      uint32_t word = ssd1306_spi_word(value, command);
+      unsigned long edges = model.edges;
+      pio_model_push(&model, replicated ? word | word << 16 : word << 16);
+      if (model.edges - edges != 8 || model.last_byte != value || model.last_data == command)
+        wrong++;
+    }
+  bool ok = !wrong && !model.dc_glitches && model.bytes == 512 && model.bits == 0;
+  printf("bytes, %-13s %lu bytes, %lu errados, %lu trocas de D/C# no meio do byte  %s\n",
+         replicated ? "DMA 16 bits:" : "bloqueante:", model.bytes, wrong, model.dc_glitches, ok ? "ok" : "ERRO");
+  return ok;
+}
+
+// Transporte de teste: as escritas bloqueantes usam a palavra na metade de
+// cima, como ssd1306_spi_write; o envio por DMA passa o dma_buffer montado
+// por ssd1306_spi_queue, com a replicação das escritas de 16 bits
+static void pio_write(const uint8_t *bytes, size_t count, bool command) {
+  for (size_t i = 0; i < count; ++i)
+    pio_model_push(&model, (uint32_t)ssd1306_spi_word(bytes[i], command) << 16);
+}
+
+static void pio_commands(ssd1306_t *ssd, const uint8_t *commands, size_t count) {
+  (void)ssd;
+  pio_write(commands, count, true);
+}
+
+static void pio_data(ssd1306_t *ssd, const uint8_t *buffer, size_t len) {
+  (void)ssd;
+  pio_write(buffer + 1, len - 1, false);
+}
+
+static void pio_start(ssd1306_t *ssd) {
+  for (size_t i = 0; i < ssd->dma_len; ++i)
+    pio_model_push(&model, ssd->dma_buffer[i] | (uint32_t)ssd->dma_buffer[i] << 16);
+}
+
+static bool pio_busy(ssd1306_t *ssd) {
+  (void)ssd;
+  return false;
+}
+
+static const ssd1306_transport_t pio_transport = {
+  .commands = pio_commands,
+  .data = pio_data,
+  .queue = ssd1306_spi_queue,
+  .start = pio_start,
+  .busy = pio_busy,
+  .segment_overhead = 0,
+};
+
+static uint32_t lcg(uint32_t *state) {
+  *state = *state * 1664525u + 1013904223u;
+  return *state >> 16;
+}
+
+static unsigned gram_differences(void) {
+  unsigned diff = 0;
+  for (unsigned x = 0; x < disp.width; ++x)
+    for (unsigned p = 0; p < disp.pages; ++p)
+      diff += ssd1306_emu_column_byte(&panel, x, p) != disp.ram_buffer[1 + x * disp.pages + p];
+  return diff;
+}
+
+static bool check_frames(void) {
+  hal_reset();
+  ssd1306_emu_reset(&panel);
+  memset(&model, 0, sizeof(model));
+  model.panel = &panel;
+  i2c_init(i2c1, 400000);
+  ssd1306_init(&disp, LARGURA, ALTURA, false, 0x3C, i2c1);
+  ssd1306_set_transport(&disp, &pio_transport, NULL);
+  ssd1306_config(&disp);
+
+  uint32_t rng = 1;
+  unsigned long bad_frames = 0;
+  for (unsigned frame = 0; frame < FRAMES; ++frame) {
+    unsigned rects = 1 + lcg(&rng) % 4;
+    for (unsigned r = 0; r < rects; ++r)
+      ssd1306_rect(&disp, lcg(&rng) % disp.height, lcg(&rng) % disp.width, 1 + lcg(&rng) % 40,
+                   1 + lcg(&rng) % 20, lcg(&rng) & 1, true);
+    switch (frame % 3) {
+    case 0: ssd1306_send_data(&disp); break;      // Bloqueante, quadro inteiro
+    case 1: ssd1306_send_data_async(&disp); break;  // DMA, janelas sujas
+    default:
+      ssd1306_invalidate(&disp);
+      ssd1306_send_data_async(&disp);
+    }
+    ssd1306_wait(&disp);
+    bad_frames += gram_differences() != 0;
+  }
+  ssd1306_deinit(&disp);
+  bool ok = !bad_frames && !model.dc_glitches && model.bits == 0;
+  printf("quadros:  %u quadros, %lu bytes pelo modelo, %lu quadros com a GRAM diferente, %lu trocas de D/C# no "
+         "meio do byte  %s\n",
+         FRAMES, model.bytes, bad_frames, model.dc_glitches, ok ? "ok" : "ERRO");
+  return ok;
+}
+
+int main(void) {
+  printf("bench_spi_pio: palavras do SPI por PIO num modelo da máquina de estados\n");
+  bool ok = check_bytes(false);
+  ok = check_bytes(true) && ok;
+  ok = check_frames() && ok;
+  return ok ? 0 : 1;
+}
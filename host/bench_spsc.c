@@ -0,0 +1,155 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "libs/spsc/spsc.h"
+
+// Teste de estresse das filas entre núcleos com duas threads de verdade:
+// um produtor publica itens numerados, cada um com o número repetido (e
+// embaralhado) em todo o corpo, e um consumidor confere a ordem, a perda e
+// se algum item chegou rasgado (metade de um, metade de outro).
+//   fila:          spsc_push/spsc_pop, produtor repete quando a fila enche;
+//                  nenhum item pode faltar nem vir fora de ordem
+//   fila, latest:  spsc_pop_latest; números só crescem
+//   caixa:         spsc_latest_publish/take (o último vence); números só
+//                  crescem e o último item publicado sempre chega
+
+#define ITEMS 2000000
+#define WORDS 31                                  // Item de 128 bytes, como um pedaço do estado do jogo
+
+typedef struct {
+  uint32_t seq;
+  uint32_t body[WORDS];
+} item_t;
+
+typedef enum { MODE_QUEUE, MODE_QUEUE_LATEST, MODE_MAILBOX } mode_t_;
+
+typedef struct {
+  mode_t_ mode;
+  spsc_queue_t queue;
+  spsc_latest_t mailbox;
+  _Atomic int done;
+  unsigned long received, lost, out_of_order, torn;
+  uint32_t last;
+} test_t;
+
+static item_t queue_storage[16];
+static item_t mailbox_storage[SPSC_LATEST_SLOTS];
+
+static void fill_item(item_t *it, uint32_t seq) {
+  it->seq = seq;
+  for (unsigned i = 0; i < WORDS; ++i)
+    it->body[i] = seq * 2654435761u + i;
+}
+
+static bool item_whole(const item_t *it) {
+  for (unsigned i = 0; i < WORDS; ++i)
+    if (it->body[i] != it->seq * 2654435761u + i)
+      return false;
+  return true;
+}
+
+static void *producer(void *arg) {
+  test_t *t = arg;
+  item_t it;
+  for (uint32_t seq = 1; seq <= ITEMS; ++seq) {
+    fill_item(&it, seq);
+    if (t->mode == MODE_MAILBOX)
+      spsc_latest_publish(&t->mailbox, &it);
+    else
+      while (!spsc_push(&t->queue, &it))
+        sched_yield();                            // Com uma CPU só, a espera precisa ceder a vez
+    if (seq % 64 == 0)
+      sched_yield();                              // Mais trocas entre as threads quando há poucas CPUs
+  }
+  atomic_store(&t->done, 1);
+  return NULL;
+}
+
+static bool consume_one(test_t *t, item_t *it) {
+  switch (t->mode) {
+  case MODE_QUEUE: return spsc_pop(&t->queue, it);
+  case MODE_QUEUE_LATEST: return spsc_pop_latest(&t->queue, it);
+  default: return spsc_latest_take(&t->mailbox, it);
+  }
+}
+
+static void *consumer(void *arg) {
+  test_t *t = arg;
+  item_t it;
+  for (;;) {
+    int done = atomic_load(&t->done);             // Lido antes: depois dele, nada mais chega
+    bool got = false;
+    while (consume_one(t, &it)) {
+      got = true;
+      t->received++;
+      if (!item_whole(&it))
+        t->torn++;
+      if (it.seq <= t->last)
+        t->out_of_order++;
+      else if (t->mode == MODE_QUEUE && it.seq != t->last + 1)
+        t->lost += it.seq - t->last - 1;
+      t->last = it.seq;
+    }
+    if (done && !got)
+      return NULL;
+    if (!got)
+      sched_yield();
+  }
+}
+
+static double wall_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static bool run(const char *name, mode_t_ mode) {
+  static test_t t;
+  memset(&t, 0, sizeof(t));
+  t.mode = mode;
+  spsc_init(&t.queue, queue_storage, sizeof(item_t), 16);
+  spsc_latest_init(&t.mailbox, mailbox_storage, sizeof(item_t));
+
+  pthread_t threads[2];
+  double start = wall_seconds();
+  pthread_create(&threads[0], NULL, consumer, &t);
+  pthread_create(&threads[1], NULL, producer, &t);
+  pthread_join(threads[1], NULL);
+  pthread_join(threads[0], NULL);
+  double elapsed = wall_seconds() - start;
+
+  bool ok = !t.torn && !t.out_of_order && t.last == ITEMS && (mode != MODE_QUEUE || (!t.lost && t.received == ITEMS));
+  printf("%-14s %9lu recebidos %8lu rasgados %8lu fora de ordem %8lu perdidos, último %u, %.0f ns/item  %s\n", name,
+         t.received, t.torn, t.out_of_order, t.lost, t.last, elapsed * 1e9 / ITEMS, ok ? "ok" : "ERRO");
+  return ok;
+}
+
+// Sem threads: a caixa entrega só o mais recente e só uma vez
+static bool mailbox_basics(void) {
+  spsc_latest_t m;
+  item_t it;
+  spsc_latest_init(&m, mailbox_storage, sizeof(item_t));
+  bool ok = !spsc_latest_take(&m, &it);
+  for (uint32_t seq = 1; seq <= 5; ++seq) {
+    fill_item(&it, seq);
+    spsc_latest_publish(&m, &it);
+  }
+  ok = ok && spsc_latest_take(&m, &it) && it.seq == 5 && item_whole(&it) && !spsc_latest_take(&m, &it);
+  fill_item(&it, 6);
+  spsc_latest_publish(&m, &it);
+  ok = ok && spsc_latest_take(&m, &it) && it.seq == 6;
+  printf("caixa sem threads: %s\n", ok ? "ok" : "ERRO");
+  return ok;
+}
+
+int main(void) {
+  printf("bench_spsc: %u itens de %zu bytes por teste, duas threads\n", ITEMS, sizeof(item_t));
+  bool ok = mailbox_basics();
+  ok = run("fila", MODE_QUEUE) && ok;
+  ok = run("fila, latest", MODE_QUEUE_LATEST) && ok;
+  ok = run("caixa", MODE_MAILBOX) && ok;
+  return ok ? 0 : 1;
+}
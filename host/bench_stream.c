@@ -0,0 +1,258 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "host_hal.h"
+#include "jogo.h"
+#include "libs/fbstream/fbstream.h"
+
+// Modo espectador no host: desenha o jogo com o joystick roteirizado, passa
+// cada quadro pelo codificador (diferença XOR + RLE) e decodifica o fluxo
+// como o fbview faria, com texto misturado entre os pacotes (printf no mesmo
+// stdio), um byte corrompido e um visualizador que entra no meio. Confere
+// que todo quadro decodificado é igual ao desenhado e informa bytes por
+// quadro, a razão de compressão e se cabe numa UART de 115200 baud a 60Hz.
+// Antes, o pior caso do RLE: listras de 1 pixel (bytes alternando com
+// zeros), que comprimidas cresceriam 1,5x; os pacotes têm de caber em
+// FBSTREAM_PACKET_MAX e decodificar iguais.
+
+#define MAX_FRAMES 4000
+#define MAX_STREAM (MAX_FRAMES * 256 + (1u << 20))
+#define UART_BYTES_PER_S 11520                    // 115200 baud, 10 bits por byte
+#define FPS 60
+
+typedef struct {
+  unsigned frames;
+  unsigned balls;
+  const char *output;
+} bench_opts_t;
+
+static uint8_t expected[MAX_FRAMES][FBSTREAM_MAX_BYTES];  // Quadro desenhado, na ordem da GRAM
+static uint8_t stream[MAX_STREAM];
+static size_t stream_len;
+static size_t frame_offset[MAX_FRAMES];
+static fbstream_t encoder;
+static fbstream_decoder_t decoder;
+
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "uso: %s [-n quadros] [-b bolas] [-o captura.bin]\n"
+          "  -n  quadros desenhados (padrão 3000, máximo %u)\n"
+          "  -b  bolas em jogo (1 a %u; padrão 1)\n"
+          "  -o  grava o fluxo, com o texto misturado, para o fbview\n",
+          prog, MAX_FRAMES, PHYS_BALLS_MAX);
+}
+
+static bool parse_args(int argc, char **argv, bench_opts_t *o) {
+  o->frames = 3000;
+  o->balls = 1;
+  o->output = NULL;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "-n") && i + 1 < argc)
+      o->frames = strtoul(argv[++i], NULL, 0);
+    else if (!strcmp(argv[i], "-b") && i + 1 < argc)
+      o->balls = strtoul(argv[++i], NULL, 0);
+    else if (!strcmp(argv[i], "-o") && i + 1 < argc)
+      o->output = argv[++i];
+    else
+      return false;
+  }
+  return o->frames && o->frames <= MAX_FRAMES && o->balls && o->balls <= PHYS_BALLS_MAX;
+}
+
+static double wall_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint32_t lcg(uint32_t *state) {
+  *state = *state * 1664525u + 1013904223u;
+  return *state >> 16;
+}
+
+// Mesmo jogador roteirizado do bench_pingpong
+static uint16_t script_joystick(const struct EstadoJogo *estado, uint32_t *rng) {
+  int curso = ALTURA - ALTURA_RAQUETE;
+  int alvo = estado->bola_y - ALTURA_RAQUETE / 2 + (int)(lcg(rng) % 13) - 6;
+  if (alvo < 0) alvo = 0;
+  if (alvo > curso) alvo = curso;
+  int adc = (curso - alvo) * 4096 / curso;
+  return adc > 4095 ? 4095 : adc;
+}
+
+static void append(const uint8_t *data, size_t len) {
+  if (stream_len + len <= MAX_STREAM) {
+    memcpy(&stream[stream_len], data, len);
+    stream_len += len;
+  }
+}
+
+static void write_stream(void *ctx, const uint8_t *data, size_t len) {
+  (void)ctx;
+  append(data, len);
+}
+
+typedef struct {
+  fbstream_decoder_t decoder;
+  size_t max_packet;
+  unsigned frames;
+} worst_sink_t;
+
+static void write_worst(void *ctx, const uint8_t *data, size_t len) {
+  worst_sink_t *sink = ctx;
+  if (len > sink->max_packet)
+    sink->max_packet = len;
+  for (size_t i = 0; i < len; ++i)
+    sink->frames += fbstream_decoder_push(&sink->decoder, data[i]);
+}
+
+// Listras verticais e xadrez de 1 pixel, alternando com a tela vazia e
+// entre si: quadros inteiros e diferenças que o RLE não encolhe
+static bool check_worst_case(unsigned width, unsigned pages) {
+  static fbstream_t worst;
+  static worst_sink_t sink;
+  static uint8_t columns[FBSTREAM_MAX_BYTES];
+  static const uint8_t patterns[][2] = { { 0xFF, 0x00 }, { 0x00, 0x00 }, { 0xFF, 0x00 }, { 0x00, 0xFF },
+                                         { 0x55, 0xAA }, { 0x00, 0x00 }, { 0xAA, 0x00 }, { 0x01, 0x00 } };
+  const unsigned count = sizeof(patterns) / sizeof(patterns[0]);
+  unsigned mismatches = 0;
+
+  memset(&sink, 0, sizeof(sink));
+  fbstream_decoder_init(&sink.decoder);
+  fbstream_init(&worst, width, pages, write_worst, &sink);
+  for (unsigned frame = 0; frame < 4 * count; ++frame) {
+    const uint8_t *pattern = patterns[frame % count];
+    for (unsigned x = 0; x < width; ++x)
+      for (unsigned page = 0; page < pages; ++page)
+        columns[x * pages + page] = pattern[x & 1];
+    unsigned decoded = sink.frames;
+    fbstream_frame(&worst, columns, frame);
+    if (sink.frames != decoded + 1) {
+      mismatches++;
+      continue;
+    }
+    for (unsigned x = 0; x < width; ++x)
+      for (unsigned page = 0; page < pages; ++page)
+        mismatches += sink.decoder.frame[page * width + x] != columns[x * pages + page];
+  }
+  bool ok = !mismatches && sink.max_packet <= FBSTREAM_PACKET_MAX;
+  printf("pior caso %ux%u: %u quadros, maior pacote %zu bytes (máximo %u), %u divergências  %s\n", width, pages * 8,
+         4 * count, sink.max_packet, FBSTREAM_PACKET_MAX, mismatches, ok ? "ok" : "ERRO");
+  return ok;
+}
+
+int main(int argc, char **argv) {
+  bench_opts_t opts;
+  if (!parse_args(argc, argv, &opts)) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  bool worst_ok = check_worst_case(128, 8);
+  worst_ok = check_worst_case(100, 3) && worst_ok;
+
+  static ssd1306_emu_t emu;
+  static ssd1306_t disp;
+  hal_reset();
+  ssd1306_emu_reset(&emu);
+  i2c_init(i2c1, 400000);
+  hal_i2c_attach(i2c1, 0x3C, &emu);
+  input_init(&configuracao_joystick);
+  ssd1306_init(&disp, LARGURA, ALTURA, false, 0x3C, i2c1);
+  fbstream_init(&encoder, disp.width, disp.pages, write_stream, NULL);
+
+  struct EstadoJogo estado;
+  if (opts.balls > 1)
+    inicializar_multibola(&estado, opts.balls);
+  else
+    inicializar_jogo(&estado);
+  uint32_t rng = 1;
+  const unsigned corrupt_frame = opts.frames / 2;
+  double encode_s = 0;
+  uint64_t key_bytes = 0, delta_bytes = 0;
+
+  for (unsigned frame = 0; frame < opts.frames; ++frame) {
+    hal_adc_set(1, script_joystick(&estado, &rng));
+    ler_joystick(&estado);
+    atualizar_ia(&estado);
+    atualizar_bola(&estado);
+    desenhar_jogo(&disp, &estado);
+    for (unsigned page = 0; page < disp.pages; ++page)
+      for (unsigned x = 0; x < disp.width; ++x)
+        expected[frame][page * disp.width + x] = disp.ram_buffer[1 + x * disp.pages + page];
+
+    if (frame % 97 == 0) {
+      char text[64];                              // Resposta de um comando no meio do fluxo
+      int len = snprintf(text, sizeof(text), "quadros: %u, FB no texto\n", frame);
+      append((const uint8_t *)text, len);
+    }
+    frame_offset[frame] = stream_len;
+    uint32_t keys = encoder.stats.keyframes;
+    double start = wall_seconds();
+    size_t size = fbstream_frame(&encoder, disp.ram_buffer + 1, frame * 1000 / FPS);
+    encode_s += wall_seconds() - start;
+    if (encoder.stats.keyframes != keys)
+      key_bytes += size;
+    else
+      delta_bytes += size;
+    if (frame == corrupt_frame)
+      stream[stream_len - 3] ^= 0x10;             // Um bit trocado nos dados do pacote
+  }
+
+  // Visualizador que entra no meio de um pacote do quadro 10
+  unsigned decoded = 0, mismatches = 0;
+  double decode_start = wall_seconds();
+  fbstream_decoder_init(&decoder);
+  for (size_t i = frame_offset[10] + 5; i < stream_len; ++i) {
+    if (!fbstream_decoder_push(&decoder, stream[i]))
+      continue;
+    unsigned frame = decoder.sequence;            // MAX_FRAMES cabe nos 16 bits da sequência
+    decoded++;
+    if (frame >= opts.frames || decoder.time_ms != (uint16_t)(frame * 1000 / FPS) ||
+        memcmp(decoder.frame, expected[frame], (size_t)disp.width * disp.pages))
+      mismatches++;
+  }
+  double decode_s = wall_seconds() - decode_start;
+
+  const fbstream_stats_t *e = &encoder.stats;
+  const fbstream_decoder_stats_t *d = &decoder.stats;
+  unsigned deltas = e->frames - e->keyframes;
+  double per_frame = (double)e->sent_bytes / e->frames;
+  printf("bench_stream: %u quadros de %ux%u, %u bola(s)\n", e->frames, disp.width, disp.height, opts.balls);
+  printf("codificador: %.1f bytes/quadro (inteiros %.1f, diferenças %.1f, máximo %lu), %.1f:1, %.2f us/quadro\n",
+         per_frame, (double)key_bytes / e->keyframes, deltas ? (double)delta_bytes / deltas : 0.0,
+         (unsigned long)e->max_packet, (double)e->raw_bytes / e->sent_bytes, encode_s * 1e6 / e->frames);
+  printf("a %uHz: %.0f bytes/s, %.0f%% de uma UART a 115200 baud (quadro cru: %.0f%%)\n", FPS, per_frame * FPS,
+         100.0 * per_frame * FPS / UART_BYTES_PER_S, 100.0 * (disp.width * disp.pages + FBSTREAM_HEADER + 2) * FPS /
+         UART_BYTES_PER_S);
+  printf("decodificador: %u quadros (%lu inteiros), %lu pacotes ruins, %lu diferenças perdidas, %lu bytes fora de "
+         "pacotes, %.2f us/quadro, %u divergências\n",
+         decoded, (unsigned long)d->keyframes, (unsigned long)d->bad_packets, (unsigned long)d->lost,
+         (unsigned long)d->skipped_bytes, decode_s * 1e6 / (decoded ? decoded : 1), mismatches);
+  ssd1306_deinit(&disp);
+
+  if (opts.output) {
+    FILE *out = fopen(opts.output, "wb");
+    if (!out) {
+      perror(opts.output);
+      return 1;
+    }
+    fwrite(stream, 1, stream_len, out);
+    fclose(out);
+    printf("fluxo em %s (fbview -p quadro %s)\n", opts.output, opts.output);
+  }
+
+  // Perdem-se só o começo (até o primeiro quadro inteiro) e o trecho entre o
+  // pacote corrompido e o quadro inteiro seguinte
+  unsigned expected_min = opts.frames - 10 - 2 * FBSTREAM_KEY_INTERVAL;
+  if (!worst_ok)
+    return 1;
+  if (mismatches || decoded < expected_min || (opts.frames > corrupt_frame + FBSTREAM_KEY_INTERVAL && !d->lost)) {
+    printf("ERRO: %u divergências, %u quadros decodificados (mínimo %u)\n", mismatches, decoded, expected_min);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,115 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "host_hal.h"
+#include "jogo.h"
+
+// Troca de buffers sem rasgo: envia quadros por DMA (ssd1306_send_data_async)
+// e, enquanto cada envio está em andamento, rabisca o ram_buffer (o buffer
+// de trás) com bytes que não pertencem a nenhum quadro. A HAL entrega o DMA
+// byte a byte conforme o relógio virtual anda; depois de cada passo, todo
+// byte da GRAM do painel tem de ser do quadro anterior ou do quadro em
+// trânsito, e ao fim do envio a GRAM tem de ser exatamente o quadro enviado.
+// Metade dos quadros vai inteira e metade em janelas sujas.
+
+#define FRAMES 200
+#define SCRIBBLE 0xA5                             // Marca dos rabiscos (os quadros não usam este byte)
+
+static ssd1306_emu_t panel;
+static ssd1306_t disp;
+static uint8_t previous[SSD1306_EMU_PAGES][SSD1306_EMU_COLUMNS];
+static uint8_t current[SSD1306_EMU_PAGES][SSD1306_EMU_COLUMNS];
+
+static uint32_t lcg(uint32_t *state) {
+  *state = *state * 1664525u + 1013904223u;
+  return *state >> 16;
+}
+
+static uint8_t frame_byte(uint32_t *rng) {
+  uint8_t b = lcg(rng);
+  return b == SCRIBBLE ? 0 : b;
+}
+
+// Retângulos de bytes novos, com tamanho e posição aleatórios
+static void draw_frame(uint32_t *rng) {
+  unsigned rects = 1 + lcg(rng) % 4;
+  for (unsigned r = 0; r < rects; ++r) {
+    unsigned x0 = lcg(rng) % disp.width, w = 1 + lcg(rng) % 40;
+    unsigned p0 = lcg(rng) % disp.pages, h = 1 + lcg(rng) % 4;
+    for (unsigned x = x0; x < x0 + w && x < disp.width; ++x)
+      for (unsigned p = p0; p < p0 + h && p < disp.pages; ++p)
+        disp.ram_buffer[1 + x * disp.pages + p] = frame_byte(rng);
+  }
+  for (unsigned x = 0; x < disp.width; ++x)       // Apaga os rabiscos que o quadro não cobriu
+    for (unsigned p = 0; p < disp.pages; ++p)
+      if (disp.ram_buffer[1 + x * disp.pages + p] == SCRIBBLE)
+        disp.ram_buffer[1 + x * disp.pages + p] = frame_byte(rng);
+}
+
+static void snapshot_frame(uint8_t out[SSD1306_EMU_PAGES][SSD1306_EMU_COLUMNS]) {
+  for (unsigned x = 0; x < disp.width; ++x)
+    for (unsigned p = 0; p < disp.pages; ++p)
+      out[p][x] = disp.ram_buffer[1 + x * disp.pages + p];
+}
+
+// Bytes da GRAM que não são nem do quadro anterior nem do quadro em trânsito
+static unsigned torn_bytes(bool finished) {
+  unsigned torn = 0;
+  for (unsigned x = 0; x < disp.width; ++x)
+    for (unsigned p = 0; p < disp.pages; ++p) {
+      uint8_t b = ssd1306_emu_column_byte(&panel, x, p);
+      if (b != current[p][x] && (finished || b != previous[p][x]))
+        torn++;
+    }
+  return torn;
+}
+
+int main(void) {
+  hal_reset();
+  ssd1306_emu_reset(&panel);
+  i2c_init(i2c1, 400000);
+  hal_i2c_attach(i2c1, 0x3C, &panel);
+  ssd1306_init(&disp, LARGURA, ALTURA, false, 0x3C, i2c1);
+  ssd1306_config(&disp);
+  ssd1306_fill(&disp, false);
+  ssd1306_send_data(&disp);
+  snapshot_frame(current);
+
+  uint32_t rng = 1;
+  unsigned long steps = 0, scribbles = 0, torn = 0, torn_final = 0, overlapped = 0;
+  for (unsigned frame = 0; frame < FRAMES; ++frame) {
+    draw_frame(&rng);
+    memcpy(previous, current, sizeof(current));
+    snapshot_frame(current);
+    if (frame & 1)
+      ssd1306_invalidate(&disp);
+    ssd1306_send_data_async(&disp);
+
+    bool busy = ssd1306_is_busy(&disp);
+    overlapped += busy;
+    while (busy) {
+      for (unsigned i = 0; i < 16; ++i) {         // O próximo quadro sendo desenhado por cima
+        disp.ram_buffer[1 + lcg(&rng) % (disp.width * disp.pages)] = SCRIBBLE;
+        scribbles++;
+      }
+      hal_idle();
+      steps++;
+      torn += torn_bytes(false);
+      busy = ssd1306_is_busy(&disp);
+    }
+    torn_final += torn_bytes(true);
+  }
+  ssd1306_deinit(&disp);
+
+  printf("bench_tearing: %u quadros por DMA (%lu ainda em envio ao voltar), %lu passos de DMA, %lu bytes rabiscados "
+         "no buffer de trás durante os envios\n",
+         FRAMES, overlapped, steps, scribbles);
+  printf("bytes fora do quadro anterior ou do enviado: %lu durante os envios, %lu ao fim deles\n", torn, torn_final);
+  if (torn || torn_final || overlapped < FRAMES / 2 || !steps) {
+    printf("ERRO: o painel mostrou bytes que não são de um quadro inteiro\n");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,141 @@
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "host_hal.h"
+#include "transport_mock.h"
+#include "jogo.h"
+
+// Roda o jogo com o painel no I2C de 400 kHz (HAL simulada, DMA) e no
+// transporte simulado com o enquadramento do SPI por PIO a 10 MHz, com
+// envio assíncrono e bloqueante. Confere a GRAM contra o buffer e, no SPI,
+// que as palavras chegam bem formadas e em pares de segmentos comando/dados
+// (6 bytes de janela + dados). Mede o tempo virtual por quadro do jogo e o
+// de um quadro inteiro (limite de quadros/s do transporte).
+
+#define FRAMES 20000
+#define FULL_FRAMES 200
+
+typedef enum { BUS_I2C, BUS_SPI } bus_t;
+
+typedef struct {
+  double frame_us;
+  double full_us;
+  bool gram_ok;
+  bool framing_ok;
+} run_t;
+
+static ssd1306_emu_t emu;
+static ssd1306_t disp;
+static transport_mock_t mock;
+
+static uint32_t lcg(uint32_t *state) {
+  *state = *state * 1664525u + 1013904223u;
+  return *state >> 16;
+}
+
+static uint16_t script_joystick(const struct EstadoJogo *estado, uint32_t *rng) {
+  int curso = ALTURA - ALTURA_RAQUETE;
+  int alvo = estado->bola_y - ALTURA_RAQUETE / 2 + (int)(lcg(rng) % 13) - 6;
+  if (alvo < 0) alvo = 0;
+  if (alvo > curso) alvo = curso;
+  int adc = (curso - alvo) * 4096 / curso;
+  return adc > 4095 ? 4095 : adc;
+}
+
+static bool gram_matches(void) {
+  for (uint8_t x = 0; x < disp.width; ++x)
+    for (uint8_t page = 0; page < disp.pages; ++page)
+      if (ssd1306_emu_column_byte(&emu, x, page) != disp.ram_buffer[1 + x * disp.pages + page])
+        return false;
+  return true;
+}
+
+static void send(bool async) {
+  if (async)
+    ssd1306_send_data_async(&disp);
+  else
+    ssd1306_send_data(&disp);
+  ssd1306_wait(&disp);
+}
+
+static run_t run(bus_t bus, bool async) {
+  struct EstadoJogo estado;
+  uint32_t rng = 1;
+  run_t r = { 0 };
+
+  hal_reset();
+  input_init(&configuracao_joystick);
+  ssd1306_emu_reset(&emu);
+  i2c_init(i2c1, 400000);
+  hal_i2c_attach(i2c1, 0x3C, &emu);
+  ssd1306_init(&disp, LARGURA, ALTURA, false, 0x3C, i2c1);
+  if (bus == BUS_SPI) {
+    transport_mock_init(&mock, &emu, 10000000);
+    ssd1306_set_transport(&disp, &transport_mock, &mock);
+  }
+  ssd1306_config(&disp);
+  uint32_t config_bytes = mock.command_bytes;
+
+  inicializar_jogo(&estado);
+  uint64_t start = time_us_64();
+  r.gram_ok = true;
+  for (unsigned frame = 0; frame < FRAMES; ++frame) {
+    hal_adc_set(1, script_joystick(&estado, &rng));
+    ler_joystick(&estado);
+    atualizar_ia(&estado);
+    atualizar_bola(&estado);
+    desenhar_jogo(&disp, &estado);
+    send(async);
+    if (frame % 97 == 0)
+      r.gram_ok &= gram_matches();
+  }
+  r.frame_us = (double)(time_us_64() - start) / FRAMES;
+
+  start = time_us_64();
+  for (unsigned frame = 0; frame < FULL_FRAMES; ++frame) {
+    ssd1306_invalidate(&disp);
+    send(async);
+  }
+  r.full_us = (double)(time_us_64() - start) / FULL_FRAMES;
+  r.gram_ok &= gram_matches();
+
+  // Cada janela é um par de segmentos, 6 bytes de comando e os dados. Os
+  // comandos da configuração emendam com os da primeira janela (D/C# não
+  // muda entre eles), então o total de segmentos é par.
+  r.framing_ok = true;
+  if (bus == BUS_SPI) {
+    uint32_t windows = mock.segments / 2;
+    r.framing_ok = mock.framing_errors == 0 && mock.segments % 2 == 0 &&
+                   mock.command_bytes - config_bytes == 6 * windows;
+  }
+  ssd1306_deinit(&disp);
+  return r;
+}
+
+static void print_run(const char *name, run_t r) {
+  printf("%-24s %8.1f us/quadro  quadro inteiro %8.1f us (%6.0f quadros/s)  GRAM %s  enquadramento %s\n",
+         name, r.frame_us, r.full_us, 1e6 / r.full_us, r.gram_ok ? "ok" : "DIFERENTE",
+         r.framing_ok ? "ok" : "ERRO");
+}
+
+int main(void) {
+  run_t i2c_async = run(BUS_I2C, true);
+  run_t i2c_blocking = run(BUS_I2C, false);
+  run_t spi_async = run(BUS_SPI, true);
+  run_t spi_blocking = run(BUS_SPI, false);
+
+  print_run("I2C 400 kHz (DMA)", i2c_async);
+  print_run("I2C 400 kHz (bloqueante)", i2c_blocking);
+  print_run("SPI 10 MHz (DMA)", spi_async);
+  print_run("SPI 10 MHz (bloqueante)", spi_blocking);
+  printf("quadro inteiro: SPI %.1fx mais rápido que I2C\n", i2c_async.full_us / spi_async.full_us);
+
+  bool ok = i2c_async.gram_ok && i2c_blocking.gram_ok && spi_async.gram_ok && spi_blocking.gram_ok &&
+            spi_async.framing_ok && spi_blocking.framing_ok;
+  if (spi_async.full_us * 10 > i2c_async.full_us) {
+    printf("ERRO: o SPI deveria enviar o quadro inteiro ao menos 10x mais rápido\n");
+    ok = false;
+  }
+  return ok ? 0 : 1;
+}
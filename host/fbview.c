@@ -0,0 +1,219 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include "libs/fbstream/fbstream.h"
+
+// Visualizador do modo espectador (comando 'c' da placa ou bench_stream -o):
+// lê o fluxo de um arquivo gravado ou direto da porta serial, reconstrói os
+// quadros e mostra no terminal (dois pixels por caractere, com meio-bloco)
+// e/ou grava um PNG por quadro. O texto que a placa imprime no meio do fluxo
+// é ignorado. Ao fim, informa na saída de erro bytes por quadro e a razão de
+// compressão.
+//
+// uso: fbview [-t] [-p prefixo] [-c] entrada
+//   -t  mostra os quadros no terminal
+//   -p  grava prefixo00000.png, prefixo00001.png, ... (um GIF sai com
+//       ffmpeg -i prefixo%05d.png captura.gif)
+//   -c  entrada é a porta serial: envia 'c' para ligar a captura e de novo
+//       ao sair (Ctrl-C)
+
+static volatile sig_atomic_t stop;
+
+static void on_signal(int sig) {
+  (void)sig;
+  stop = 1;
+}
+
+static void usage(const char *prog) {
+  fprintf(stderr, "uso: %s [-t] [-p prefixo] [-c] entrada\n", prog);
+}
+
+// CRC-32 dos blocos PNG (polinômio refletido 0xEDB88320)
+static uint32_t crc32_update(uint32_t crc, const uint8_t *data, size_t len) {
+  crc = ~crc;
+  while (len--) {
+    crc ^= *data++;
+    for (int bit = 0; bit < 8; ++bit)
+      crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+  }
+  return ~crc;
+}
+
+static void put32be(uint8_t *out, uint32_t value) {
+  out[0] = value >> 24;
+  out[1] = value >> 16;
+  out[2] = value >> 8;
+  out[3] = value;
+}
+
+static void png_chunk(FILE *out, const char *type, const uint8_t *data, size_t len) {
+  uint8_t word[4];
+  put32be(word, len);
+  fwrite(word, 1, 4, out);
+  uint32_t crc = crc32_update(0, (const uint8_t *)type, 4);
+  crc = crc32_update(crc, data, len);
+  fwrite(type, 1, 4, out);
+  fwrite(data, 1, len, out);
+  put32be(word, crc);
+  fwrite(word, 1, 4, out);
+}
+
+// PNG de 1 bit em tons de cinza, com o zlib em blocos sem compressão (o
+// quadro tem 1 KB; não vale trazer um deflate)
+static bool write_png(const char *path, const fbstream_decoder_t *d) {
+  const unsigned width = d->width, height = d->pages * 8u, stride = (width + 7) / 8 + 1;
+  const size_t raw_len = (size_t)stride * height;
+  static uint8_t raw[FBSTREAM_MAX_BYTES * 2];
+  static uint8_t zlib[FBSTREAM_MAX_BYTES * 2 + 64];
+
+  memset(raw, 0, raw_len);
+  for (unsigned y = 0; y < height; ++y)
+    for (unsigned x = 0; x < width; ++x)
+      if (fbstream_pixel(d, x, y))
+        raw[y * stride + 1 + x / 8] |= 0x80 >> (x & 7);  // Filtro 0 no primeiro byte da linha
+
+  size_t z = 0;
+  uint32_t a = 1, b = 0;                                  // Adler-32
+  zlib[z++] = 0x78;
+  zlib[z++] = 0x01;
+  for (size_t done = 0; done < raw_len;) {
+    size_t block = raw_len - done > 65535 ? 65535 : raw_len - done;
+    zlib[z++] = done + block == raw_len;                  // BFINAL, tipo 00
+    zlib[z++] = block;
+    zlib[z++] = block >> 8;
+    zlib[z++] = ~block;
+    zlib[z++] = ~block >> 8;
+    memcpy(&zlib[z], &raw[done], block);
+    z += block;
+    done += block;
+  }
+  for (size_t i = 0; i < raw_len; ++i) {
+    a = (a + raw[i]) % 65521;
+    b = (b + a) % 65521;
+  }
+  put32be(&zlib[z], b << 16 | a);
+  z += 4;
+
+  FILE *out = fopen(path, "wb");
+  if (!out)
+    return false;
+  static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+  uint8_t header[13];
+  put32be(&header[0], width);
+  put32be(&header[4], height);
+  header[8] = 1;                                          // Bits por pixel
+  header[9] = 0;                                          // Tons de cinza
+  header[10] = header[11] = header[12] = 0;
+  fwrite(signature, 1, sizeof(signature), out);
+  png_chunk(out, "IHDR", header, sizeof(header));
+  png_chunk(out, "IDAT", zlib, z);
+  png_chunk(out, "IEND", NULL, 0);
+  return fclose(out) == 0;
+}
+
+static void show_terminal(const fbstream_decoder_t *d, size_t packet) {
+  static const char *const cells[4] = { " ", "▀", "▄", "█" };  // Cima, baixo
+  fputs("\x1b[H", stdout);
+  for (unsigned y = 0; y < d->pages * 8u; y += 2) {
+    for (unsigned x = 0; x < d->width; ++x)
+      fputs(cells[fbstream_pixel(d, x, y) | fbstream_pixel(d, x, y + 1) << 1], stdout);
+    fputc('\n', stdout);
+  }
+  printf("quadro %5u  %6.2f s  %c %4zu bytes\x1b[K\n", d->sequence, d->time_ms / 1000.0, d->keyframe ? 'K' : 'D',
+         packet);
+  fflush(stdout);
+}
+
+int main(int argc, char **argv) {
+  bool terminal = false, command = false;
+  const char *prefix = NULL, *input = NULL;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "-t"))
+      terminal = true;
+    else if (!strcmp(argv[i], "-c"))
+      command = true;
+    else if (!strcmp(argv[i], "-p") && i + 1 < argc)
+      prefix = argv[++i];
+    else if (argv[i][0] != '-' && !input)
+      input = argv[i];
+    else {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+  if (!input) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  int fd = open(input, command ? O_RDWR | O_NOCTTY : O_RDONLY);
+  if (fd < 0) {
+    perror(input);
+    return 1;
+  }
+  if (isatty(fd)) {
+    struct termios tio;
+    if (tcgetattr(fd, &tio) == 0) {
+      cfmakeraw(&tio);
+      tcsetattr(fd, TCSANOW, &tio);
+    }
+  }
+  struct sigaction sa = { .sa_handler = on_signal };      // Sem SA_RESTART: o read volta com EINTR
+  sigaction(SIGINT, &sa, NULL);
+  sigaction(SIGTERM, &sa, NULL);
+  if (command && write(fd, "c", 1) != 1)
+    perror(input);
+  if (terminal)
+    fputs("\x1b[2J", stdout);
+
+  static fbstream_decoder_t decoder;
+  fbstream_decoder_init(&decoder);
+  uint64_t last_bytes = 0;
+  unsigned written = 0;
+  uint8_t chunk[4096];
+  while (!stop) {
+    ssize_t n = read(fd, chunk, sizeof(chunk));
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      break;
+    for (ssize_t i = 0; i < n; ++i) {
+      if (!fbstream_decoder_push(&decoder, chunk[i]))
+        continue;
+      size_t packet = decoder.stats.packet_bytes - last_bytes;
+      last_bytes = decoder.stats.packet_bytes;
+      if (terminal)
+        show_terminal(&decoder, packet);
+      if (prefix) {
+        char path[4096];
+        snprintf(path, sizeof(path), "%s%05u.png", prefix, written);
+        if (!write_png(path, &decoder)) {
+          perror(path);
+          return 1;
+        }
+        written++;
+      }
+    }
+  }
+  if (command && write(fd, "c", 1) != 1)
+    perror(input);
+  close(fd);
+
+  const fbstream_decoder_stats_t *s = &decoder.stats;
+  size_t frame_bytes = (size_t)decoder.width * decoder.pages;
+  fprintf(stderr, "%u quadros (%u inteiros), %u pacotes ruins, %u diferenças perdidas, %llu bytes fora de pacotes\n",
+          s->frames, s->keyframes, s->bad_packets, s->lost, (unsigned long long)s->skipped_bytes);
+  if (s->frames)
+    fprintf(stderr, "%.1f bytes/quadro, %.1f:1 sobre %zu bytes por quadro cru\n",
+            (double)s->packet_bytes / s->frames, (double)s->frames * frame_bytes / s->packet_bytes, frame_bytes);
+  if (prefix)
+    fprintf(stderr, "%u PNG em %s*.png\n", written, prefix);
+  return 0;
+}
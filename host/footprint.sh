@@ -0,0 +1,48 @@
+#!/bin/sh
+# Relatório de ocupação de flash/RAM e do tamanho do código das rotinas
+# quentes do driver SSD1306, lado a lado para cada arquivo (objeto ou ELF).
+# No firmware, SIZE e NM apontam para as ferramentas arm-none-eabi.
+#
+#   footprint.sh ssd1306_dinamico.o ssd1306_fixo.o
+#   SIZE=arm-none-eabi-size NM=arm-none-eabi-nm footprint.sh ping-pong-RP2040.elf
+
+SIZE=${SIZE:-size}
+NM=${NM:-nm}
+
+# Nome curto do arquivo; objetos do CMake levam o nome do alvo (alvo.dir/...)
+label() {
+  case "$1" in
+    *.dir/*) target=${1%%.dir/*}; basename "$target" ;;
+    *) basename "$1" ;;
+  esac
+}
+
+HOT="ssd1306_pixel ssd1306_vspan ssd1306_hspan ssd1306_rect ssd1306_hline ssd1306_vline
+ssd1306_fill ssd1306_blit ssd1306_put_columns ssd1306_dirty_pages ssd1306_for_each_window
+ssd1306_queue_window ssd1306_copy_view"
+
+printf '%-28s %8s %8s %8s\n' "arquivo" "text" "data" "bss"
+for file in "$@"; do
+  "$SIZE" "$file" | awk -v name="$(label "$file")" \
+    'NR > 1 { printf "%-28s %8d %8d %8d\n", name, $1, $2, $3 }'
+done
+
+echo
+printf '%-28s' "rotina (bytes de código)"
+for file in "$@"; do
+  printf ' %16.16s' "$(label "$file")"
+done
+echo
+for sym in $HOT; do
+  printf '%-28s' "$sym"
+  for file in "$@"; do
+    hex=$("$NM" -S "$file" 2>/dev/null | awk -v sym="$sym" \
+      '$4 == sym && ($3 == "T" || $3 == "t") { print $2; exit }')
+    if [ -n "$hex" ]; then
+      printf ' %16d' "$((0x$hex))"
+    else
+      printf ' %16s' "inline"
+    fi
+  done
+  echo
+done
@@ -0,0 +1,293 @@
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "host_hal.h"
+
+// HAL simulada para o build em Linux. O relógio é virtual e só anda com
+// sleeps, esperas ativas e com o tempo de barramento das transferências,
+// calculado a partir do baudrate do I2C (9 bits por byte + START/STOP).
+
+#define HAL_NUM_GPIOS 30
+#define HAL_NUM_ADC_INPUTS 5
+#define HAL_I2C_TX_MAX 4096
+#define HAL_DREQ_I2C0_TX 32
+
+struct i2c_inst {
+  i2c_hw_t hw;
+  unsigned index;
+  unsigned baudrate;
+  uint8_t device_addr;
+  ssd1306_emu_t *device;
+  uint8_t tx[HAL_I2C_TX_MAX];
+  size_t tx_len;
+  hal_i2c_stats_t stats;
+};
+
+typedef struct {
+  bool claimed, busy;
+  dma_channel_config config;
+  volatile void *write_addr;
+  const volatile uint8_t *read_addr;
+  unsigned count, done;
+  double next_us;
+  i2c_inst_t *i2c;
+} hal_dma_channel_t;
+
+i2c_inst_t i2c0_inst = { .index = 0 };
+i2c_inst_t i2c1_inst = { .index = 1 };
+static i2c_inst_t *const i2c_instances[2] = { &i2c0_inst, &i2c1_inst };
+
+static double hal_clock_us;
+static uint16_t hal_adc_values[HAL_NUM_ADC_INPUTS];
+static unsigned hal_adc_input;
+static bool hal_gpio_levels[HAL_NUM_GPIOS];
+static hal_dma_channel_t hal_dma[NUM_DMA_CHANNELS];
+
+static void hal_dma_update(hal_dma_channel_t *ch);
+
+void hal_reset(void) {
+  hal_clock_us = 0;
+  for (unsigned i = 0; i < HAL_NUM_ADC_INPUTS; ++i)
+    hal_adc_values[i] = 2048;
+  hal_adc_input = 0;
+  memset(hal_gpio_levels, 0, sizeof(hal_gpio_levels));
+  memset(hal_dma, 0, sizeof(hal_dma));
+  for (unsigned i = 0; i < 2; ++i) {
+    i2c_instances[i]->baudrate = 100000;
+    i2c_instances[i]->tx_len = 0;
+    memset(&i2c_instances[i]->stats, 0, sizeof(hal_i2c_stats_t));
+  }
+}
+
+void hal_advance_us(double us) {
+  hal_clock_us += us;
+  for (unsigned i = 0; i < NUM_DMA_CHANNELS; ++i)
+    if (hal_dma[i].busy)
+      hal_dma_update(&hal_dma[i]);
+}
+
+// Espera ativa: pula direto para o próximo byte de um DMA em andamento,
+// ou avança 1 us se não houver nenhum
+void hal_idle(void) {
+  double step = -1;
+  for (unsigned i = 0; i < NUM_DMA_CHANNELS; ++i)
+    if (hal_dma[i].busy && (step < 0 || hal_dma[i].next_us - hal_clock_us < step))
+      step = hal_dma[i].next_us - hal_clock_us;
+  hal_advance_us(step < 0 ? 1 : step);
+}
+
+uint64_t time_us_64(void) {
+  return (uint64_t)hal_clock_us;
+}
+
+void sleep_us(uint64_t us) {
+  hal_advance_us(us);
+}
+
+void sleep_ms(uint32_t ms) {
+  hal_advance_us(ms * 1000.0);
+}
+
+void sleep_until(absolute_time_t t) {
+  if (t > hal_clock_us)
+    hal_advance_us(t - hal_clock_us);
+}
+
+bool stdio_init_all(void) {
+  return true;
+}
+
+int getchar_timeout_us(uint32_t timeout_us) {
+  hal_advance_us(timeout_us);
+  return PICO_ERROR_TIMEOUT;
+}
+
+void gpio_init(unsigned gpio) { hal_gpio_levels[gpio] = false; }
+void gpio_set_function(unsigned gpio, unsigned fn) { (void)gpio; (void)fn; }
+void gpio_set_dir(unsigned gpio, bool out) { (void)gpio; (void)out; }
+void gpio_pull_up(unsigned gpio) { hal_gpio_levels[gpio] = true; }
+void gpio_put(unsigned gpio, bool value) { hal_gpio_levels[gpio] = value; }
+bool gpio_get(unsigned gpio) { return hal_gpio_levels[gpio]; }
+
+void hal_gpio_set(unsigned gpio, bool value) {
+  hal_gpio_levels[gpio] = value;
+}
+
+void adc_init(void) {}
+void adc_gpio_init(unsigned gpio) { (void)gpio; }
+void adc_select_input(unsigned input) { hal_adc_input = input; }
+
+// Não avança o relógio: na placa quem lê o ADC é o DMA, não a CPU
+uint16_t adc_read(void) {
+  return hal_adc_values[hal_adc_input];
+}
+
+void hal_adc_set(unsigned input, uint16_t value) {
+  hal_adc_values[input] = value & 0x0FFF;
+}
+
+// ---------------------------------------------------------------------------
+// I2C
+
+static double hal_i2c_bit_us(const i2c_inst_t *i2c) {
+  return 1e6 / i2c->baudrate;
+}
+
+unsigned i2c_init(i2c_inst_t *i2c, unsigned baudrate) {
+  i2c->baudrate = baudrate;
+  i2c->hw.status = I2C_IC_STATUS_TFE_BITS;
+  return baudrate;
+}
+
+void hal_i2c_attach(i2c_inst_t *i2c, uint8_t addr, ssd1306_emu_t *device) {
+  i2c->device_addr = addr;
+  i2c->device = device;
+}
+
+hal_i2c_stats_t hal_i2c_stats(i2c_inst_t *i2c) {
+  return i2c->stats;
+}
+
+void hal_i2c_reset_stats(i2c_inst_t *i2c) {
+  memset(&i2c->stats, 0, sizeof(i2c->stats));
+}
+
+// Custo em bits de uma transação: START, endereço, bytes (9 bits cada) e STOP
+static double hal_i2c_transaction_bits(size_t len) {
+  return 2 + 9.0 * (len + 1);
+}
+
+static void hal_i2c_finish(i2c_inst_t *i2c, uint8_t addr, const uint8_t *data, size_t len) {
+  i2c->stats.transactions++;
+  i2c->stats.bytes += len + 1;
+  i2c->stats.busy_us += hal_i2c_transaction_bits(len) * hal_i2c_bit_us(i2c);
+  if (!i2c->device || addr != i2c->device_addr) {
+    i2c->stats.nacks++;
+    return;
+  }
+  ssd1306_emu_transaction(i2c->device, data, len);
+}
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+  (void)nostop;
+  hal_i2c_finish(i2c, addr, src, len);
+  hal_advance_us(hal_i2c_transaction_bits(len) * hal_i2c_bit_us(i2c));
+  if (!i2c->device || addr != i2c->device_addr)
+    return PICO_ERROR_GENERIC;
+  return (int)len;
+}
+
+i2c_hw_t *i2c_get_hw(i2c_inst_t *i2c) {
+  return &i2c->hw;
+}
+
+unsigned i2c_get_dreq(i2c_inst_t *i2c, bool is_tx) {
+  return HAL_DREQ_I2C0_TX + i2c->index * 2 + (is_tx ? 0 : 1);
+}
+
+unsigned i2c_hw_index(i2c_inst_t *i2c) {
+  return i2c->index;
+}
+
+// ---------------------------------------------------------------------------
+// DMA. Transferências para IC_DATA_CMD são entregues ao barramento no ritmo
+// do I2C conforme o relógio virtual anda; as demais terminam na hora.
+
+int dma_claim_unused_channel(bool required) {
+  for (unsigned i = 0; i < NUM_DMA_CHANNELS; ++i) {
+    if (!hal_dma[i].claimed) {
+      hal_dma[i].claimed = true;
+      return (int)i;
+    }
+  }
+  (void)required;
+  return -1;
+}
+
+void dma_channel_unclaim(unsigned channel) {
+  hal_dma[channel].claimed = false;
+}
+
+dma_channel_config dma_channel_get_default_config(unsigned channel) {
+  (void)channel;
+  dma_channel_config c = { DMA_SIZE_32, true, false, 0x3F };
+  return c;
+}
+
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) { c->size = size; }
+void channel_config_set_read_increment(dma_channel_config *c, bool incr) { c->read_increment = incr; }
+void channel_config_set_write_increment(dma_channel_config *c, bool incr) { c->write_increment = incr; }
+void channel_config_set_dreq(dma_channel_config *c, unsigned dreq) { c->dreq = dreq; }
+
+static uint32_t hal_dma_read(const hal_dma_channel_t *ch, unsigned n) {
+  unsigned width = 1u << ch->config.size;
+  const volatile uint8_t *p = ch->read_addr + (ch->config.read_increment ? n * width : 0);
+  switch (ch->config.size) {
+    case DMA_SIZE_8: return *p;
+    case DMA_SIZE_16: return *(const volatile uint16_t *)p;
+    default: return *(const volatile uint32_t *)p;
+  }
+}
+
+static void hal_dma_update(hal_dma_channel_t *ch) {
+  i2c_inst_t *i2c = ch->i2c;
+  double bit_us = hal_i2c_bit_us(i2c);
+
+  while (ch->done < ch->count && ch->next_us <= hal_clock_us) {
+    uint32_t word = hal_dma_read(ch, ch->done++);
+    if (i2c->tx_len < HAL_I2C_TX_MAX)
+      i2c->tx[i2c->tx_len++] = word & 0xFF;
+    ch->next_us += 9 * bit_us;
+    if (word & I2C_IC_DATA_CMD_STOP_BITS) {
+      hal_i2c_finish(i2c, i2c->hw.tar, i2c->tx, i2c->tx_len);
+      i2c->tx_len = 0;
+      ch->next_us += 11 * bit_us;
+    }
+  }
+  if (ch->done == ch->count)
+    ch->busy = false;
+}
+
+void dma_channel_configure(unsigned channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, unsigned transfer_count, bool trigger) {
+  hal_dma_channel_t *ch = &hal_dma[channel];
+  ch->config = *config;
+  ch->write_addr = write_addr;
+  ch->read_addr = read_addr;
+  ch->count = transfer_count;
+  ch->done = 0;
+  ch->i2c = NULL;
+  for (unsigned i = 0; i < 2; ++i)
+    if (write_addr == &i2c_instances[i]->hw.data_cmd)
+      ch->i2c = i2c_instances[i];
+  if (!trigger)
+    return;
+
+  if (ch->i2c) {
+    ch->busy = true;
+    ch->next_us = hal_clock_us + 11 * hal_i2c_bit_us(ch->i2c);
+    hal_dma_update(ch);
+    return;
+  }
+
+  unsigned width = 1u << config->size;
+  for (unsigned n = 0; n < transfer_count; ++n) {
+    uint32_t word = hal_dma_read(ch, n);
+    volatile uint8_t *dst = (volatile uint8_t *)write_addr + (config->write_increment ? n * width : 0);
+    memcpy((void *)dst, &word, width);
+  }
+  ch->done = transfer_count;
+}
+
+bool dma_channel_is_busy(unsigned channel) {
+  if (hal_dma[channel].busy)
+    hal_dma_update(&hal_dma[channel]);
+  return hal_dma[channel].busy;
+}
+
+void dma_channel_wait_for_finish_blocking(unsigned channel) {
+  while (dma_channel_is_busy(channel))
+    hal_idle();
+}
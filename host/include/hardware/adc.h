@@ -0,0 +1,12 @@
+#ifndef HOST_HARDWARE_ADC_H
+#define HOST_HARDWARE_ADC_H
+
+#include "pico/stdlib.h"
+
+// Os valores lidos vêm de hal_adc_set (host/include/host_hal.h)
+void adc_init(void);
+void adc_gpio_init(unsigned gpio);
+void adc_select_input(unsigned input);
+uint16_t adc_read(void);
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef HOST_HARDWARE_I2C_H
+#define HOST_HARDWARE_I2C_H
+
+#include "pico/stdlib.h"
+
+#define I2C_IC_DATA_CMD_STOP_BITS 0x00000200u
+#define I2C_IC_DATA_CMD_RESTART_BITS 0x00000400u
+#define I2C_IC_STATUS_ACTIVITY_BITS 0x00000001u
+#define I2C_IC_STATUS_TFE_BITS 0x00000004u
+
+// Só os registradores usados pelo driver; as escritas em data_cmd chegam
+// pelo DMA simulado (host/hal.c)
+typedef struct {
+  volatile uint32_t enable;
+  volatile uint32_t tar;
+  volatile uint32_t data_cmd;
+  volatile uint32_t status;
+} i2c_hw_t;
+
+typedef struct i2c_inst i2c_inst_t;
+
+// Como no SDK, endereços constantes (usáveis em inicializadores estáticos)
+extern i2c_inst_t i2c0_inst;
+extern i2c_inst_t i2c1_inst;
+#define i2c0 (&i2c0_inst)
+#define i2c1 (&i2c1_inst)
+
+unsigned i2c_init(i2c_inst_t *i2c, unsigned baudrate);
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+i2c_hw_t *i2c_get_hw(i2c_inst_t *i2c);
+unsigned i2c_get_dreq(i2c_inst_t *i2c, bool is_tx);
+unsigned i2c_hw_index(i2c_inst_t *i2c);
+
+#endif
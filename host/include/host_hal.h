@@ -0,0 +1,27 @@
+#ifndef HOST_HAL_H
+#define HOST_HAL_H
+
+// Controles da HAL simulada, usados só pelos programas do host (bench etc.)
+
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "../ssd1306_emu.h"
+
+typedef struct {
+  uint32_t transactions;
+  uint32_t bytes;                                 // Inclui o byte de endereço de cada transação
+  uint32_t nacks;
+  double busy_us;                                 // Tempo de barramento ocupado
+} hal_i2c_stats_t;
+
+void hal_reset(void);
+void hal_advance_us(double us);
+
+void hal_adc_set(unsigned input, uint16_t value);
+void hal_gpio_set(unsigned gpio, bool value);
+
+void hal_i2c_attach(i2c_inst_t *i2c, uint8_t addr, ssd1306_emu_t *device);
+hal_i2c_stats_t hal_i2c_stats(i2c_inst_t *i2c);
+void hal_i2c_reset_stats(i2c_inst_t *i2c);
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef HOST_PICO_STDLIB_H
+#define HOST_PICO_STDLIB_H
+
+// Substituto do pico/stdlib.h para o build em Linux (PINGPONG_HOST). O tempo
+// é virtual: só avança com sleep_*, esperas ativas e transferências
+// simuladas, o que deixa as execuções reprodutíveis.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef PICO_ON_DEVICE
+#define PICO_ON_DEVICE 0
+#endif
+
+#define PICO_OK 0
+#define PICO_ERROR_TIMEOUT -1
+#define PICO_ERROR_GENERIC -2
+
+#define GPIO_FUNC_SPI 1
+#define GPIO_FUNC_UART 2
+#define GPIO_FUNC_I2C 3
+#define GPIO_FUNC_SIO 5
+
+#define GPIO_IN false
+#define GPIO_OUT true
+
+#define __not_in_flash_func(func) func
+
+typedef uint64_t absolute_time_t;
+
+uint64_t time_us_64(void);
+void hal_idle(void);
+
+static inline uint32_t time_us_32(void) { return (uint32_t)time_us_64(); }
+static inline absolute_time_t get_absolute_time(void) { return time_us_64(); }
+static inline uint64_t to_us_since_boot(absolute_time_t t) { return t; }
+static inline absolute_time_t from_us_since_boot(uint64_t us) { return us; }
+static inline absolute_time_t delayed_by_us(absolute_time_t t, uint64_t us) { return t + us; }
+static inline absolute_time_t make_timeout_time_us(uint64_t us) { return time_us_64() + us; }
+static inline absolute_time_t make_timeout_time_ms(uint32_t ms) { return time_us_64() + ms * 1000ull; }
+
+// Esperas ativas avançam o relógio virtual para não travar o host
+static inline void tight_loop_contents(void) { hal_idle(); }
+static inline void __wfi(void) { hal_idle(); }
+static inline void __wfe(void) { hal_idle(); }
+static inline void __sev(void) {}
+static inline void __dmb(void) {}
+
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+void sleep_until(absolute_time_t t);
+
+bool stdio_init_all(void);
+int getchar_timeout_us(uint32_t timeout_us);
+
+void gpio_init(unsigned gpio);
+void gpio_set_function(unsigned gpio, unsigned fn);
+void gpio_set_dir(unsigned gpio, bool out);
+void gpio_pull_up(unsigned gpio);
+void gpio_put(unsigned gpio, bool value);
+bool gpio_get(unsigned gpio);
+
+#endif
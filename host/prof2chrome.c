@@ -0,0 +1,179 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Converte a exportação do perfil por zonas (comando 'p' da placa ou
+// bench_profiler) no formato JSON de trace do Chrome, para ver como flame
+// chart em chrome://tracing ou no Perfetto. A entrada pode ter texto antes e
+// depois (captura crua do terminal USB): a busca começa em "PPRF". Imprime
+// também, na saída de erro, o total por zona.
+//
+// uso: prof2chrome perfil.bin [perfil.json]
+
+#define MAX_ZONES 128
+#define MAX_DEPTH 64
+#define CYCLE_MASK 0x00FFFFFFu
+#define ZONE_SHIFT 24
+#define END_BIT 0x80000000u
+
+typedef struct {
+  char name[256];
+  uint32_t count;
+  double total_us, max_us;
+} zone_t;
+
+typedef struct {
+  uint8_t zone;
+  double start;
+} open_zone_t;
+
+static zone_t zones[MAX_ZONES];
+static unsigned zone_count;
+
+static uint32_t get32(const uint8_t *in) {
+  return in[0] | in[1] << 8 | in[2] << 16 | (uint32_t)in[3] << 24;
+}
+
+static uint8_t *read_file(const char *path, size_t *len) {
+  FILE *in = fopen(path, "rb");
+  if (!in)
+    return NULL;
+  size_t capacity = 1 << 16;
+  uint8_t *data = malloc(capacity);
+  *len = 0;
+  size_t n;
+  while (data && (n = fread(data + *len, 1, capacity - *len, in)) > 0) {
+    *len += n;
+    if (*len == capacity)
+      data = realloc(data, capacity *= 2);
+  }
+  fclose(in);
+  return data;
+}
+
+static void emit(FILE *out, bool *first, const char *name, char phase, double ts, unsigned core) {
+  fprintf(out, "%s\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":0,\"tid\":%u}", *first ? "" : ",", name,
+          phase, ts, core);
+  *first = false;
+}
+
+static void close_zone(const open_zone_t *open, double ts) {
+  zone_t *z = &zones[open->zone];
+  double us = ts - open->start;
+  z->count++;
+  z->total_us += us;
+  if (us > z->max_us)
+    z->max_us = us;
+}
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    fprintf(stderr, "uso: %s perfil.bin [perfil.json]\n", argv[0]);
+    return 2;
+  }
+  size_t len;
+  uint8_t *data = read_file(argv[1], &len);
+  if (!data) {
+    perror(argv[1]);
+    return 1;
+  }
+
+  const uint8_t *p = NULL;
+  for (size_t i = 0; i + 12 <= len && !p; ++i)
+    if (!memcmp(data + i, "PPRF", 4))
+      p = data + i;
+  const uint8_t *end = data + len;
+  if (!p || p[4] != 1) {
+    fprintf(stderr, "%s: sem perfil (versão 1) na entrada\n", argv[1]);
+    return 1;
+  }
+  zone_count = p[5];
+  unsigned cores = p[6];
+  double hz = get32(p + 8);
+  double wrap_us = (CYCLE_MASK + 1.0) * 1e6 / hz;
+  p += 12;
+  for (unsigned z = 0; z < zone_count; ++z) {
+    if (p >= end || p + 1 + *p > end)
+      goto truncated;
+    memcpy(zones[z].name, p + 1, *p);
+    zones[z].name[*p] = 0;
+    p += 1 + *p;
+  }
+
+  FILE *out = argc > 2 ? fopen(argv[2], "w") : stdout;
+  if (!out) {
+    perror(argv[2]);
+    return 1;
+  }
+  bool first = true;
+  uint32_t total_events = 0;
+  fprintf(out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+  for (unsigned core = 0; core < cores; ++core) {
+    if (p + 4 > end)
+      goto truncated;
+    uint32_t count = get32(p);
+    p += 4;
+    if ((size_t)(end - p) < (size_t)count * 8)
+      goto truncated;
+
+    open_zone_t stack[MAX_DEPTH];
+    unsigned depth = 0;
+    uint32_t prev_us = 0, prev_cycles = 0;
+    double ts = 0;
+    for (uint32_t i = 0; i < count; ++i, p += 8) {
+      uint32_t time_us = get32(p), tag = get32(p + 4);
+      uint32_t cycles = tag & CYCLE_MASK;
+      unsigned zone = (tag >> ZONE_SHIFT) & 0x7F;
+      uint32_t du = time_us - prev_us;
+
+      // Entre eventos próximos, os ciclos do SysTick; depois de uma volta
+      // possível do SysTick, o timer de 1 us
+      if (i == 0)
+        ts = time_us;
+      else if (du < wrap_us / 2)
+        ts += ((cycles - prev_cycles) & CYCLE_MASK) * 1e6 / hz;
+      else
+        ts += du;
+      prev_us = time_us;
+      prev_cycles = cycles;
+      if (zone >= zone_count)
+        continue;
+
+      if (!(tag & END_BIT)) {
+        if (depth < MAX_DEPTH) {
+          stack[depth++] = (open_zone_t){ zone, ts };
+          emit(out, &first, zones[zone].name, 'B', ts, core);
+        }
+      } else if (depth && stack[depth - 1].zone == zone) {
+        close_zone(&stack[--depth], ts);
+        emit(out, &first, zones[zone].name, 'E', ts, core);
+      }
+      // Fim sem começo: o começo foi sobrescrito no anel
+    }
+    while (depth) {                         // Zonas ainda abertas no momento da exportação
+      close_zone(&stack[--depth], ts);
+      emit(out, &first, zones[stack[depth].zone].name, 'E', ts, core);
+    }
+    total_events += count;
+  }
+  fprintf(out, "\n]}\n");
+  if (out != stdout)
+    fclose(out);
+  if (p + 4 > end || memcmp(p, "FRPP", 4))
+    fprintf(stderr, "aviso: marcador de fim ausente\n");
+
+  fprintf(stderr, "%lu eventos, %u núcleos, ciclos a %.0f Hz\n", (unsigned long)total_events, cores, hz);
+  fprintf(stderr, "%-26s %8s %12s %10s %10s\n", "zona", "chamadas", "total (us)", "média", "máx");
+  for (unsigned z = 0; z < zone_count; ++z)
+    if (zones[z].count)
+      fprintf(stderr, "%-26s %8lu %12.1f %10.2f %10.2f\n", zones[z].name, (unsigned long)zones[z].count,
+              zones[z].total_us, zones[z].total_us / zones[z].count, zones[z].max_us);
+  free(data);
+  return 0;
+
+truncated:
+  fprintf(stderr, "%s: perfil truncado\n", argv[1]);
+  return 1;
+}
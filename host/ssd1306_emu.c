@@ -0,0 +1,113 @@
+#include <string.h>
+#include "ssd1306_emu.h"
+
+void ssd1306_emu_reset(ssd1306_emu_t *emu) {
+  memset(emu, 0, sizeof(*emu));
+  emu->col_end = SSD1306_EMU_COLUMNS - 1;
+  emu->page_end = SSD1306_EMU_PAGES - 1;
+  emu->mem_mode = 0x02;
+  emu->contrast = 0x7F;
+  emu->mux_ratio = 63;
+  emu->com_pins = 0x12;
+}
+
+// Número de bytes de argumento que seguem cada comando usado pelo driver
+static uint8_t ssd1306_emu_arg_count(uint8_t cmd) {
+  switch (cmd) {
+    case 0x21: case 0x22:
+      return 2;
+    case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+    case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+      return 1;
+    default:
+      return 0;
+  }
+}
+
+static void ssd1306_emu_command(ssd1306_emu_t *emu, uint8_t byte) {
+  emu->commands++;
+  if (emu->args_left) {
+    emu->args[emu->arg_index++] = byte;
+    if (--emu->args_left)
+      return;
+  } else {
+    emu->cmd = byte;
+    emu->arg_index = 0;
+    emu->args_left = ssd1306_emu_arg_count(byte);
+    if (emu->args_left)
+      return;
+  }
+
+  switch (emu->cmd) {
+    case 0x20: emu->mem_mode = emu->args[0] & 0x03; break;
+    case 0x21:
+      emu->col_start = emu->col = emu->args[0] & 0x7F;
+      emu->col_end = emu->args[1] & 0x7F;
+      break;
+    case 0x22:
+      emu->page_start = emu->page = emu->args[0] & 0x07;
+      emu->page_end = emu->args[1] & 0x07;
+      break;
+    case 0x81: emu->contrast = emu->args[0]; break;
+    case 0xA8: emu->mux_ratio = emu->args[0]; break;
+    case 0xDA: emu->com_pins = emu->args[0]; break;
+    case 0xAE: emu->display_on = false; break;
+    case 0xAF: emu->display_on = true; break;
+    default: break;
+  }
+}
+
+// Grava um byte na posição atual e avança conforme o modo de endereçamento
+static void ssd1306_emu_data(ssd1306_emu_t *emu, uint8_t byte) {
+  emu->data_bytes++;
+  emu->gram[emu->page][emu->col] = byte;
+
+  if (emu->mem_mode == 0x01) {
+    if (emu->page++ >= emu->page_end) {
+      emu->page = emu->page_start;
+      emu->col = (emu->col >= emu->col_end) ? emu->col_start : emu->col + 1;
+    }
+  } else if (emu->mem_mode == 0x00) {
+    if (emu->col++ >= emu->col_end) {
+      emu->col = emu->col_start;
+      emu->page = (emu->page >= emu->page_end) ? emu->page_start : emu->page + 1;
+    }
+  } else if (emu->col < SSD1306_EMU_COLUMNS - 1) {
+    emu->col++;
+  }
+}
+
+// Uma transação de escrita, já sem o byte de endereço. Com Co = 1 cada byte
+// de controle vale só para o byte seguinte; com Co = 0 vale para o resto da
+// transação.
+void ssd1306_emu_transaction(ssd1306_emu_t *emu, const uint8_t *data, size_t len) {
+  emu->transactions++;
+  emu->bytes += len + 1;
+
+  size_t i = 0;
+  while (i < len) {
+    uint8_t control = data[i++];
+    bool continuation = control & 0x80;
+    bool is_data = control & 0x40;
+    size_t end = continuation ? (i + 1 < len ? i + 1 : len) : len;
+    for (; i < end; ++i) {
+      if (is_data)
+        ssd1306_emu_data(emu, data[i]);
+      else
+        ssd1306_emu_command(emu, data[i]);
+    }
+  }
+}
+
+// Um byte da interface SPI de 4 fios: o nível de D/C# diz se é comando ou dado
+void ssd1306_emu_spi_byte(ssd1306_emu_t *emu, bool data, uint8_t byte) {
+  emu->bytes++;
+  if (data)
+    ssd1306_emu_data(emu, byte);
+  else
+    ssd1306_emu_command(emu, byte);
+}
+
+uint8_t ssd1306_emu_column_byte(const ssd1306_emu_t *emu, uint8_t col, uint8_t page) {
+  return emu->gram[page][col];
+}
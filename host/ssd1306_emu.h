@@ -0,0 +1,40 @@
+#ifndef SSD1306_EMU_H
+#define SSD1306_EMU_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Emulação do lado do controlador SSD1306: decodifica as transações I2C
+// (byte de controle Co/D#C, comandos com argumentos, dados) ou os bytes do
+// SPI de 4 fios (D/C# por byte) numa GRAM de
+// 128x8 páginas, respeitando a janela de colunas/páginas e o modo de
+// endereçamento.
+
+#define SSD1306_EMU_COLUMNS 128
+#define SSD1306_EMU_PAGES 8
+
+typedef struct {
+  uint8_t gram[SSD1306_EMU_PAGES][SSD1306_EMU_COLUMNS];
+  uint8_t col_start, col_end, page_start, page_end;
+  uint8_t col, page;
+  uint8_t mem_mode;
+  uint8_t contrast;
+  uint8_t mux_ratio;
+  uint8_t com_pins;
+  bool display_on;
+
+  uint8_t cmd, args_left, arg_index, args[2];
+
+  uint32_t transactions;
+  uint32_t bytes;
+  uint32_t data_bytes;
+  uint32_t commands;
+} ssd1306_emu_t;
+
+void ssd1306_emu_reset(ssd1306_emu_t *emu);
+void ssd1306_emu_transaction(ssd1306_emu_t *emu, const uint8_t *data, size_t len);
+void ssd1306_emu_spi_byte(ssd1306_emu_t *emu, bool data, uint8_t byte);
+uint8_t ssd1306_emu_column_byte(const ssd1306_emu_t *emu, uint8_t col, uint8_t page);
+
+#endif
@@ -0,0 +1,77 @@
+#include "transport_mock.h"
+#include "host_hal.h"
+#include "libs/ssd1306/ssd1306_spi.h"
+
+void transport_mock_init(transport_mock_t *mock, ssd1306_emu_t *device, uint32_t baud) {
+  *mock = (transport_mock_t){ .device = device, .baud = baud };
+}
+
+// Desfaz ssd1306_spi_word: bits ímpares são o byte, os pares repetem D/C#
+static void transport_mock_word(transport_mock_t *mock, uint16_t word) {
+  uint16_t dc = word & 0x5555;
+  uint16_t bits = (word >> 1) & 0x5555;
+  bool data = dc != 0;
+
+  if (dc != 0x0000 && dc != 0x5555)
+    mock->framing_errors++;
+  bits = (bits | bits >> 1) & 0x3333;
+  bits = (bits | bits >> 2) & 0x0F0F;
+  bits = (bits | bits >> 4) & 0x00FF;
+
+  if (!mock->words || data != mock->last_data)
+    mock->segments++;
+  mock->words++;
+  mock->last_data = data;
+  if (data)
+    mock->data_bytes++;
+  else
+    mock->command_bytes++;
+  if (mock->device)
+    ssd1306_emu_spi_byte(mock->device, data, (uint8_t)bits);
+}
+
+// 8 ciclos de SCK por byte, sem pausa entre bytes
+static double transport_mock_us(const transport_mock_t *mock, size_t bytes) {
+  return bytes * 8e6 / mock->baud;
+}
+
+static void transport_mock_write(ssd1306_t *ssd, const uint8_t *bytes, size_t count, bool command) {
+  transport_mock_t *mock = ssd->bus;
+  for (size_t i = 0; i < count; ++i)
+    transport_mock_word(mock, ssd1306_spi_word(bytes[i], command));
+  mock->busy_us += transport_mock_us(mock, count);
+  hal_advance_us(transport_mock_us(mock, count));
+}
+
+static void transport_mock_commands(ssd1306_t *ssd, const uint8_t *commands, size_t count) {
+  transport_mock_write(ssd, commands, count, true);
+}
+
+static void transport_mock_data(ssd1306_t *ssd, const uint8_t *buffer, size_t len) {
+  transport_mock_write(ssd, buffer + 1, len - 1, false);
+}
+
+// Os bytes chegam ao painel na hora; o transporte fica ocupado até quando o
+// último bit sairia
+static void transport_mock_start(ssd1306_t *ssd) {
+  transport_mock_t *mock = ssd->bus;
+  double us = transport_mock_us(mock, ssd->dma_len);
+  for (size_t i = 0; i < ssd->dma_len; ++i)
+    transport_mock_word(mock, ssd->dma_buffer[i]);
+  mock->busy_us += us;
+  mock->busy_until = time_us_64() + (uint64_t)(us + 0.999);
+}
+
+static bool transport_mock_busy(ssd1306_t *ssd) {
+  transport_mock_t *mock = ssd->bus;
+  return time_us_64() < mock->busy_until;
+}
+
+const ssd1306_transport_t transport_mock = {
+  .commands = transport_mock_commands,
+  .data = transport_mock_data,
+  .queue = ssd1306_spi_queue,
+  .start = transport_mock_start,
+  .busy = transport_mock_busy,
+  .segment_overhead = 0,
+};
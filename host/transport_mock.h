@@ -0,0 +1,28 @@
+#ifndef TRANSPORT_MOCK_H
+#define TRANSPORT_MOCK_H
+
+#include "libs/ssd1306/ssd1306.h"
+#include "ssd1306_emu.h"
+
+// Transporte simulado para o host: recebe as palavras no mesmo formato do
+// SPI por PIO (ssd1306_spi_word), confere o enquadramento de cada uma
+// (bits de D/C# iguais na palavra inteira), entrega os bytes ao painel
+// emulado e ocupa o relógio virtual pelo tempo que o SCK levaria.
+
+typedef struct {
+  ssd1306_emu_t *device;
+  uint32_t baud;
+  uint64_t busy_until;          // Fim do envio assíncrono em andamento
+  uint32_t words;
+  uint32_t segments;            // Trechos com o mesmo nível de D/C#
+  uint32_t command_bytes, data_bytes;
+  uint32_t framing_errors;
+  double busy_us;
+  bool last_data;
+} transport_mock_t;
+
+extern const ssd1306_transport_t transport_mock;
+
+void transport_mock_init(transport_mock_t *mock, ssd1306_emu_t *device, uint32_t baud);
+
+#endif
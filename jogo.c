@@ -0,0 +1,508 @@
+#include <stdio.h>                                                                                              // Biblioteca padrão de entrada/saída
+#include <string.h>                                                                                             // memcmp na comparação de cenas
+#include "pico/stdlib.h"                                                                                        // Biblioteca específica do Raspberry Pi Pico
+#include "jogo.h"                                                                                               // Estado e regras do jogo
+
+// Parâmetros da física da bola (ponto fixo Q16.16)
+static const phys_config_t fisica = {
+    .width = Q16_FROM_INT(LARGURA),                                                                             // Campo horizontal
+    .height = Q16_FROM_INT(ALTURA),                                                                             // Campo vertical
+    .speed_base = Q16_FROM_INT(VELOCIDADE_BOLA),                                                                // Velocidade no saque
+    .speed_step = ACRESCIMO_VELOCIDADE_BOLA,                                                                    // Aceleração por rebatida
+    .speed_max = Q16_FROM_INT(VELOCIDADE_MAXIMA_BOLA),                                                          // Teto de velocidade
+    .max_slope = INCLINACAO_MAXIMA_BOLA,                                                                        // Ângulo máximo na ponta da raquete
+};
+
+// Joystick: 16 kHz no total (8 kHz por eixo), média de 8 amostras e passa-baixas de 1/4 por amostra decimada
+const input_config_t configuracao_joystick = {
+    .select_gpio = JOYSTICK_SEL,
+    .sample_rate_hz = 16000,
+    .debounce_blocks = 3,                                                                                       // ~12 ms com blocos de 64 amostras
+    .axis = {
+        [INPUT_AXIS_X] = { .oversample_shift = 3, .smoothing_shift = 2, .deadzone = 64,
+                           .cal_min = 0, .cal_center = 2048, .cal_max = 4095 },
+        [INPUT_AXIS_Y] = { .oversample_shift = 3, .smoothing_shift = 2, .deadzone = 64,
+                           .cal_min = 0, .cal_center = 2048, .cal_max = 4095 },
+    },
+};
+
+static void reiniciar_rodada(struct EstadoJogo* estado, int direcao_x) {
+    estado->jogador_y = (ALTURA - ALTURA_RAQUETE) / 2;                                                          // Reposiciona raquete do jogador
+    estado->ia_y = (ALTURA - ALTURA_RAQUETE) / 2;                                                               // Reposiciona raquete da IA
+    ai_reset(&estado->ia, Q16_FROM_INT(estado->ia_y));                                                          // Descarta previsão da rodada anterior
+    phys_serve(&fisica, &estado->bola, direcao_x, 1);                                                           // Bola no centro, velocidade base, rali zerado
+    estado->bola_x = Q16_TO_INT(estado->bola.x);                                                                // Posição da bola em pixels
+    estado->bola_y = Q16_TO_INT(estado->bola.y);
+}
+
+void inicializar_jogo(struct EstadoJogo* estado) {
+    estado->bola.size = Q16_FROM_INT(TAMANHO_BOLA);                                                             // Lado da bola em ponto fixo
+    ai_init(&estado->ia, NIVEL_IA, false, 0, 1);                                                                // IA na raquete direita, semente fixa
+    reiniciar_rodada(estado, -1);                                                                               // Saque inicial para a esquerda
+    estado->direcao_ia = 0;                                                                                     // IA parada até a primeira previsão
+    estado->pontuacao_jogador = 0;                                                                              // Zera pontuação do jogador
+    estado->pontuacao_ia = 0;                                                                                   // Zera pontuação da IA
+    estado->bolas.count = 0;                                                                                    // Partida clássica, uma bola
+    estado->alvo_ia = 0;
+}
+
+// Partida com 2 a PHYS_BALLS_MAX bolas, cada uma sacada numa faixa, alternando lado e sentido vertical
+void inicializar_multibola(struct EstadoJogo* estado, unsigned bolas) {
+    inicializar_jogo(estado);
+    estado->bolas.size = Q16_FROM_INT(TAMANHO_BOLA);
+    estado->bolas.count = bolas;
+    for (unsigned i = 0; i < bolas; ++i) {
+        phys_balls_serve(&fisica, &estado->bolas, i, i & 1 ? 1 : -1, i & 2 ? 1 : -1);
+    }
+}
+
+// Nova partida no mesmo modo (clássico ou multibola)
+static void reiniciar_partida(struct EstadoJogo* estado) {
+    unsigned bolas = estado->bolas.count;
+    if (bolas) {
+        inicializar_multibola(estado, bolas);
+    } else {
+        inicializar_jogo(estado);
+    }
+}
+
+// Índice da bola que alcança primeiro a face da raquete do lado; sem nenhuma vindo, a 0
+static unsigned bola_mais_proxima(const phys_balls_t* bolas, bool esquerda) {
+    const q16_t face = esquerda ? Q16_FROM_INT(LARGURA_RAQUETE) : Q16_FROM_INT(LARGURA - LARGURA_RAQUETE) - bolas->size;
+    unsigned melhor = 0;
+    int64_t melhor_distancia = -1, melhor_velocidade = 1;
+
+    for (unsigned i = 0; i < bolas->count; ++i) {
+        q16_t velocidade = esquerda ? -bolas->vx[i] : bolas->vx[i];
+        q16_t distancia = esquerda ? bolas->x[i] - face : face - bolas->x[i];
+        if (velocidade <= 0 || distancia < 0) {
+            continue;                                                                                           // Afastando-se ou já atrás da face
+        }
+        if (melhor_distancia < 0 || distancia * melhor_velocidade < melhor_distancia * velocidade) {            // Menor distância/velocidade, sem divisão
+            melhor = i;
+            melhor_distancia = distancia;
+            melhor_velocidade = velocidade;
+        }
+    }
+    return melhor;
+}
+
+// Bola que a IA deve defender. Na multibola, a que chega primeiro; ao trocar de bola, a previsão em
+// cache (guardada pela velocidade da bola) deixa de valer.
+static const phys_ball_t* bola_alvo(struct EstadoJogo* estado, ai_t* ia, uint8_t* alvo, phys_ball_t* copia) {
+    if (!estado->bolas.count) {
+        return &estado->bola;
+    }
+    unsigned i = bola_mais_proxima(&estado->bolas, ia->left);
+    if (i != *alvo) {
+        *alvo = i;
+        ia->cached = false;
+    }
+    phys_balls_get(&estado->bolas, i, copia);
+    return copia;
+}
+
+// Eixo vertical calibrado (0-4095): último valor filtrado, sem esperar o ADC
+uint16_t valor_joystick(void) {
+    return input_latest().axis[INPUT_AXIS_Y];
+}
+
+// Lê o joystick e aplica ao estado; retorna o valor usado, que é a entrada gravada por tick
+uint16_t ler_joystick(struct EstadoJogo* estado) {
+    uint16_t valor = valor_joystick();
+    aplicar_joystick(estado, valor);
+    return valor;
+}
+
+static int posicao_raquete(uint16_t valor) {
+    return (ALTURA - ALTURA_RAQUETE) - (valor * (ALTURA - ALTURA_RAQUETE)) / 4096;                              // Mapeia valor para posição Y
+}
+
+void aplicar_joystick(struct EstadoJogo* estado, uint16_t valor) {
+    estado->jogador_y = posicao_raquete(valor);
+}
+
+// Raquete direita comandada pelo jogador da outra placa, no lugar da IA
+void aplicar_joystick_direita(struct EstadoJogo* estado, uint16_t valor) {
+    estado->ia_y = posicao_raquete(valor);
+}
+
+void atualizar_ia(struct EstadoJogo* estado) {
+    phys_box_t raquete = { Q16_FROM_INT(LARGURA - LARGURA_RAQUETE), estado->ia.y,
+                           Q16_FROM_INT(LARGURA_RAQUETE), Q16_FROM_INT(ALTURA_RAQUETE) };                       // Raquete da IA
+
+    phys_ball_t copia;
+
+    PROF_BEGIN(PROF_ATUALIZAR_IA);
+    const phys_ball_t* bola = bola_alvo(estado, &estado->ia, &estado->alvo_ia, &copia);
+    ai_update(&estado->ia, &fisica, bola, &raquete);                                                            // Persegue o ponto previsto de chegada da bola
+    estado->ia_y = Q16_TO_INT(estado->ia.y);                                                                    // Já limitada ao campo pela IA
+    estado->direcao_ia = estado->ia.direction;
+    PROF_END(PROF_ATUALIZAR_IA);
+}
+
+// Um tick da multibola: física em lote e, para cada bola que saiu, ponto e novo saque só dela
+static void atualizar_bolas(struct EstadoJogo* estado, const phys_box_t raquetes[PHYS_PADDLE_COUNT]) {
+    phys_balls_result_t resultado;
+    phys_balls_step(&fisica, &estado->bolas, raquetes, &resultado);
+
+    for (uint64_t saidas = resultado.out_left | resultado.out_right; saidas; saidas &= saidas - 1) {
+        unsigned i = __builtin_ctzll(saidas);
+        bool esquerda = (resultado.out_left >> i) & 1;
+        if (esquerda) {
+            estado->pontuacao_ia++;                                                                             // Passou pela raquete do jogador
+        } else {
+            estado->pontuacao_jogador++;
+        }
+        phys_balls_serve(&fisica, &estado->bolas, i, esquerda ? -1 : 1, i & 2 ? 1 : -1);                        // As outras bolas seguem em jogo
+    }
+}
+
+void atualizar_bola(struct EstadoJogo* estado) {
+    PROF_BEGIN(PROF_ATUALIZAR_BOLA);
+    phys_box_t raquetes[PHYS_PADDLE_COUNT] = {
+        { 0, Q16_FROM_INT(estado->jogador_y), Q16_FROM_INT(LARGURA_RAQUETE), Q16_FROM_INT(ALTURA_RAQUETE) },    // Raquete do jogador
+        { Q16_FROM_INT(LARGURA - LARGURA_RAQUETE), Q16_FROM_INT(estado->ia_y),
+          Q16_FROM_INT(LARGURA_RAQUETE), Q16_FROM_INT(ALTURA_RAQUETE) },                                        // Raquete da IA
+    };
+
+    if (estado->bolas.count) {
+        atualizar_bolas(estado, raquetes);
+        PROF_END(PROF_ATUALIZAR_BOLA);
+        return;
+    }
+
+    unsigned eventos = phys_step(&fisica, &estado->bola, raquetes);                                             // Movimento varrido com paredes e raquetes
+
+    if (eventos & PHYS_EVENT_OUT_LEFT) {                                                                        // Bola passou pela raquete esquerda
+        estado->pontuacao_ia++;                                                                                 // Incrementa pontuação da IA
+        reiniciar_rodada(estado, -1);
+    } else if (eventos & PHYS_EVENT_OUT_RIGHT) {                                                                // Bola passou pela raquete direita
+        estado->pontuacao_jogador++;                                                                            // Incrementa pontuação do jogador
+        reiniciar_rodada(estado, 1);
+    }
+
+    estado->bola_x = Q16_TO_INT(estado->bola.x);                                                                // Posição da bola em pixels para desenho e IA
+    estado->bola_y = Q16_TO_INT(estado->bola.y);
+    PROF_END(PROF_ATUALIZAR_BOLA);
+}
+
+// Um tick completo a partir de uma entrada gravada (passo de replay_run)
+void reproduzir_passo(void* estado, uint16_t valor_joystick) {
+    aplicar_joystick(estado, valor_joystick);
+    atualizar_ia(estado);
+    atualizar_bola(estado);
+}
+
+// Um tick da partida entre duas placas (passo de netplay_tick): entradas[0] é a raquete esquerda,
+// entradas[1] a direita. Sem IA, o estado só depende das entradas, igual nas duas placas.
+void passo_em_rede(void* estado, const uint16_t entradas[2]) {
+    aplicar_joystick(estado, entradas[0]);
+    aplicar_joystick_direita(estado, entradas[1]);
+    atualizar_bola(estado);
+}
+
+// Hash do estado campo a campo (sem bytes de preenchimento da struct), igual na placa e no host
+uint32_t hash_estado(const void* dados) {
+    const struct EstadoJogo* estado = dados;
+    const ai_t* ia = &estado->ia;
+    const int32_t campos[] = {
+        estado->jogador_y, estado->ia_y, estado->direcao_ia, estado->bola_x, estado->bola_y,
+        estado->bola.x, estado->bola.y, estado->bola.vx, estado->bola.vy, estado->bola.size, estado->bola.rally,
+        estado->pontuacao_jogador, estado->pontuacao_ia,
+        ia->level, ia->left, ia->y, ia->direction, ia->target, ia->pending_target, ia->delay, ia->cached,
+        ia->cached_vx, ia->cached_vy, ia->last_x, (int32_t)ia->seed, (int32_t)ia->predictions,
+    };
+    uint32_t hash = replay_hash_bytes(0, campos, sizeof(campos));
+
+    const phys_balls_t* bolas = &estado->bolas;
+    if (bolas->count) {                                                                                         // Partida clássica: mesmo hash de antes da multibola
+        const int32_t multibola[] = { bolas->count, bolas->size, estado->alvo_ia };
+        hash = replay_hash_bytes(hash, multibola, sizeof(multibola));
+        hash = replay_hash_bytes(hash, bolas->x, bolas->count * sizeof(q16_t));
+        hash = replay_hash_bytes(hash, bolas->y, bolas->count * sizeof(q16_t));
+        hash = replay_hash_bytes(hash, bolas->vx, bolas->count * sizeof(q16_t));
+        hash = replay_hash_bytes(hash, bolas->vy, bolas->count * sizeof(q16_t));
+        hash = replay_hash_bytes(hash, bolas->rally, bolas->count * sizeof(uint16_t));
+    }
+    return hash;
+}
+
+// Escrita e leitura little-endian do estado serializado
+static uint8_t* escrever(uint8_t* saida, uint32_t valor, unsigned bytes) {
+    for (unsigned i = 0; i < bytes; ++i)
+        *saida++ = valor >> (8 * i);
+    return saida;
+}
+
+static uint32_t ler(const uint8_t** entrada, unsigned bytes) {
+    uint32_t valor = 0;
+    for (unsigned i = 0; i < bytes; ++i)
+        valor |= (uint32_t)(*entrada)[i] << (8 * i);
+    *entrada += bytes;
+    return valor;
+}
+
+// Instantâneo portátil do estado: não depende do tamanho dos enums nem do preenchimento da struct, que
+// mudam entre o arm-none-eabi (enums curtos) e o host. Retorna o número de bytes escritos.
+size_t serializar_estado(const struct EstadoJogo* estado, uint8_t* saida) {
+    const ai_t* ia = &estado->ia;
+    const phys_balls_t* bolas = &estado->bolas;
+    const int32_t campos[] = {
+        estado->jogador_y, estado->ia_y, estado->direcao_ia, estado->bola_x, estado->bola_y,
+        estado->bola.x, estado->bola.y, estado->bola.vx, estado->bola.vy, estado->bola.size,
+        estado->pontuacao_jogador, estado->pontuacao_ia,
+    };
+    uint8_t* inicio = saida;
+
+    saida = escrever(saida, VERSAO_ESTADO, 1);
+    for (unsigned i = 0; i < sizeof(campos) / sizeof(campos[0]); ++i)
+        saida = escrever(saida, (uint32_t)campos[i], 4);
+    saida = escrever(saida, estado->bola.rally, 2);
+
+    saida = escrever(saida, ia->level, 1);                                                                      // IA: 40 bytes
+    saida = escrever(saida, ia->left, 1);
+    saida = escrever(saida, (uint32_t)ia->y, 4);
+    saida = escrever(saida, (uint32_t)ia->direction, 4);
+    saida = escrever(saida, (uint32_t)ia->target, 4);
+    saida = escrever(saida, (uint32_t)ia->pending_target, 4);
+    saida = escrever(saida, ia->delay, 1);
+    saida = escrever(saida, ia->cached, 1);
+    saida = escrever(saida, (uint32_t)ia->cached_vx, 4);
+    saida = escrever(saida, (uint32_t)ia->cached_vy, 4);
+    saida = escrever(saida, (uint32_t)ia->last_x, 4);
+    saida = escrever(saida, ia->seed, 4);
+    saida = escrever(saida, ia->predictions, 4);
+
+    saida = escrever(saida, bolas->count, 1);                                                                   // Multibola: 6 bytes e 18 por bola
+    saida = escrever(saida, (uint32_t)bolas->size, 4);
+    saida = escrever(saida, estado->alvo_ia, 1);
+    for (unsigned b = 0; b < bolas->count; ++b) {
+        saida = escrever(saida, (uint32_t)bolas->x[b], 4);
+        saida = escrever(saida, (uint32_t)bolas->y[b], 4);
+        saida = escrever(saida, (uint32_t)bolas->vx[b], 4);
+        saida = escrever(saida, (uint32_t)bolas->vy[b], 4);
+        saida = escrever(saida, bolas->rally[b], 2);
+    }
+    return saida - inicio;
+}
+
+// Recusa outra versão, um tamanho que não bate com o número de bolas ou um nível de IA inválido
+bool desserializar_estado(struct EstadoJogo* estado, const uint8_t* entrada, size_t tamanho) {
+    const size_t fixo = TAMANHO_ESTADO_SERIALIZADO - 18 * PHYS_BALLS_MAX;
+    if (tamanho < fixo || entrada[0] != VERSAO_ESTADO)
+        return false;
+    unsigned contagem = entrada[fixo - 6], nivel = entrada[1 + 12 * 4 + 2];                                     // Depois da versão, 12 campos e o rali
+    if (contagem > PHYS_BALLS_MAX || tamanho != fixo + 18 * contagem || nivel >= AI_LEVEL_COUNT)
+        return false;
+
+    struct EstadoJogo lido;
+    ai_t* ia = &lido.ia;
+    phys_balls_t* bolas = &lido.bolas;
+    memset(&lido, 0, sizeof(lido));
+    entrada++;
+    lido.jogador_y = (int32_t)ler(&entrada, 4);
+    lido.ia_y = (int32_t)ler(&entrada, 4);
+    lido.direcao_ia = (int32_t)ler(&entrada, 4);
+    lido.bola_x = (int32_t)ler(&entrada, 4);
+    lido.bola_y = (int32_t)ler(&entrada, 4);
+    lido.bola.x = (int32_t)ler(&entrada, 4);
+    lido.bola.y = (int32_t)ler(&entrada, 4);
+    lido.bola.vx = (int32_t)ler(&entrada, 4);
+    lido.bola.vy = (int32_t)ler(&entrada, 4);
+    lido.bola.size = (int32_t)ler(&entrada, 4);
+    lido.pontuacao_jogador = (int32_t)ler(&entrada, 4);
+    lido.pontuacao_ia = (int32_t)ler(&entrada, 4);
+    lido.bola.rally = ler(&entrada, 2);
+
+    ia->level = (ai_level_id_t)ler(&entrada, 1);
+    ia->left = ler(&entrada, 1);
+    ia->y = (int32_t)ler(&entrada, 4);
+    ia->direction = (int32_t)ler(&entrada, 4);
+    ia->target = (int32_t)ler(&entrada, 4);
+    ia->pending_target = (int32_t)ler(&entrada, 4);
+    ia->delay = ler(&entrada, 1);
+    ia->cached = ler(&entrada, 1);
+    ia->cached_vx = (int32_t)ler(&entrada, 4);
+    ia->cached_vy = (int32_t)ler(&entrada, 4);
+    ia->last_x = (int32_t)ler(&entrada, 4);
+    ia->seed = ler(&entrada, 4);
+    ia->predictions = ler(&entrada, 4);
+
+    bolas->count = ler(&entrada, 1);
+    bolas->size = (int32_t)ler(&entrada, 4);
+    lido.alvo_ia = ler(&entrada, 1);
+    for (unsigned b = 0; b < bolas->count; ++b) {
+        bolas->x[b] = (int32_t)ler(&entrada, 4);
+        bolas->y[b] = (int32_t)ler(&entrada, 4);
+        bolas->vx[b] = (int32_t)ler(&entrada, 4);
+        bolas->vy[b] = (int32_t)ler(&entrada, 4);
+        bolas->rally[b] = ler(&entrada, 2);
+    }
+    *estado = lido;
+    return true;
+}
+
+void iniciar_espera(struct Espera* espera, uint64_t agora_us, input_state_t entrada) {
+    espera->referencia = entrada;
+    espera->ultima_atividade_us = agora_us;
+    espera->ativa = false;
+}
+
+// Movimento de um eixo além do limiar desde a última atividade, ou o botão apertado
+bool joystick_mexeu(const struct Espera* espera, input_state_t entrada) {
+    for (int eixo = 0; eixo < INPUT_AXIS_COUNT; ++eixo) {
+        int variacao = (int)entrada.axis[eixo] - espera->referencia.axis[eixo];
+        if (variacao > LIMIAR_ATIVIDADE || variacao < -LIMIAR_ATIVIDADE) {
+            return true;
+        }
+    }
+    return entrada.select;
+}
+
+// Entra na demonstração depois de TEMPO_INATIVIDADE_US parado e sai no primeiro movimento, com uma
+// partida nova. Retorna true quando o modo muda (o chamador troca a cadência e o contraste).
+bool atualizar_espera(struct Espera* espera, struct EstadoJogo* estado, uint64_t agora_us, input_state_t entrada) {
+    if (joystick_mexeu(espera, entrada)) {
+        bool saiu = espera->ativa;
+        iniciar_espera(espera, agora_us, entrada);
+        if (saiu) {
+            reiniciar_partida(estado);                                                                          // Placar da demonstração não vale
+        }
+        return saiu;
+    }
+    if (!espera->ativa && agora_us - espera->ultima_atividade_us >= TEMPO_INATIVIDADE_US) {
+        espera->ativa = true;
+        ai_init(&espera->demo, NIVEL_IA, true, Q16_FROM_INT(estado->jogador_y), 7);                             // IA na raquete esquerda
+        espera->alvo_demo = 0;
+        return true;
+    }
+    return false;
+}
+
+// Um tick da demonstração: IA nas duas raquetes, sem ler o joystick
+void passo_demonstracao(struct EstadoJogo* estado, struct Espera* espera) {
+    if (Q16_TO_INT(espera->demo.y) != estado->jogador_y) {
+        ai_reset(&espera->demo, Q16_FROM_INT(estado->jogador_y));                                               // Raquete recentralizada por um ponto
+    }
+    phys_box_t raquete = { 0, espera->demo.y, Q16_FROM_INT(LARGURA_RAQUETE), Q16_FROM_INT(ALTURA_RAQUETE) };
+    phys_ball_t copia;
+    ai_update(&espera->demo, &fisica, bola_alvo(estado, &espera->demo, &espera->alvo_demo, &copia), &raquete);
+    estado->jogador_y = Q16_TO_INT(espera->demo.y);
+    atualizar_ia(estado);
+    atualizar_bola(estado);
+}
+
+// Mesma imagem na tela: só os campos que desenhar_jogo usa
+bool cena_igual(const struct EstadoJogo* a, const struct EstadoJogo* b) {
+    if (a->jogador_y != b->jogador_y || a->ia_y != b->ia_y || a->bola_x != b->bola_x || a->bola_y != b->bola_y ||
+        a->pontuacao_jogador != b->pontuacao_jogador || a->pontuacao_ia != b->pontuacao_ia ||
+        a->bolas.count != b->bolas.count) {
+        return false;
+    }
+    size_t bytes = a->bolas.count * sizeof(q16_t);                                                              // Posição fina: mais estrito que os pixels
+    return !memcmp(a->bolas.x, b->bolas.x, bytes) && !memcmp(a->bolas.y, b->bolas.y, bytes);
+}
+
+void iniciar_laco(struct Laco* laco, bool demonstracao, bool pausa, uint64_t agora_us, input_state_t entrada) {
+    iniciar_espera(&laco->espera, agora_us, entrada);
+    laco->demonstracao = demonstracao;
+    laco->pausa = pausa;
+    laco->pausado = false;
+    laco->botao = entrada.select;                                                                               // SEL ainda apertado desde a tela inicial não pausa
+}
+
+// Um tick: a partida (passo_partida faz entrada, IA, física e a gravação) ou, parado há muito tempo, a
+// demonstração. Pausado, o tick não roda nem é gravado, então a gravação continua reproduzível.
+void passo_jogo(struct Laco* laco, struct EstadoJogo* estado, void (*passo_partida)(struct EstadoJogo* estado)) {
+    if (laco->espera.ativa) {
+        passo_demonstracao(estado, &laco->espera);                                                              // IA nas duas raquetes, sem gravação
+    } else if (!laco->pausado) {
+        passo_partida(estado);
+    }
+}
+
+// Um aperto de SEL pausa ou retoma a partida; na demonstração, ele (ou qualquer movimento) volta ao jogo
+// com uma partida nova. Retorna true quando entra ou sai da demonstração (o chamador troca a cadência e
+// o contraste).
+bool verificar_espera(struct Laco* laco, struct EstadoJogo* estado, uint64_t agora_us, input_state_t entrada) {
+    bool apertou = entrada.select && !laco->botao;
+    laco->botao = entrada.select;
+    if (apertou && laco->pausa && !laco->espera.ativa) {
+        laco->pausado = !laco->pausado;
+    }
+    if (!laco->demonstracao || !atualizar_espera(&laco->espera, estado, agora_us, entrada)) {
+        return false;
+    }
+    laco->pausado = false;                                                                                      // A demonstração parte da cena pausada; a volta é uma partida nova
+    return true;
+}
+
+void iniciar_apresentacao(struct Apresentacao* apresentacao, bool pular_iguais) {
+    apresentacao->ha_desenhado = false;
+    apresentacao->pular_iguais = pular_iguais;
+    apresentacao->contraste = CONTRASTE_NORMAL;                                                                 // O de ssd1306_config
+}
+
+// Aplica o contraste pedido e diz se o quadro tem de ser desenhado e enviado. Com pular_iguais, uma cena
+// igual à do último enviado (placar e posições iguais) só conta como quadro igual na agenda: nem a
+// rasterização nem a varredura do envio rodam.
+bool apresentar_quadro(struct Apresentacao* apresentacao, const struct EstadoJogo* quadro, uint8_t contraste,
+                       ssd1306_t* paineis, unsigned num_paineis, sched_t* agenda) {
+    if (apresentacao->contraste != contraste) {
+        apresentacao->contraste = contraste;
+        for (unsigned i = 0; i < num_paineis; ++i) {
+            ssd1306_contrast(&paineis[i], contraste);                                                           // Espera o DMA do quadro anterior
+        }
+    }
+    if (apresentacao->pular_iguais && apresentacao->ha_desenhado && cena_igual(quadro, &apresentacao->desenhado)) {
+        sched_frame_unchanged(agenda);
+        return false;
+    }
+    apresentacao->desenhado = *quadro;
+    apresentacao->ha_desenhado = true;
+    return true;
+}
+
+void desenhar_tela_inicial(ssd1306_t* ssd) {
+    ssd1306_fill(ssd, false);                                                                                   // Limpa o buffer do display
+    
+    ssd1306_draw_string(ssd, "EMBARCATECH", (LARGURA/2) - 44, (ALTURA/2) - 10);                                 // Desenha texto centralizado
+    ssd1306_draw_string(ssd, "GAME", (LARGURA/2) - 16, (ALTURA/2) + 2);                                         // Desenha subtítulo
+}
+
+void desenhar_jogo(ssd1306_t* ssd, struct EstadoJogo* estado) {
+    PROF_BEGIN(PROF_DESENHAR_JOGO);
+    ssd1306_fill(ssd, false);                                                                                   // Limpa o buffer do display
+    
+    ssd1306_rect(ssd, estado->jogador_y, 0, LARGURA_RAQUETE, ALTURA_RAQUETE, true, true);                       // Desenha raquete do jogador
+    ssd1306_rect(ssd, estado->ia_y, LARGURA - LARGURA_RAQUETE, LARGURA_RAQUETE, ALTURA_RAQUETE, true, true);    // Desenha raquete da IA
+    
+    ssd1306_rect(ssd, 0, 0, LARGURA, ALTURA, true, false);                                                      // Desenha borda do campo
+
+    for (int x = 0; x < LARGURA; x += 8) {                                                                      // Desenha linha central tracejada
+        ssd1306_rect(ssd, x, ALTURA / 1 - 1, 3, 2, true, true); 
+    }
+
+    if (estado->bolas.count) {
+        for (unsigned i = 0; i < estado->bolas.count; ++i) {                                                    // Desenha as bolas da multibola
+            ssd1306_rect(ssd, Q16_TO_INT(estado->bolas.y[i]), Q16_TO_INT(estado->bolas.x[i]), TAMANHO_BOLA, TAMANHO_BOLA,
+                         true, true);
+        }
+    } else {
+        ssd1306_rect(ssd, estado->bola_y, estado->bola_x, TAMANHO_BOLA, TAMANHO_BOLA, true, true);              // Desenha bola
+    }
+    
+    // Placar pré-renderizado, refeito só quando algum ponto muda (desenhar_jogo roda só no núcleo de desenho)
+    static ssd1306_text_t placar;
+    static int placar_jogador = -1, placar_ia = -1;
+    if (estado->pontuacao_jogador != placar_jogador || estado->pontuacao_ia != placar_ia) {
+        char texto[16];                                                                                         // Buffer para texto do placar
+        snprintf(texto, sizeof(texto), "%d - %d", estado->pontuacao_jogador, estado->pontuacao_ia);             // Formata placar
+        ssd1306_text_render(&placar, texto, true);                                                              // Fonte proporcional
+        placar_jogador = estado->pontuacao_jogador;
+        placar_ia = estado->pontuacao_ia;
+    }
+    ssd1306_draw_text(ssd, &placar, LARGURA / 2 - placar.width / 2, 5);                                         // Desenha placar centralizado
+    PROF_END(PROF_DESENHAR_JOGO);
+}
@@ -0,0 +1,123 @@
+/*****************************************************************************************************
+ * Lógica do jogo de Ping Pong: estado, entrada, IA, física e desenho da cena.
+ *
+ * Separada de ping-pong-RP2040.c para ser compilada tanto no firmware quanto no build para Linux
+ * (host/), que usa uma HAL simulada no lugar do Pico SDK.
+  ******************************************************************************************************/
+
+#ifndef JOGO_H
+#define JOGO_H
+
+#include "libs/ssd1306/ssd1306.h"                                                                               // Biblioteca do display SSD1306
+#include "libs/physics/physics.h"                                                                               // Física em ponto fixo com colisão contínua
+#include "libs/physics/physics_balls.h"                                                                         // Várias bolas em estrutura de vetores (multibola)
+#include "libs/ai/ai.h"                                                                                         // IA por previsão de trajetória
+#include "libs/input/input.h"                                                                                   // Joystick por DMA com filtro
+#include "libs/replay/replay.h"                                                                                 // Gravação e reprodução de sessões
+#include "libs/scheduler/scheduler.h"                                                                           // Quadros iguais contados na telemetria
+#include "libs/profiler/profiler.h"                                                                             // Zonas de perfil (somem sem PROFILER_ENABLED)
+
+// Dimensões da tela
+#define LARGURA 128                                                                                             // Largura total do display em pixels
+#define ALTURA 64                                                                                               // Altura total do display em pixels
+
+// Joystick (eixos HORZ em GP26 e VERT em GP27, lidos pelo ADC)
+#define JOYSTICK_SEL 22                                                                                         // Botão SEL do joystick
+
+// Dimensões da raquete
+#define LARGURA_RAQUETE 4                                                                                       // Largura horizontal da raquete
+#define ALTURA_RAQUETE 16                                                                                       // Altura vertical da raquete  
+#define VELOCIDADE_RAQUETE 2                                                                                    // Velocidade de movimento das raquetes
+#define NIVEL_IA AI_MEDIUM                                                                                      // Dificuldade da IA (AI_EASY, AI_MEDIUM, AI_HARD)
+
+// Parâmetros da bola
+#define TAMANHO_BOLA 4                                                                                          // Tamanho do lado do quadrado da bola
+#define VELOCIDADE_BOLA 2                                                                                       // Velocidade base de movimento da bola
+#define ACRESCIMO_VELOCIDADE_BOLA Q16_FRAC(1, 8)                                                                // Pixels/tick a mais a cada rebatida
+#define VELOCIDADE_MAXIMA_BOLA 12                                                                               // Pixels/tick; acima da largura da raquete, sem atravessá-la
+#define INCLINACAO_MAXIMA_BOLA Q16_ONE                                                                          // |dy|/|dx| máximo ao bater na ponta da raquete
+
+// Economia de energia: sem mexer no joystick por TEMPO_INATIVIDADE_US, o jogo entra numa demonstração
+// em baixa taxa (a IA joga pelas duas raquetes) com o painel escurecido; qualquer movimento volta ao jogo
+#define TEMPO_INATIVIDADE_US 30000000                                                                           // 30 s sem atividade
+#define LIMIAR_ATIVIDADE 200                                                                                    // Variação mínima de um eixo (0-4095) que conta como movimento
+#define PERIODO_ESPERA_US 50000                                                                                 // Ticks e quadros da demonstração (20Hz)
+#define CONTRASTE_NORMAL 0xFF
+#define CONTRASTE_ESPERA 0x10
+
+// Estado serializado campo a campo (largura fixa, little-endian) para levar uma gravação da placa ao host
+#define VERSAO_ESTADO 2                                                                                         // Primeiro byte do estado serializado
+#define TAMANHO_ESTADO_SERIALIZADO (97 + 18 * PHYS_BALLS_MAX)                                                   // Campos fixos mais x, y, vx, vy e rali por bola
+
+// Estrutura do estado do jogo
+struct EstadoJogo {
+    int jogador_y;                                                                                              // Posição Y da raquete do jogador
+    int ia_y;                                                                                                   // Posição Y da raquete da IA
+    int direcao_ia;                                                                                             // Direção atual do movimento da IA
+    ai_t ia;                                                                                                    // Previsão, atraso de reação e posição fina da IA
+    int bola_x;                                                                                                 // Posição X atual da bola (pixels)
+    int bola_y;                                                                                                 // Posição Y atual da bola (pixels)
+    phys_ball_t bola;                                                                                           // Posição, velocidade e rali da bola em ponto fixo
+    int pontuacao_jogador;                                                                                      // Pontos acumulados pelo jogador
+    int pontuacao_ia;                                                                                           // Pontos acumulados pela IA
+    phys_balls_t bolas;                                                                                         // Multibola (bolas.count > 0); na partida clássica fica vazio e vale 'bola'
+    uint8_t alvo_ia;                                                                                            // Bola que a IA defende na multibola
+};
+
+// Detecção de inatividade e a IA que joga pela raquete esquerda na demonstração
+struct Espera {
+    input_state_t referencia;                                                                                   // Entrada na última atividade
+    uint64_t ultima_atividade_us;
+    bool ativa;                                                                                                 // Em demonstração
+    ai_t demo;
+    uint8_t alvo_demo;                                                                                          // Bola que a IA da demonstração defende na multibola
+};
+
+// Laço do jogo contra a IA, o mesmo no firmware e no bench_power: a partida, pausada e retomada pelo botão
+// SEL, e a demonstração depois de TEMPO_INATIVIDADE_US parado
+struct Laco {
+    struct Espera espera;
+    bool demonstracao;                                                                                          // Permite a demonstração (economia de energia, fora da rede)
+    bool pausa;                                                                                                 // Permite pausar (fora da rede, onde as placas seguem em lockstep)
+    bool pausado;                                                                                               // Partida parada: nenhum tick roda nem é gravado
+    bool botao;                                                                                                 // SEL na última verificação, para pegar só o aperto
+};
+
+// Último quadro enviado aos painéis e o contraste aplicado
+struct Apresentacao {
+    struct EstadoJogo desenhado;
+    bool ha_desenhado;
+    bool pular_iguais;                                                                                          // Cena igual à do último quadro enviado não é desenhada nem enviada
+    uint8_t contraste;
+};
+
+extern const input_config_t configuracao_joystick;                                                              // Taxa de amostragem, filtros e calibração
+
+void inicializar_jogo(struct EstadoJogo* estado);
+void inicializar_multibola(struct EstadoJogo* estado, unsigned bolas);
+uint16_t valor_joystick(void);
+uint16_t ler_joystick(struct EstadoJogo* estado);
+void aplicar_joystick(struct EstadoJogo* estado, uint16_t valor);
+void aplicar_joystick_direita(struct EstadoJogo* estado, uint16_t valor);
+void atualizar_ia(struct EstadoJogo* estado);
+void atualizar_bola(struct EstadoJogo* estado);
+void reproduzir_passo(void* estado, uint16_t valor_joystick);
+void passo_em_rede(void* estado, const uint16_t entradas[2]);
+uint32_t hash_estado(const void* estado);
+size_t serializar_estado(const struct EstadoJogo* estado, uint8_t* saida);
+bool desserializar_estado(struct EstadoJogo* estado, const uint8_t* entrada, size_t tamanho);
+void iniciar_espera(struct Espera* espera, uint64_t agora_us, input_state_t entrada);
+bool joystick_mexeu(const struct Espera* espera, input_state_t entrada);
+bool atualizar_espera(struct Espera* espera, struct EstadoJogo* estado, uint64_t agora_us, input_state_t entrada);
+void passo_demonstracao(struct EstadoJogo* estado, struct Espera* espera);
+bool cena_igual(const struct EstadoJogo* a, const struct EstadoJogo* b);
+void iniciar_laco(struct Laco* laco, bool demonstracao, bool pausa, uint64_t agora_us, input_state_t entrada);
+void passo_jogo(struct Laco* laco, struct EstadoJogo* estado, void (*passo_partida)(struct EstadoJogo* estado));
+bool verificar_espera(struct Laco* laco, struct EstadoJogo* estado, uint64_t agora_us, input_state_t entrada);
+void iniciar_apresentacao(struct Apresentacao* apresentacao, bool pular_iguais);
+bool apresentar_quadro(struct Apresentacao* apresentacao, const struct EstadoJogo* quadro, uint8_t contraste,
+                       ssd1306_t* paineis, unsigned num_paineis, sched_t* agenda);
+void desenhar_tela_inicial(ssd1306_t* ssd);
+void desenhar_jogo(ssd1306_t* ssd, struct EstadoJogo* estado);
+
+#endif
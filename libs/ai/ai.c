@@ -0,0 +1,90 @@
+#include "ai.h"
+
+const ai_level_t ai_levels[AI_LEVEL_COUNT] = {
+  [AI_EASY] = { .reaction_ticks = 12, .max_error = Q16_FROM_INT(6), .max_speed = Q16_FRAC(3, 2) },
+  [AI_MEDIUM] = { .reaction_ticks = 6, .max_error = Q16_FROM_INT(3), .max_speed = Q16_FROM_INT(2) },
+  [AI_HARD] = { .reaction_ticks = 2, .max_error = Q16_FROM_INT(1), .max_speed = Q16_FROM_INT(3) },
+};
+
+void ai_init(ai_t *ai, ai_level_id_t level, bool left, q16_t y, uint32_t seed) {
+  ai->level = level;
+  ai->left = left;
+  ai->seed = seed ? seed : 1;
+  ai->predictions = 0;
+  ai_reset(ai, y);
+}
+
+// Raquete parada em y, sem previsão em cache
+void ai_reset(ai_t *ai, q16_t y) {
+  ai->y = ai->target = ai->pending_target = y;
+  ai->direction = 0;
+  ai->delay = 0;
+  ai->cached = false;
+  ai->last_x = 0;
+}
+
+// Posição vertical (topo) da bola quando sua borda alcançar face_x. A
+// trajetória é desdobrada em linha reta e dobrada de volta no intervalo
+// [0, H - tamanho], o que equivale a todas as reflexões nas paredes.
+q16_t ai_predict_y(const phys_config_t *cfg, const phys_ball_t *ball, q16_t face_x) {
+  q16_t edge = ball->vx > 0 ? ball->x + ball->size : ball->x;
+  int64_t ticks = ((int64_t)face_x - edge) * Q16_ONE / ball->vx;
+  int64_t span = cfg->height - ball->size;
+  int64_t y = ball->y + (((int64_t)ball->vy * ticks) >> Q16_SHIFT);
+
+  y %= 2 * span;
+  if (y < 0)
+    y += 2 * span;
+  return (q16_t)(y <= span ? y : 2 * span - y);
+}
+
+// Erro pseudoaleatório determinístico em [-max_error, max_error]
+static q16_t ai_error(ai_t *ai) {
+  ai->seed = ai->seed * 1664525u + 1013904223u;
+  int32_t r = (int32_t)(ai->seed >> 16) - 0x8000;
+  return (q16_t)(((int64_t)ai_levels[ai->level].max_error * r) >> 15);
+}
+
+void ai_update(ai_t *ai, const phys_config_t *cfg, const phys_ball_t *ball, const phys_box_t *paddle) {
+  const ai_level_t *level = &ai_levels[ai->level];
+  q16_t vy_abs = ball->vy < 0 ? -ball->vy : ball->vy;
+  bool incoming = ai->left ? ball->vx < 0 : ball->vx > 0;
+  q16_t limit = cfg->height - paddle->h;
+  bool served = ball->vx > 0 ? ball->x < ai->last_x : ball->x > ai->last_x;
+
+  // Nova previsão só quando a trajetória muda; as reflexões nas paredes
+  // só trocam o sinal de vy e já estão contidas na previsão anterior
+  ai->last_x = ball->x;
+  if (!ai->cached || served || ball->vx != ai->cached_vx || vy_abs != ai->cached_vy) {
+    q16_t target = limit / 2;                  // Sem bola vindo: volta ao centro
+    if (incoming) {
+      q16_t face = ai->left ? paddle->x + paddle->w : paddle->x;
+      q16_t hit_y = ai_predict_y(cfg, ball, face) + ai_error(ai);
+      target = hit_y + ball->size / 2 - paddle->h / 2;
+    }
+    if (target < 0)
+      target = 0;
+    if (target > limit)
+      target = limit;
+
+    ai->pending_target = target;
+    ai->delay = level->reaction_ticks;
+    ai->cached = true;
+    ai->cached_vx = ball->vx;
+    ai->cached_vy = vy_abs;
+    ai->predictions++;
+  }
+
+  if (ai->delay && --ai->delay == 0)
+    ai->target = ai->pending_target;
+  else if (!level->reaction_ticks)
+    ai->target = ai->pending_target;
+
+  q16_t diff = ai->target - ai->y;
+  if (diff > level->max_speed)
+    diff = level->max_speed;
+  else if (diff < -level->max_speed)
+    diff = -level->max_speed;
+  ai->y += diff;
+  ai->direction = (diff > 0) - (diff < 0);
+}
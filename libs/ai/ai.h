@@ -0,0 +1,51 @@
+#ifndef AI_H
+#define AI_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "libs/physics/physics.h"
+
+// IA de raquete por previsão de trajetória. O ponto em que a bola cruza a
+// face da raquete é calculado em forma fechada (trajetória desdobrada e
+// dobrada de volta pelas reflexões nas paredes), com custo constante, e
+// fica em cache até a velocidade da bola mudar de verdade (rebatida ou
+// saque) ou a bola andar contra a própria velocidade, o que só acontece num
+// saque com a mesma velocidade, de outro ponto. O nível de dificuldade controla o atraso de reação, o erro da
+// previsão e a velocidade máxima da raquete.
+
+typedef enum {
+  AI_EASY,
+  AI_MEDIUM,
+  AI_HARD,
+  AI_LEVEL_COUNT
+} ai_level_id_t;
+
+typedef struct {
+  uint8_t reaction_ticks;           // Ticks até reagir a uma trajetória nova
+  q16_t max_error;                  // Erro máximo da previsão (+/- pixels)
+  q16_t max_speed;                  // Pixels por tick
+} ai_level_t;
+
+extern const ai_level_t ai_levels[AI_LEVEL_COUNT];
+
+typedef struct {
+  ai_level_id_t level;              // Índice em ai_levels (estado sem ponteiros)
+  bool left;                        // Raquete da esquerda (true) ou da direita
+  q16_t y;                          // Topo da raquete
+  int direction;                    // -1 subindo, 0 parada, 1 descendo
+  q16_t target;                     // Topo desejado para a raquete
+  q16_t pending_target;             // Alvo novo esperando o tempo de reação
+  uint8_t delay;
+  bool cached;
+  q16_t cached_vx, cached_vy;       // Velocidade (|vy|) usada na última previsão
+  q16_t last_x;                     // x da bola no último ai_update
+  uint32_t seed;
+  uint32_t predictions;             // Previsões recalculadas (fora do cache)
+} ai_t;
+
+void ai_init(ai_t *ai, ai_level_id_t level, bool left, q16_t y, uint32_t seed);
+void ai_reset(ai_t *ai, q16_t y);
+q16_t ai_predict_y(const phys_config_t *cfg, const phys_ball_t *ball, q16_t face_x);
+void ai_update(ai_t *ai, const phys_config_t *cfg, const phys_ball_t *ball, const phys_box_t *paddle);
+
+#endif
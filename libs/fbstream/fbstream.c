@@ -0,0 +1,257 @@
+#include <string.h>
+#include "fbstream.h"
+
+#define FBSTREAM_LITERAL_MAX 64
+#define FBSTREAM_REPEAT_MIN 3
+#define FBSTREAM_REPEAT_MAX (0x3F + FBSTREAM_REPEAT_MIN)
+#define FBSTREAM_ZEROS_MAX 128
+
+// CRC-16/CCITT (polinômio 0x1021, início 0xFFFF)
+static uint16_t fbstream_crc16(const uint8_t *data, size_t len) {
+  uint16_t crc = 0xFFFF;
+  while (len--) {
+    crc ^= (uint16_t)*data++ << 8;
+    for (int bit = 0; bit < 8; ++bit)
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+  }
+  return crc;
+}
+
+static void fbstream_put16(uint8_t *out, uint16_t value) {
+  out[0] = value;
+  out[1] = value >> 8;
+}
+
+static uint16_t fbstream_get16(const uint8_t *in) {
+  return in[0] | in[1] << 8;
+}
+
+// Tamanho de data[0..n) só em literais: um byte de contagem a cada 64
+static size_t fbstream_literal_size(size_t n) {
+  return n + (n + FBSTREAM_LITERAL_MAX - 1) / FBSTREAM_LITERAL_MAX;
+}
+
+// Quadro sem compressão, em literais de 64 bytes; cabe sempre no pacote
+static size_t fbstream_literal(const uint8_t *data, size_t n, uint8_t *out) {
+  size_t o = 0;
+  for (size_t i = 0; i < n; i += FBSTREAM_LITERAL_MAX) {
+    size_t count = n - i < FBSTREAM_LITERAL_MAX ? n - i : FBSTREAM_LITERAL_MAX;
+    out[o++] = count - 1;
+    memcpy(&out[o], &data[i], count);
+    o += count;
+  }
+  return o;
+}
+
+// RLE de data[0..n) em out; retorna o tamanho, ou 0 se passaria de limit
+// bytes. Zeros viram um byte por até 128, repetições de 3 ou mais viram
+// dois, o resto vai literal. Bytes que alternam com zeros crescem até 1,5x.
+static size_t fbstream_rle(const uint8_t *data, size_t n, uint8_t *out, size_t limit) {
+  size_t i = 0, o = 0;
+  while (i < n) {
+    size_t run = 1;
+    while (i + run < n && data[i + run] == data[i] && run < FBSTREAM_ZEROS_MAX)
+      run++;
+    if (data[i] == 0) {
+      if (o + 1 > limit)
+        return 0;
+      out[o++] = 0x80 | (run - 1);
+      i += run;
+    } else if (run >= FBSTREAM_REPEAT_MIN) {
+      if (run > FBSTREAM_REPEAT_MAX)
+        run = FBSTREAM_REPEAT_MAX;
+      if (o + 2 > limit)
+        return 0;
+      out[o++] = 0x40 | (run - FBSTREAM_REPEAT_MIN);
+      out[o++] = data[i];
+      i += run;
+    } else {
+      // Literal até um zero ou uma repetição que valha a pena
+      size_t start = i;
+      do {
+        ++i;
+      } while (i < n && i - start < FBSTREAM_LITERAL_MAX && data[i] != 0 &&
+               !(i + 2 < n && data[i + 1] == data[i] && data[i + 2] == data[i]));
+      if (o + 1 + (i - start) > limit)
+        return 0;
+      out[o++] = i - start - 1;
+      memcpy(&out[o], &data[start], i - start);
+      o += i - start;
+    }
+  }
+  return o;
+}
+
+void fbstream_init(fbstream_t *s, uint8_t width, uint8_t pages, fbstream_write_t write, void *ctx) {
+  s->width = width;
+  s->pages = pages;
+  s->sequence = 0;
+  s->since_key = 0;
+  s->key_size = 0;
+  s->need_key = true;
+  s->write = write;
+  s->ctx = ctx;
+  memset(&s->stats, 0, sizeof(s->stats));
+}
+
+void fbstream_request_key(fbstream_t *s) {
+  s->need_key = true;
+}
+
+// O XOR é feito em previous (sem outro buffer de 1 KB): previous vira a
+// diferença, é comprimido e depois recebe o quadro novo. O RLE nunca passa
+// do tamanho em literais; quando passaria, a diferença vira quadro inteiro e
+// o quadro inteiro vai só em literais.
+size_t fbstream_frame(fbstream_t *s, const uint8_t *columns, uint16_t time_ms) {
+  const unsigned width = s->width, pages = s->pages;
+  const size_t n = width * pages, limit = fbstream_literal_size(n);
+  bool key = s->need_key || s->since_key >= FBSTREAM_KEY_INTERVAL - 1;
+  uint8_t *p = s->packet;
+
+  for (unsigned page = 0; page < pages; ++page) {
+    uint8_t *row = &s->previous[page * width];
+    for (unsigned x = 0; x < width; ++x)
+      row[x] = key ? columns[x * pages + page] : row[x] ^ columns[x * pages + page];
+  }
+  size_t size = fbstream_rle(s->previous, n, &p[FBSTREAM_HEADER], limit);
+  for (unsigned page = 0; page < pages; ++page) {
+    uint8_t *row = &s->previous[page * width];
+    for (unsigned x = 0; x < width; ++x)
+      row[x] = columns[x * pages + page];
+  }
+  // Com muita coisa mexendo (multibola) a diferença tem as duas posições de
+  // cada objeto e pode sair maior que o quadro inteiro
+  if (!key && (!size || size > s->key_size)) {
+    key = true;
+    size = fbstream_rle(s->previous, n, &p[FBSTREAM_HEADER], limit);
+  }
+  if (!size)
+    size = fbstream_literal(s->previous, n, &p[FBSTREAM_HEADER]);
+  if (key)
+    s->key_size = size;
+
+  p[0] = 'F';
+  p[1] = 'B';
+  p[2] = key ? 'K' : 'D';
+  fbstream_put16(&p[3], s->sequence++);
+  fbstream_put16(&p[5], time_ms);
+  p[7] = width;
+  p[8] = pages;
+  fbstream_put16(&p[9], size);
+  fbstream_put16(&p[FBSTREAM_HEADER + size], fbstream_crc16(&p[2], FBSTREAM_HEADER - 2 + size));
+  size += FBSTREAM_HEADER + 2;
+  s->write(s->ctx, p, size);
+
+  s->need_key = false;
+  s->since_key = key ? 0 : s->since_key + 1;
+  s->stats.frames++;
+  s->stats.keyframes += key;
+  s->stats.raw_bytes += n;
+  s->stats.sent_bytes += size;
+  if (size > s->stats.max_packet)
+    s->stats.max_packet = size;
+  return size;
+}
+
+void fbstream_decoder_init(fbstream_decoder_t *d) {
+  memset(d, 0, sizeof(*d));
+}
+
+static void fbstream_decoder_drop(fbstream_decoder_t *d, size_t count) {
+  memmove(d->buffer, &d->buffer[count], d->len - count);
+  d->len -= count;
+}
+
+// Aplica os dados de um pacote íntegro; uma diferença só vale sobre o
+// quadro de sequência anterior
+static bool fbstream_decoder_apply(fbstream_decoder_t *d, const uint8_t *p) {
+  bool key = p[2] == 'K';
+  uint16_t sequence = fbstream_get16(&p[3]);
+  uint8_t width = p[7], pages = p[8];
+  const uint8_t *data = &p[FBSTREAM_HEADER];
+  size_t size = fbstream_get16(&p[9]), n = width * pages, i = 0, k = 0;
+
+  if (!key && (!d->synced || width != d->width || pages != d->pages || sequence != (uint16_t)(d->sequence + 1))) {
+    d->synced = false;
+    d->stats.lost++;
+    return false;
+  }
+  if (key)
+    memset(d->frame, 0, n);
+  while (k < size && i < n) {
+    uint8_t c = data[k++];
+    size_t count;
+    if (c & 0x80) {
+      count = (c & 0x7F) + 1;
+      if (count > n - i)
+        break;
+      i += count;                                       // XOR com zero
+    } else if (c & 0x40) {
+      count = (c & 0x3F) + FBSTREAM_REPEAT_MIN;
+      if (count > n - i || k >= size)
+        break;
+      for (uint8_t value = data[k++]; count--;)
+        d->frame[i++] ^= value;
+    } else {
+      count = c + 1;
+      if (count > n - i || count > size - k)
+        break;
+      while (count--)
+        d->frame[i++] ^= data[k++];
+    }
+  }
+  if (i != n || k != size) {
+    d->synced = false;
+    d->stats.bad_packets++;
+    return false;
+  }
+
+  d->width = width;
+  d->pages = pages;
+  d->sequence = sequence;
+  d->time_ms = fbstream_get16(&p[5]);
+  d->keyframe = key;
+  d->synced = true;
+  d->stats.frames++;
+  d->stats.keyframes += key;
+  return true;
+}
+
+bool fbstream_decoder_push(fbstream_decoder_t *d, uint8_t byte) {
+  d->buffer[d->len++] = byte;
+  while (d->len) {
+    const uint8_t *p = d->buffer;
+    if (p[0] != 'F' || (d->len >= 2 && p[1] != 'B')) {
+      d->stats.skipped_bytes++;
+      fbstream_decoder_drop(d, 1);
+      continue;
+    }
+    if (d->len < FBSTREAM_HEADER)
+      return false;
+
+    size_t n = p[7] * p[8], size = fbstream_get16(&p[9]);
+    if ((p[2] != 'K' && p[2] != 'D') || !n || n > FBSTREAM_MAX_BYTES ||
+        size > FBSTREAM_PACKET_MAX - FBSTREAM_HEADER - 2) {
+      d->stats.bad_packets++;
+      d->stats.skipped_bytes++;
+      fbstream_decoder_drop(d, 1);
+      continue;
+    }
+    size_t total = FBSTREAM_HEADER + size + 2;
+    if (d->len < total)
+      return false;
+    if (fbstream_crc16(&p[2], total - 4) != fbstream_get16(&p[total - 2])) {
+      d->stats.bad_packets++;
+      d->stats.skipped_bytes++;
+      fbstream_decoder_drop(d, 1);                      // O sincronismo pode estar dentro do pacote falso
+      continue;
+    }
+
+    bool applied = fbstream_decoder_apply(d, p);
+    d->stats.packet_bytes += total;
+    fbstream_decoder_drop(d, total);
+    if (applied)
+      return true;                                      // Restos no buffer ficam para o próximo byte
+  }
+  return false;
+}
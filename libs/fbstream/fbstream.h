@@ -0,0 +1,88 @@
+#ifndef FBSTREAM_H
+#define FBSTREAM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Transmissão do buffer do display para um visualizador: cada quadro vai
+// como XOR contra o último enviado (quase tudo zero entre dois quadros) e
+// comprimido por RLE. Um quadro inteiro (XOR contra zero) sai a cada
+// FBSTREAM_KEY_INTERVAL quadros e quando pedido, para quem começa a ver no
+// meio ou perdeu um pacote, e também quando sairia menor que a diferença.
+// Quando o RLE cresceria (bytes alternando com zeros, como listras de 1
+// pixel), o quadro inteiro vai só em literais. O enlace pode misturar texto
+// entre os pacotes (printf no mesmo stdio): o decodificador procura o
+// sincronismo e descarta pacotes com CRC errado.
+//
+// Pacote (valores de 16 bits em little-endian):
+//   'F' 'B' | tipo ('K' inteiro, 'D' diferença) | sequência (16) | tempo em ms (16)
+//   | largura (8) | páginas (8) | tamanho dos dados (16) | dados | CRC-16 (do tipo ao fim dos dados)
+// Os dados cobrem os bytes do quadro na ordem da GRAM do SSD1306 (página a
+// página, coluna a coluna, bit 0 na linha de cima de cada página):
+//   0x00-0x3F: n + 1 bytes literais a seguir
+//   0x40-0x7F: o byte seguinte repetido (n & 0x3F) + 3 vezes
+//   0x80-0xFF: (n & 0x7F) + 1 zeros
+
+#define FBSTREAM_MAX_BYTES 1024                         // Quadro de até 128x64
+#define FBSTREAM_KEY_INTERVAL 60                        // Quadros entre quadros inteiros
+#define FBSTREAM_HEADER 11
+// Cabeçalho, o quadro em literais (um byte de contagem a cada 64) e o CRC
+#define FBSTREAM_PACKET_MAX (FBSTREAM_HEADER + FBSTREAM_MAX_BYTES + FBSTREAM_MAX_BYTES / 64 + 2)
+
+typedef void (*fbstream_write_t)(void *ctx, const uint8_t *data, size_t len);
+
+typedef struct {
+  uint32_t frames, keyframes;
+  uint64_t raw_bytes;                                   // Bytes dos quadros
+  uint64_t sent_bytes;                                  // Bytes dos pacotes
+  uint32_t max_packet;
+} fbstream_stats_t;
+
+typedef struct {
+  uint8_t width, pages;
+  uint16_t sequence;
+  uint16_t since_key;
+  uint16_t key_size;                                    // Dados do último quadro inteiro
+  bool need_key;
+  fbstream_write_t write;
+  void *ctx;
+  fbstream_stats_t stats;
+  uint8_t previous[FBSTREAM_MAX_BYTES];                 // Último quadro enviado, na ordem da GRAM
+  uint8_t packet[FBSTREAM_PACKET_MAX];
+} fbstream_t;
+
+typedef struct {
+  uint32_t frames, keyframes;
+  uint32_t bad_packets;                                 // CRC ou cabeçalho inválidos
+  uint32_t lost;                                        // Diferenças descartadas por falta do quadro anterior
+  uint64_t skipped_bytes;                               // Fora de pacotes (texto, lixo)
+  uint64_t packet_bytes;
+} fbstream_decoder_stats_t;
+
+typedef struct {
+  uint8_t width, pages;
+  uint16_t sequence, time_ms;                           // Do último quadro
+  bool keyframe;
+  bool synced;                                          // Quadro atual é válido
+  uint8_t frame[FBSTREAM_MAX_BYTES];                    // Na ordem da GRAM
+  uint8_t buffer[FBSTREAM_PACKET_MAX];
+  size_t len;
+  fbstream_decoder_stats_t stats;
+} fbstream_decoder_t;
+
+// width * pages até FBSTREAM_MAX_BYTES; o primeiro quadro sai inteiro
+void fbstream_init(fbstream_t *s, uint8_t width, uint8_t pages, fbstream_write_t write, void *ctx);
+void fbstream_request_key(fbstream_t *s);
+// Codifica e envia um quadro do buffer do driver (coluna a coluna, pages
+// bytes por coluna, sem o byte de controle). Retorna o tamanho do pacote.
+size_t fbstream_frame(fbstream_t *s, const uint8_t *columns, uint16_t time_ms);
+
+void fbstream_decoder_init(fbstream_decoder_t *d);
+// Alimenta um byte do enlace; true quando ele completa um quadro novo em frame
+bool fbstream_decoder_push(fbstream_decoder_t *d, uint8_t byte);
+static inline bool fbstream_pixel(const fbstream_decoder_t *d, unsigned x, unsigned y) {
+  return (d->frame[(y >> 3) * d->width + x] >> (y & 7)) & 1;
+}
+
+#endif
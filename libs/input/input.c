@@ -0,0 +1,144 @@
+#include <stdatomic.h>
+#include "input.h"
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#if PICO_ON_DEVICE
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#endif
+
+// Amostras por bloco de DMA (os dois eixos intercalados; precisa ser par)
+#define INPUT_BLOCK 64
+#define INPUT_GPIO_FIRST_ADC 26
+
+static const input_config_t *input_config;
+static input_filter_t input_filters[INPUT_AXIS_COUNT];
+static bool input_select;
+static uint8_t input_select_count;
+static uint8_t input_sequence;
+
+// Estado publicado: eixo X nos bits 0-11, Y nos bits 12-23, SEL no bit 24 e
+// a sequência nos bits 25-31. Uma palavra de 32 bits é lida e escrita de
+// uma vez no M0+, sem travas.
+static _Atomic uint32_t input_published;
+
+static void input_publish(void) {
+  uint32_t word = input_filter_value(&input_filters[INPUT_AXIS_X]) |
+                  (uint32_t)input_filter_value(&input_filters[INPUT_AXIS_Y]) << 12 |
+                  (uint32_t)input_select << 24 | (uint32_t)(++input_sequence & 0x7F) << 25;
+  atomic_store_explicit(&input_published, word, memory_order_release);
+}
+
+// Filtra um bloco intercalado X, Y, X, Y... e o estado do botão
+static void input_process(const uint16_t *samples, unsigned count) {
+  input_filter_push_block(&input_filters[INPUT_AXIS_X], samples, count, 2);
+  input_filter_push_block(&input_filters[INPUT_AXIS_Y], samples + 1, count - 1, 2);
+
+  bool pressed = !gpio_get(input_config->select_gpio);
+  if (pressed == input_select) {
+    input_select_count = 0;
+  } else if (++input_select_count >= input_config->debounce_blocks) {
+    input_select = pressed;
+    input_select_count = 0;
+  }
+  input_publish();
+}
+
+#if PICO_ON_DEVICE
+
+static uint16_t input_ring[2][INPUT_BLOCK];
+static int input_dma[2];
+
+// Fim de um bloco: o outro canal já está escrevendo o bloco seguinte
+// (encadeados), então este é reapontado para o seu bloco e processado
+static void input_dma_irq(void) {
+  for (int i = 0; i < 2; ++i) {
+    if (dma_channel_get_irq1_status(input_dma[i])) {
+      dma_channel_acknowledge_irq1(input_dma[i]);
+      dma_channel_set_write_addr(input_dma[i], input_ring[i], false);
+      input_process(input_ring[i], INPUT_BLOCK);
+    }
+  }
+}
+
+static void input_start(void) {
+  adc_set_round_robin((1u << INPUT_AXIS_X) | (1u << INPUT_AXIS_Y));
+  adc_select_input(INPUT_AXIS_X);
+  adc_fifo_setup(true, true, 1, false, false);
+  adc_set_clkdiv(48000000.0f / input_config->sample_rate_hz - 1);
+
+  input_dma[0] = dma_claim_unused_channel(true);
+  input_dma[1] = dma_claim_unused_channel(true);
+  for (int i = 0; i < 2; ++i) {
+    dma_channel_config config = dma_channel_get_default_config(input_dma[i]);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+    channel_config_set_read_increment(&config, false);
+    channel_config_set_write_increment(&config, true);
+    channel_config_set_dreq(&config, DREQ_ADC);
+    channel_config_set_chain_to(&config, input_dma[!i]);
+    dma_channel_configure(input_dma[i], &config, input_ring[i], &adc_hw->fifo, INPUT_BLOCK, false);
+    dma_channel_set_irq1_enabled(input_dma[i], true);
+  }
+  irq_set_exclusive_handler(DMA_IRQ_1, input_dma_irq);
+  irq_set_enabled(DMA_IRQ_1, true);
+
+  dma_channel_start(input_dma[0]);
+  adc_run(true);
+}
+
+#else
+
+// Blocos por leitura no host: ~16 ms de amostras, um tick de 60Hz
+#define INPUT_HOST_BLOCKS 4
+
+// Sem DMA: cada leitura amostra o ADC simulado um número fixo de blocos,
+// sem depender do tempo (virtual) passado. Assim a mesma sequência de
+// leituras dá a mesma entrada qualquer que seja o custo do resto do quadro
+// (envio síncrono, por DMA ou quadro inteiro)
+static void input_sample(void) {
+  uint16_t samples[INPUT_BLOCK];
+
+  for (unsigned block = 0; block < INPUT_HOST_BLOCKS; ++block) {
+    for (unsigned i = 0; i < INPUT_BLOCK; ++i) {
+      adc_select_input(i & 1 ? INPUT_AXIS_Y : INPUT_AXIS_X);
+      samples[i] = adc_read();
+    }
+    input_process(samples, INPUT_BLOCK);
+  }
+}
+
+#endif
+
+void input_init(const input_config_t *config) {
+  input_config = config;
+  for (int i = 0; i < INPUT_AXIS_COUNT; ++i)
+    input_filter_init(&input_filters[i], &config->axis[i]);
+  input_select = false;
+  input_select_count = 0;
+  input_sequence = 0;
+
+  adc_init();
+  for (int i = 0; i < INPUT_AXIS_COUNT; ++i)
+    adc_gpio_init(INPUT_GPIO_FIRST_ADC + i);
+  gpio_init(config->select_gpio);
+  gpio_set_dir(config->select_gpio, false);
+  gpio_pull_up(config->select_gpio);
+  input_publish();
+
+#if PICO_ON_DEVICE
+  input_start();
+#endif
+}
+
+input_state_t input_latest(void) {
+#if !PICO_ON_DEVICE
+  input_sample();
+#endif
+  uint32_t word = atomic_load_explicit(&input_published, memory_order_acquire);
+  input_state_t state = {
+    .axis = { word & 0x0FFF, (word >> 12) & 0x0FFF },
+    .select = (word >> 24) & 1,
+    .sequence = word >> 25,
+  };
+  return state;
+}
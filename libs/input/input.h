@@ -0,0 +1,37 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "input_filter.h"
+
+// Entrada do joystick. No RP2040 o ADC roda sozinho em round-robin entre os
+// dois eixos e o DMA enche dois blocos alternados; a interrupção de fim de
+// bloco passa as amostras pelos filtros e publica o estado mais recente numa
+// palavra atômica, que o jogo lê sem travas e sem esperar o ADC. No host
+// (sem DMA), input_latest amostra o ADC simulado na hora, sempre o mesmo
+// número de blocos por leitura.
+
+enum {
+  INPUT_AXIS_X,                     // HORZ, entrada 0 do ADC
+  INPUT_AXIS_Y,                     // VERT, entrada 1 do ADC
+  INPUT_AXIS_COUNT
+};
+
+typedef struct {
+  uint8_t select_gpio;              // Botão SEL, ativo em nível baixo
+  uint32_t sample_rate_hz;          // Amostras por segundo somando os dois eixos
+  uint8_t debounce_blocks;          // Blocos seguidos iguais para aceitar o botão
+  input_filter_config_t axis[INPUT_AXIS_COUNT];
+} input_config_t;
+
+typedef struct {
+  uint16_t axis[INPUT_AXIS_COUNT];  // 0..INPUT_FILTER_MAX, centro em INPUT_FILTER_CENTER
+  bool select;
+  uint8_t sequence;                 // Muda a cada publicação
+} input_state_t;
+
+void input_init(const input_config_t *config);
+input_state_t input_latest(void);
+
+#endif
@@ -0,0 +1,73 @@
+#include "input_filter.h"
+
+void input_filter_init(input_filter_t *filter, const input_filter_config_t *config) {
+  filter->config = config;
+  filter->sum = 0;
+  filter->count = 0;
+  filter->smooth = 0;
+  filter->primed = false;
+  filter->value = INPUT_FILTER_CENTER;
+}
+
+// Leitura bruta -> 0..INPUT_FILTER_MAX, com cada metade do curso escalada
+// separadamente (o repouso raramente fica no meio da faixa do ADC) e a zona
+// morta descontada do curso para a saída não saltar na borda dela
+uint16_t input_filter_calibrate(const input_filter_config_t *config, uint16_t raw) {
+  int32_t half = INPUT_FILTER_MAX - INPUT_FILTER_CENTER;
+  int32_t offset;
+
+  if (raw < config->cal_center) {
+    int32_t span = config->cal_center - config->cal_min;
+    offset = span > 0 ? -((int32_t)(config->cal_center - raw) * INPUT_FILTER_CENTER) / span : 0;
+    if (offset < -INPUT_FILTER_CENTER)
+      offset = -INPUT_FILTER_CENTER;
+  } else {
+    int32_t span = config->cal_max - config->cal_center;
+    offset = span > 0 ? ((int32_t)(raw - config->cal_center) * half) / span : 0;
+    if (offset > half)
+      offset = half;
+  }
+
+  int32_t magnitude = offset < 0 ? -offset : offset;
+  if (magnitude <= config->deadzone) {
+    offset = 0;
+  } else {
+    int32_t limit = offset < 0 ? INPUT_FILTER_CENTER : half;
+    magnitude = (magnitude - config->deadzone) * limit / (limit - config->deadzone);
+    offset = offset < 0 ? -magnitude : magnitude;
+  }
+
+  if (config->invert)
+    offset = -offset;
+  int32_t value = INPUT_FILTER_CENTER + offset;
+  return value < 0 ? 0 : value > INPUT_FILTER_MAX ? INPUT_FILTER_MAX : value;
+}
+
+// Acumula uma amostra bruta; retorna true quando fecha uma amostra decimada
+// e o valor de saída é atualizado
+bool input_filter_push(input_filter_t *filter, uint16_t raw) {
+  const input_filter_config_t *config = filter->config;
+
+  filter->sum += raw;
+  if (++filter->count < (1u << config->oversample_shift))
+    return false;
+
+  int32_t average = (int32_t)(filter->sum << 8) >> config->oversample_shift;
+  filter->sum = 0;
+  filter->count = 0;
+
+  if (!filter->primed) {
+    filter->smooth = average;
+    filter->primed = true;
+  } else {
+    filter->smooth += (average - filter->smooth) >> config->smoothing_shift;
+  }
+  filter->value = input_filter_calibrate(config, (uint16_t)((filter->smooth + 128) >> 8));
+  return true;
+}
+
+// Amostras intercaladas (round-robin do ADC): uma a cada stride
+void input_filter_push_block(input_filter_t *filter, const uint16_t *samples, unsigned count, unsigned stride) {
+  for (unsigned i = 0; i < count; i += stride)
+    input_filter_push(filter, samples[i] & 0x0FFF);
+}
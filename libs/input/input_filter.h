@@ -0,0 +1,41 @@
+#ifndef INPUT_FILTER_H
+#define INPUT_FILTER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Filtro de um eixo analógico, sem dependência de hardware: média de 2^k
+// amostras brutas (sobreamostragem com decimação), passa-baixas de um polo,
+// calibração linear por partes em torno do centro e zona morta. A saída
+// fica em 0..INPUT_FILTER_MAX, com o centro em INPUT_FILTER_CENTER.
+
+#define INPUT_FILTER_MAX 4095
+#define INPUT_FILTER_CENTER 2048
+
+typedef struct {
+  uint8_t oversample_shift;         // 2^shift amostras brutas por amostra decimada
+  uint8_t smoothing_shift;          // Passa-baixas: y += (x - y) / 2^shift (0 desliga)
+  uint16_t deadzone;                // Raio da zona morta em torno do centro
+  uint16_t cal_min, cal_center, cal_max; // Leituras brutas nos extremos e em repouso
+  bool invert;
+} input_filter_config_t;
+
+typedef struct {
+  const input_filter_config_t *config;
+  uint32_t sum;
+  uint16_t count;
+  int32_t smooth;                   // Média filtrada, bruta em Q8
+  bool primed;
+  uint16_t value;
+} input_filter_t;
+
+void input_filter_init(input_filter_t *filter, const input_filter_config_t *config);
+bool input_filter_push(input_filter_t *filter, uint16_t raw);
+void input_filter_push_block(input_filter_t *filter, const uint16_t *samples, unsigned count, unsigned stride);
+uint16_t input_filter_calibrate(const input_filter_config_t *config, uint16_t raw);
+
+static inline uint16_t input_filter_value(const input_filter_t *filter) {
+  return filter->value;
+}
+
+#endif
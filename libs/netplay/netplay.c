@@ -0,0 +1,306 @@
+#include <string.h>
+#include "netplay.h"
+
+#define NETPLAY_SYNC 0xA5
+#define NETPLAY_FLAG_COUNT 0x1F
+#define NETPLAY_FLAG_HELLO 0x20
+#define NETPLAY_FLAG_PLAYER 0x40
+#define NETPLAY_FLAG_HASH 0x80
+#define NETPLAY_HEADER 6
+#define NETPLAY_HASH_BYTES 6
+#define NETPLAY_HASH_EVERY 4                // Pacotes entre repetições do último hash local
+#define NETPLAY_NONE UINT32_MAX
+
+void netplay_init(netplay_t *np, void *state, size_t state_size, uint8_t *snapshots, netplay_step_t step,
+                  netplay_hash_t hash, netplay_read_t read, netplay_write_t write, void *io, uint32_t nonce) {
+  memset(np, 0, sizeof(*np));
+  np->state = state;
+  np->state_size = state_size;
+  np->snapshots = snapshots;
+  np->step = step;
+  np->hash = hash;
+  np->read = read;
+  np->write = write;
+  np->io = io;
+  np->nonce = nonce;
+  np->rollback_from = NETPLAY_NONE;
+  np->next_hash_tick = NETPLAY_HASH_TICKS;
+}
+
+// Ticks cujas entradas dos dois jogadores já são conhecidas: o estado antes
+// do tick netplay_confirmed não muda mais
+uint32_t netplay_confirmed(const netplay_t *np) {
+  return np->tick < np->remote_next ? np->tick : np->remote_next;
+}
+
+static uint8_t *netplay_snapshot(netplay_t *np, uint32_t tick) {
+  return np->snapshots + (tick % NETPLAY_SNAPSHOTS) * np->state_size;
+}
+
+// CRC-8, polinômio 0x07
+static uint8_t netplay_crc8(const uint8_t *data, size_t len) {
+  uint8_t crc = 0;
+  while (len--) {
+    crc ^= *data++;
+    for (int bit = 0; bit < 8; ++bit)
+      crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1;
+  }
+  return crc;
+}
+
+static void netplay_put16(uint8_t *out, uint32_t value) {
+  out[0] = value & 0xFF;
+  out[1] = (value >> 8) & 0xFF;
+}
+
+static uint16_t netplay_get16(const uint8_t *in) {
+  return in[0] | in[1] << 8;
+}
+
+static uint32_t netplay_get32(const uint8_t *in) {
+  return netplay_get16(in) | (uint32_t)netplay_get16(in + 2) << 16;
+}
+
+// Tick de 32 bits mais próximo de ref com os 16 bits de baixo iguais a low
+static uint32_t netplay_expand(uint32_t ref, uint16_t low) {
+  return ref + (int16_t)(low - (uint16_t)ref);
+}
+
+static size_t netplay_packed_len(unsigned count) {
+  return (count * 3 + 1) / 2;
+}
+
+static size_t netplay_packet_len(uint8_t flags) {
+  return NETPLAY_HEADER + ((flags & NETPLAY_FLAG_HASH) ? NETPLAY_HASH_BYTES : 0) +
+         netplay_packed_len(flags & NETPLAY_FLAG_COUNT) + 1;
+}
+
+static void netplay_send(netplay_t *np) {
+  uint8_t packet[NETPLAY_PACKET_MAX];
+  uint8_t flags;
+  size_t len = NETPLAY_HEADER;
+
+  packet[0] = NETPLAY_SYNC;
+  if (!np->connected) {
+    flags = NETPLAY_FLAG_HELLO;
+    netplay_put16(&packet[1], np->nonce);
+    netplay_put16(&packet[3], np->nonce >> 16);
+  } else {
+    uint32_t pending = np->tick - np->peer_ack;
+    unsigned count = pending < NETPLAY_MAX_INPUTS ? pending : NETPLAY_MAX_INPUTS;
+
+    flags = count | (np->local ? NETPLAY_FLAG_PLAYER : 0);
+    netplay_put16(&packet[1], np->peer_ack);
+    netplay_put16(&packet[3], np->remote_next);
+    if (np->hash_count && np->stats.packets_sent % NETPLAY_HASH_EVERY == 0) {
+      unsigned last = (np->hash_count - 1) % NETPLAY_HASH_HISTORY;
+      flags |= NETPLAY_FLAG_HASH;
+      netplay_put16(&packet[len], np->hash_ticks[last]);
+      netplay_put16(&packet[len + 2], np->hashes[last]);
+      netplay_put16(&packet[len + 4], np->hashes[last] >> 16);
+      len += NETPLAY_HASH_BYTES;
+    }
+    for (unsigned i = 0; i < count; i += 2) {
+      uint16_t a = np->local_inputs[(np->peer_ack + i) % NETPLAY_INPUT_RING];
+      packet[len++] = a & 0xFF;
+      if (i + 1 < count) {
+        uint16_t b = np->local_inputs[(np->peer_ack + i + 1) % NETPLAY_INPUT_RING];
+        packet[len++] = (a >> 8) | (b & 0x0F) << 4;
+        packet[len++] = b >> 4;
+      } else {
+        packet[len++] = a >> 8;
+      }
+    }
+  }
+  packet[5] = flags;
+  packet[len] = netplay_crc8(packet, len);
+  len++;
+
+  np->write(np->io, packet, len);
+  np->stats.packets_sent++;
+  np->stats.bytes_sent += len;
+}
+
+static void netplay_remote_hash(netplay_t *np, uint32_t tick, uint32_t hash) {
+  if (tick == np->last_checked_tick)
+    return;
+  for (unsigned i = 0; i < NETPLAY_HASH_HISTORY && i < np->hash_count; ++i) {
+    if (np->hash_ticks[i] != tick)
+      continue;
+    np->last_checked_tick = tick;
+    np->stats.hash_checks++;
+    if (np->hashes[i] != hash && !np->stats.desyncs++)
+      np->stats.first_desync_tick = tick;
+    return;
+  }
+}
+
+static void netplay_remote_input(netplay_t *np, uint32_t tick, uint16_t input) {
+  if (tick != np->remote_next || tick >= np->tick + NETPLAY_INPUT_RING / 2)
+    return;
+  unsigned slot = tick % NETPLAY_INPUT_RING;
+  np->remote_inputs[slot] = input;
+  if (tick < np->tick && np->used_remote[slot] != input && tick < np->rollback_from)
+    np->rollback_from = tick;
+  np->remote_next++;
+}
+
+// Pacote com CRC já conferido
+static void netplay_packet(netplay_t *np, const uint8_t *packet) {
+  uint8_t flags = packet[5];
+  const uint8_t *data = packet + NETPLAY_HEADER;
+
+  np->stats.packets_received++;
+  if (flags & NETPLAY_FLAG_HELLO) {
+    uint32_t peer = netplay_get32(&packet[1]);
+    if (!np->connected && peer != np->nonce) {
+      np->local = np->nonce < peer ? 0 : 1;
+      np->connected = true;
+    }
+    return;
+  }
+  if (!np->connected) {
+    np->local = (flags & NETPLAY_FLAG_PLAYER) ? 0 : 1;
+    np->connected = true;
+  }
+
+  uint32_t ack = netplay_expand(np->peer_ack, netplay_get16(&packet[3]));
+  if (ack > np->peer_ack && ack <= np->tick)
+    np->peer_ack = ack;
+
+  if (flags & NETPLAY_FLAG_HASH) {
+    netplay_remote_hash(np, netplay_expand(np->tick, netplay_get16(data)), netplay_get32(data + 2));
+    data += NETPLAY_HASH_BYTES;
+  }
+
+  uint32_t first = netplay_expand(np->remote_next, netplay_get16(&packet[1]));
+  unsigned count = flags & NETPLAY_FLAG_COUNT;
+  for (unsigned i = 0; i < count; i += 2, data += 3) {
+    netplay_remote_input(np, first + i, data[0] | (data[1] & 0x0F) << 8);
+    if (i + 1 < count)
+      netplay_remote_input(np, first + i + 1, data[1] >> 4 | data[2] << 4);
+  }
+}
+
+// Tira os n primeiros bytes do buffer de recepção e o lixo até o próximo
+// byte de sincronismo
+static void netplay_discard(netplay_t *np, size_t n) {
+  while (n < np->rx_len && np->rx[n] != NETPLAY_SYNC)
+    n++;
+  np->rx_len -= n;
+  memmove(np->rx, np->rx + n, np->rx_len);
+}
+
+// Remonta pacotes a partir do fluxo de bytes. Lixo antes do byte de
+// sincronismo é ignorado; um pacote com CRC errado é descartado e a busca
+// recomeça no byte seguinte ao sincronismo dele.
+static void netplay_feed(netplay_t *np, uint8_t byte) {
+  if (!np->rx_len && byte != NETPLAY_SYNC)
+    return;
+  np->rx[np->rx_len++] = byte;
+
+  while (np->rx_len >= NETPLAY_HEADER) {
+    size_t len = netplay_packet_len(np->rx[5]);
+    if (np->rx_len < len)
+      return;
+    if (netplay_crc8(np->rx, len - 1) == np->rx[len - 1]) {
+      netplay_packet(np, np->rx);
+      netplay_discard(np, len);
+    } else {
+      np->stats.bad_packets++;
+      netplay_discard(np, 1);
+    }
+  }
+}
+
+static void netplay_receive(netplay_t *np) {
+  uint8_t buffer[64];
+  size_t len;
+  while ((len = np->read(np->io, buffer, sizeof(buffer))) > 0) {
+    np->stats.bytes_received += len;
+    for (size_t i = 0; i < len; ++i)
+      netplay_feed(np, buffer[i]);
+  }
+}
+
+// Entrada remota com que o tick é simulado: a verdadeira, se já chegou, ou
+// a última conhecida
+static uint16_t netplay_remote_for(const netplay_t *np, uint32_t tick) {
+  if (tick < np->remote_next)
+    return np->remote_inputs[tick % NETPLAY_INPUT_RING];
+  return np->remote_next ? np->remote_inputs[(np->remote_next - 1) % NETPLAY_INPUT_RING] : 0;
+}
+
+static void netplay_simulate(netplay_t *np, uint32_t tick) {
+  uint16_t inputs[2];
+  unsigned slot = tick % NETPLAY_INPUT_RING;
+
+  memcpy(netplay_snapshot(np, tick), np->state, np->state_size);
+  np->used_remote[slot] = netplay_remote_for(np, tick);
+  inputs[np->local] = np->local_inputs[slot];
+  inputs[!np->local] = np->used_remote[slot];
+  np->step(np->state, inputs);
+}
+
+// Volta ao instantâneo do primeiro tick previsto errado e refaz até o atual
+static void netplay_rollback(netplay_t *np) {
+  if (np->rollback_from == NETPLAY_NONE)
+    return;
+
+  uint32_t from = np->rollback_from;
+  memcpy(np->state, netplay_snapshot(np, from), np->state_size);
+  for (uint32_t tick = from; tick < np->tick; ++tick)
+    netplay_simulate(np, tick);
+
+  uint32_t count = np->tick - from;
+  np->stats.rollbacks++;
+  np->stats.resimulated += count;
+  if (count > np->stats.max_resimulated)
+    np->stats.max_resimulated = count;
+  np->rollback_from = NETPLAY_NONE;
+}
+
+// Hash do estado a cada NETPLAY_HASH_TICKS ticks confirmados, para o outro
+// lado comparar com o dele
+static void netplay_update_hash(netplay_t *np) {
+  uint32_t confirmed = netplay_confirmed(np);
+  while (np->next_hash_tick <= confirmed) {
+    uint32_t tick = np->next_hash_tick;
+    np->next_hash_tick += NETPLAY_HASH_TICKS;
+    if (np->tick - tick >= NETPLAY_SNAPSHOTS)
+      continue;
+    const void *state = tick == np->tick ? np->state : netplay_snapshot(np, tick);
+    unsigned slot = np->hash_count++ % NETPLAY_HASH_HISTORY;
+    np->hash_ticks[slot] = tick;
+    np->hashes[slot] = np->hash(state);
+  }
+}
+
+// Recebe, corrige previsões e envia, sem avançar a simulação
+void netplay_poll(netplay_t *np) {
+  netplay_receive(np);
+  netplay_rollback(np);
+  netplay_update_hash(np);
+  netplay_send(np);
+}
+
+// Um tick com a entrada local. Retorna false se a simulação não avançou
+// (sem conexão ou muito à frente das entradas remotas).
+bool netplay_tick(netplay_t *np, uint16_t local_input) {
+  netplay_receive(np);
+  netplay_rollback(np);
+  netplay_update_hash(np);
+
+  bool advance = np->connected && np->tick < np->remote_next + NETPLAY_MAX_ROLLBACK &&
+                 np->tick - np->peer_ack < NETPLAY_INPUT_RING - 1;
+  if (advance) {
+    np->local_inputs[np->tick % NETPLAY_INPUT_RING] = local_input & NETPLAY_INPUT_MASK;
+    netplay_simulate(np, np->tick);
+    np->tick++;
+    netplay_update_hash(np);
+  } else {
+    np->stats.stalls++;
+  }
+  netplay_send(np);
+  return advance;
+}
@@ -0,0 +1,93 @@
+#ifndef NETPLAY_H
+#define NETPLAY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Partida entre duas placas por um enlace serial, em lockstep determinístico
+// com rollback. Só as entradas de cada tick (12 bits) trafegam; os dois lados
+// simulam o mesmo estado a partir das mesmas entradas. A entrada local entra
+// no tick em que foi lida (sem atraso); a remota que ainda não chegou é
+// prevista repetindo a última conhecida. Quando a verdadeira chega diferente,
+// o estado volta ao instantâneo daquele tick e os ticks seguintes são
+// simulados de novo. A simulação para (stall) se correr mais de
+// NETPLAY_MAX_ROLLBACK ticks à frente das entradas remotas.
+//
+// Pacote (bytes, valores de 16 bits em little-endian):
+//   0xA5 | primeiro tick (16) | ack (16) | flags | [tick (16) + hash (32)] | entradas | CRC-8
+// flags: bits 0-4 = número de entradas, bit 5 = HELLO, bit 6 = jogador de
+// quem envia, bit 7 = hash presente. As entradas vão de 12 em 12 bits, duas
+// a cada 3 bytes. O ack é o próximo tick que o remetente espera receber, e
+// cada pacote repete todas as entradas ainda sem ack, então pacotes perdidos
+// ou corrompidos (descartados pelo CRC) são cobertos pelos seguintes. No
+// HELLO, os campos de tick e ack levam um número aleatório do remetente: o
+// menor fica com o jogador 0 (raquete esquerda).
+
+#define NETPLAY_MAX_ROLLBACK 8                        // Ticks à frente das entradas remotas antes de parar
+#define NETPLAY_SNAPSHOTS (NETPLAY_MAX_ROLLBACK + 2)  // Instantâneos guardados (estado antes de cada tick)
+#define NETPLAY_INPUT_RING 32                         // Potência de 2, maior que 2 * NETPLAY_MAX_ROLLBACK + 2
+#define NETPLAY_MAX_INPUTS 31                         // Entradas por pacote
+#define NETPLAY_HASH_TICKS 32                         // Intervalo entre hashes trocados para detectar divergência
+#define NETPLAY_HASH_HISTORY 4
+#define NETPLAY_PACKET_MAX (6 + 6 + (NETPLAY_MAX_INPUTS * 3 + 1) / 2 + 1)
+#define NETPLAY_INPUT_MASK 0x0FFF
+
+typedef void (*netplay_step_t)(void *state, const uint16_t inputs[2]);
+typedef uint32_t (*netplay_hash_t)(const void *state);
+// Leitura sem bloquear (retorna quantos bytes leu) e escrita do enlace
+typedef size_t (*netplay_read_t)(void *io, uint8_t *data, size_t len);
+typedef void (*netplay_write_t)(void *io, const uint8_t *data, size_t len);
+
+typedef struct {
+  uint32_t stalls;                  // Chamadas de netplay_tick que não avançaram
+  uint32_t rollbacks;
+  uint32_t resimulated;             // Ticks simulados de novo, no total
+  uint32_t max_resimulated;         // Maior rollback, em ticks
+  uint32_t packets_sent, packets_received;
+  uint32_t bytes_sent, bytes_received;
+  uint32_t bad_packets;             // CRC ou tamanho inválido
+  uint32_t hash_checks, desyncs;
+  uint32_t first_desync_tick;
+} netplay_stats_t;
+
+typedef struct {
+  void *state;
+  size_t state_size;
+  uint8_t *snapshots;               // NETPLAY_SNAPSHOTS * state_size bytes
+  netplay_step_t step;
+  netplay_hash_t hash;
+  netplay_read_t read;
+  netplay_write_t write;
+  void *io;
+  uint32_t nonce;
+
+  bool connected;
+  uint8_t local;                    // Jogador local: 0 (esquerda) ou 1 (direita)
+  uint32_t tick;                    // Próximo tick a simular
+  uint32_t remote_next;             // Entradas remotas conhecidas para os ticks < remote_next
+  uint32_t peer_ack;                // O outro lado tem as entradas locais dos ticks < peer_ack
+  uint32_t rollback_from;           // Primeiro tick previsto errado (UINT32_MAX se nenhum)
+  uint16_t local_inputs[NETPLAY_INPUT_RING];
+  uint16_t remote_inputs[NETPLAY_INPUT_RING];
+  uint16_t used_remote[NETPLAY_INPUT_RING];   // Entrada remota com que cada tick foi simulado
+
+  uint32_t next_hash_tick;
+  uint32_t hash_ticks[NETPLAY_HASH_HISTORY], hashes[NETPLAY_HASH_HISTORY];
+  uint32_t hash_count;
+  uint32_t last_checked_tick;
+
+  uint8_t rx[NETPLAY_PACKET_MAX];
+  size_t rx_len;
+  netplay_stats_t stats;
+} netplay_t;
+
+// state é o estado do jogo, já inicializado igual nos dois lados; nonce
+// deve diferir entre as placas (ex.: id único da placa)
+void netplay_init(netplay_t *np, void *state, size_t state_size, uint8_t *snapshots, netplay_step_t step,
+                  netplay_hash_t hash, netplay_read_t read, netplay_write_t write, void *io, uint32_t nonce);
+bool netplay_tick(netplay_t *np, uint16_t local_input);
+void netplay_poll(netplay_t *np);
+uint32_t netplay_confirmed(const netplay_t *np);
+
+#endif
@@ -0,0 +1,155 @@
+#include "physics.h"
+
+// Instante de impacto "nenhum": maior que qualquer fração de tick
+#define PHYS_NO_HIT INT32_MAX
+
+typedef enum {
+  PHYS_CONTACT_NONE,
+  PHYS_CONTACT_TOP,
+  PHYS_CONTACT_BOTTOM,
+  PHYS_CONTACT_LEFT,
+  PHYS_CONTACT_RIGHT
+} phys_contact_t;
+
+// Velocidade horizontal depois de 'rally' rebatidas
+q16_t phys_speed(const phys_config_t *cfg, uint16_t rally) {
+  int64_t speed = cfg->speed_base + (int64_t)cfg->speed_step * rally;
+  return speed > cfg->speed_max ? cfg->speed_max : (q16_t)speed;
+}
+
+// Bola no centro do campo saindo na direção (dir_x, dir_y), a 45 graus
+void phys_serve(const phys_config_t *cfg, phys_ball_t *ball, int dir_x, int dir_y) {
+  ball->x = (cfg->width - ball->size) / 2;
+  ball->y = (cfg->height - ball->size) / 2;
+  ball->rally = 0;
+  ball->vx = dir_x < 0 ? -cfg->speed_base : cfg->speed_base;
+  ball->vy = dir_y < 0 ? -cfg->speed_base : cfg->speed_base;
+}
+
+// Fração do tick (0..remaining) em que a coordenada pos, andando vel por
+// tick, alcança target; PHYS_NO_HIT se não alcança dentro do tempo restante.
+// Se já passou do alvo na direção do movimento, o contato é imediato.
+static q16_t phys_time_to(q16_t pos, q16_t vel, q16_t target, q16_t remaining) {
+  q16_t dist = target - pos;
+  if (vel == 0)
+    return PHYS_NO_HIT;
+  if (dist != 0 && (dist > 0) != (vel > 0))
+    return 0;
+  int64_t t = q16_widen(dist) / vel;
+  return t <= remaining ? (q16_t)t : PHYS_NO_HIT;
+}
+
+// Impacto contra a face interna da raquete: a bola precisa estar na frente
+// da face e, no instante do impacto, sobrepor a raquete verticalmente
+static q16_t phys_paddle_toi(const phys_ball_t *ball, const phys_box_t *pad, bool left, q16_t remaining) {
+  q16_t t;
+  if (left) {
+    q16_t face = pad->x + pad->w;
+    if (ball->vx >= 0 || ball->x < face)
+      return PHYS_NO_HIT;
+    t = phys_time_to(ball->x, ball->vx, face, remaining);
+  } else {
+    q16_t face = pad->x;
+    if (ball->vx <= 0 || ball->x + ball->size > face)
+      return PHYS_NO_HIT;
+    t = phys_time_to(ball->x + ball->size, ball->vx, face, remaining);
+  }
+  if (t == PHYS_NO_HIT)
+    return PHYS_NO_HIT;
+
+  q16_t y = ball->y + q16_mul(ball->vy, t);
+  if (y + ball->size < pad->y || y > pad->y + pad->h)
+    return PHYS_NO_HIT;
+  return t;
+}
+
+// Reflexão na raquete: o ângulo de saída depende da distância entre o centro
+// da bola e o centro da raquete, e a velocidade cresce a cada rebatida
+static void phys_paddle_bounce(const phys_config_t *cfg, phys_ball_t *ball, const phys_box_t *pad, bool left) {
+  q16_t reach = (pad->h + ball->size) / 2;
+  q16_t offset = (ball->y + ball->size / 2) - (pad->y + pad->h / 2);
+  q16_t ratio = q16_div(offset, reach);
+  if (ratio > Q16_ONE)
+    ratio = Q16_ONE;
+  if (ratio < -Q16_ONE)
+    ratio = -Q16_ONE;
+
+  if (ball->rally < UINT16_MAX)
+    ball->rally++;
+  q16_t speed = phys_speed(cfg, ball->rally);
+  ball->vx = left ? speed : -speed;
+  ball->vy = q16_mul(q16_mul(speed, cfg->max_slope), ratio);
+}
+
+// Avança a bola um tick. Resolve até PHYS_MAX_CONTACTS impactos em ordem de
+// tempo; cada um leva a bola exatamente ao ponto de contato antes de refletir.
+// O tempo que sobrar depois do último contato permitido é descartado.
+// Retorna a combinação de phys_event_t ocorridos.
+unsigned phys_step(const phys_config_t *cfg, phys_ball_t *ball, const phys_box_t paddles[PHYS_PADDLE_COUNT]) {
+  unsigned events = PHYS_EVENT_NONE;
+  q16_t remaining = Q16_ONE;
+
+  for (int contact = 0; contact < PHYS_MAX_CONTACTS && remaining > 0; ++contact) {
+    q16_t toi = PHYS_NO_HIT, t;
+    phys_contact_t hit = PHYS_CONTACT_NONE;
+
+    if (ball->vy < 0 && (t = phys_time_to(ball->y, ball->vy, 0, remaining)) < toi) {
+      toi = t;
+      hit = PHYS_CONTACT_TOP;
+    }
+    if (ball->vy > 0 && (t = phys_time_to(ball->y + ball->size, ball->vy, cfg->height, remaining)) < toi) {
+      toi = t;
+      hit = PHYS_CONTACT_BOTTOM;
+    }
+    if ((t = phys_paddle_toi(ball, &paddles[PHYS_PADDLE_LEFT], true, remaining)) < toi) {
+      toi = t;
+      hit = PHYS_CONTACT_LEFT;
+    }
+    if ((t = phys_paddle_toi(ball, &paddles[PHYS_PADDLE_RIGHT], false, remaining)) < toi) {
+      toi = t;
+      hit = PHYS_CONTACT_RIGHT;
+    }
+
+    if (hit == PHYS_CONTACT_NONE) {
+      ball->x += q16_mul(ball->vx, remaining);
+      ball->y += q16_mul(ball->vy, remaining);
+      break;
+    }
+
+    ball->x += q16_mul(ball->vx, toi);
+    ball->y += q16_mul(ball->vy, toi);
+    remaining -= toi;
+
+    switch (hit) {
+      case PHYS_CONTACT_TOP:
+        ball->y = 0;
+        ball->vy = -ball->vy;
+        events |= PHYS_EVENT_WALL;
+        break;
+      case PHYS_CONTACT_BOTTOM:
+        ball->y = cfg->height - ball->size;
+        ball->vy = -ball->vy;
+        events |= PHYS_EVENT_WALL;
+        break;
+      case PHYS_CONTACT_LEFT:
+        ball->x = paddles[PHYS_PADDLE_LEFT].x + paddles[PHYS_PADDLE_LEFT].w;
+        phys_paddle_bounce(cfg, ball, &paddles[PHYS_PADDLE_LEFT], true);
+        events |= PHYS_EVENT_HIT_LEFT;
+        break;
+      case PHYS_CONTACT_RIGHT:
+        ball->x = paddles[PHYS_PADDLE_RIGHT].x - ball->size;
+        phys_paddle_bounce(cfg, ball, &paddles[PHYS_PADDLE_RIGHT], false);
+        events |= PHYS_EVENT_HIT_RIGHT;
+        break;
+      default:
+        break;
+    }
+  }
+
+
+  if (ball->x + ball->size <= 0)
+    events |= PHYS_EVENT_OUT_LEFT;
+  else if (ball->x >= cfg->width)
+    events |= PHYS_EVENT_OUT_RIGHT;
+  return events;
+}
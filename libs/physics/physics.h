@@ -0,0 +1,76 @@
+#ifndef PHYSICS_H
+#define PHYSICS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Física da bola em ponto fixo Q16.16 (sem FPU; o Cortex-M0+ não tem).
+// As colisões são contínuas: a cada tick o movimento é varrido contra as
+// paredes e as faces das raquetes, com o instante exato de impacto, então a
+// bola não atravessa a raquete em nenhuma velocidade.
+
+typedef int32_t q16_t;
+
+#define Q16_SHIFT 16
+#define Q16_ONE ((q16_t)1 << Q16_SHIFT)
+#define Q16_FROM_INT(i) ((q16_t)(i) * Q16_ONE)
+#define Q16_TO_INT(q) ((int)((q) >> Q16_SHIFT))
+#define Q16_FRAC(num, den) ((q16_t)((int64_t)(num) * Q16_ONE / (den)))
+
+// Limite de contatos resolvidos por tick; mantém o custo por tick fixo
+#define PHYS_MAX_CONTACTS 4
+
+typedef struct {
+  q16_t x, y;                       // Canto superior esquerdo
+  q16_t w, h;
+} phys_box_t;
+
+typedef struct {
+  q16_t x, y;                       // Canto superior esquerdo
+  q16_t vx, vy;                     // Deslocamento por tick
+  q16_t size;
+  uint16_t rally;                   // Rebatidas desde o último ponto
+} phys_ball_t;
+
+typedef struct {
+  q16_t width, height;              // Campo
+  q16_t speed_base;                 // Velocidade horizontal no saque
+  q16_t speed_step;                 // Acréscimo por rebatida
+  q16_t speed_max;
+  q16_t max_slope;                  // |vy| / |vx| máximo na borda da raquete
+} phys_config_t;
+
+enum {
+  PHYS_PADDLE_LEFT,
+  PHYS_PADDLE_RIGHT,
+  PHYS_PADDLE_COUNT
+};
+
+typedef enum {
+  PHYS_EVENT_NONE = 0,
+  PHYS_EVENT_WALL = 1 << 0,
+  PHYS_EVENT_HIT_LEFT = 1 << 1,
+  PHYS_EVENT_HIT_RIGHT = 1 << 2,
+  PHYS_EVENT_OUT_LEFT = 1 << 3,     // Bola saiu pela esquerda (ponto da direita)
+  PHYS_EVENT_OUT_RIGHT = 1 << 4     // Bola saiu pela direita (ponto da esquerda)
+} phys_event_t;
+
+static inline q16_t q16_mul(q16_t a, q16_t b) {
+  return (q16_t)(((int64_t)a * b) >> Q16_SHIFT);
+}
+
+// a com mais 16 bits de fração, para dividir por outro Q16.16. Multiplica
+// em vez de deslocar: deslocar um negativo para a esquerda é indefinido em C
+static inline int64_t q16_widen(q16_t a) {
+  return (int64_t)a * Q16_ONE;
+}
+
+static inline q16_t q16_div(q16_t a, q16_t b) {
+  return (q16_t)(q16_widen(a) / b);
+}
+
+void phys_serve(const phys_config_t *cfg, phys_ball_t *ball, int dir_x, int dir_y);
+q16_t phys_speed(const phys_config_t *cfg, uint16_t rally);
+unsigned phys_step(const phys_config_t *cfg, phys_ball_t *ball, const phys_box_t paddles[PHYS_PADDLE_COUNT]);
+
+#endif
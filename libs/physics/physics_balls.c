@@ -0,0 +1,103 @@
+#include "physics_balls.h"
+
+// Folga da fase larga: phys_step trunca o instante de contato e pode contar
+// o toque numa face que a bola só alcançaria um pouco depois do fim do tick
+#define PHYS_BALLS_SLACK (Q16_ONE >> 12)
+
+void phys_balls_serve(const phys_config_t *cfg, phys_balls_t *balls, unsigned i, int dir_x, int dir_y) {
+  q16_t lane = (cfg->height - balls->size) / balls->count;
+  q16_t speed = cfg->speed_base;
+
+  balls->x[i] = (cfg->width - balls->size) / 2;
+  balls->y[i] = lane * i + lane / 2;
+  balls->rally[i] = 0;
+  balls->vx[i] = dir_x < 0 ? -speed : speed;
+  speed = speed / 3 * (1 + i % 3);                          // 1/3, 2/3 ou toda a inclinação do saque simples
+  balls->vy[i] = dir_y < 0 ? -speed : speed;
+}
+
+void phys_balls_get(const phys_balls_t *balls, unsigned i, phys_ball_t *ball) {
+  ball->x = balls->x[i];
+  ball->y = balls->y[i];
+  ball->vx = balls->vx[i];
+  ball->vy = balls->vy[i];
+  ball->size = balls->size;
+  ball->rally = balls->rally[i];
+}
+
+void phys_balls_set(phys_balls_t *balls, unsigned i, const phys_ball_t *ball) {
+  balls->x[i] = ball->x;
+  balls->y[i] = ball->y;
+  balls->vx[i] = ball->vx;
+  balls->vy[i] = ball->vy;
+  balls->rally[i] = ball->rally;
+}
+
+// Um tick para todas as bolas:
+//  1. fase larga: as bolas que cruzam a face de alguma raquete vão para uma
+//     lista e andam por phys_step, que acha o instante exato do contato (ou
+//     vê que passaram por cima ou por baixo);
+//  2. as outras andam o tick inteiro (máscara em vez de desvio);
+//  3. paredes por reflexão: |vy| é limitado pela inclinação máxima, então há
+//     no máximo um choque com parede por tick. As da lista já estão dentro
+//     do campo e não mudam;
+//  4. saída pelos lados.
+void phys_balls_step(const phys_config_t *cfg, phys_balls_t *balls, const phys_box_t paddles[PHYS_PADDLE_COUNT],
+                     phys_balls_result_t *result) {
+  const unsigned n = balls->count;
+  const q16_t size = balls->size;
+  const q16_t face_left = paddles[PHYS_PADDLE_LEFT].x + paddles[PHYS_PADDLE_LEFT].w;
+  const q16_t face_right = paddles[PHYS_PADDLE_RIGHT].x - size;      // Canto esquerdo da bola ao tocar a face
+  const q16_t reach_left = face_left + PHYS_BALLS_SLACK, reach_right = face_right - PHYS_BALLS_SLACK;
+  const q16_t floor = cfg->height - size;
+  q16_t *x = balls->x, *y = balls->y, *vx = balls->vx, *vy = balls->vy;
+  uint8_t near[PHYS_BALLS_MAX], list[PHYS_BALLS_MAX];
+  unsigned candidates = 0, events = PHYS_EVENT_NONE;
+
+  for (unsigned i = 0; i < n; ++i) {
+    q16_t to = x[i] + vx[i];
+    near[i] = (x[i] >= face_left && to <= reach_left) | (x[i] <= face_right && to >= reach_right);
+    if (near[i])                                                     // Raro: poucas bolas por tick
+      list[candidates++] = i;
+  }
+  for (unsigned k = 0; k < candidates; ++k) {
+    phys_ball_t ball;
+    phys_balls_get(balls, list[k], &ball);
+    events |= phys_step(cfg, &ball, paddles);
+    phys_balls_set(balls, list[k], &ball);
+  }
+  events &= ~(PHYS_EVENT_OUT_LEFT | PHYS_EVENT_OUT_RIGHT);          // Refeitas abaixo para todas
+
+  for (unsigned i = 0; i < n; ++i) {
+    q16_t move = (q16_t)near[i] - 1;                                 // 0 nas da lista, todos os bits nas outras
+    x[i] += vx[i] & move;
+    y[i] += vy[i] & move;
+  }
+
+  q16_t walls = 0;
+  for (unsigned i = 0; i < n; ++i) {
+    q16_t over = y[i] < 0 ? y[i] : y[i] > floor ? y[i] - floor : 0;  // Quanto passou da parede
+    y[i] -= 2 * over;
+    vy[i] = over ? -vy[i] : vy[i];
+    walls |= over;
+  }
+  if (walls)
+    events |= PHYS_EVENT_WALL;
+
+  uint64_t out_left = 0, out_right = 0;
+  for (unsigned i = 0; i < n; ++i) {
+    if (x[i] + size <= 0)
+      out_left |= (uint64_t)1 << i;
+    else if (x[i] >= cfg->width)
+      out_right |= (uint64_t)1 << i;
+  }
+  if (out_left)
+    events |= PHYS_EVENT_OUT_LEFT;
+  if (out_right)
+    events |= PHYS_EVENT_OUT_RIGHT;
+
+  result->events = events;
+  result->out_left = out_left;
+  result->out_right = out_right;
+  result->candidates = candidates;
+}
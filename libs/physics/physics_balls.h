@@ -0,0 +1,41 @@
+#ifndef PHYSICS_BALLS_H
+#define PHYSICS_BALLS_H
+
+#include "physics.h"
+
+// Várias bolas num só conjunto, em estrutura de vetores: cada coordenada
+// fica num vetor próprio, e as passadas (movimento, paredes, saída do campo)
+// são laços curtos sobre os vetores, sem desvio por bola. Todas têm o mesmo
+// tamanho. A fase larga separa só as bolas cuja varredura horizontal cruza a
+// face de uma raquete neste tick; essas (poucas) passam pela colisão
+// contínua de phys_step, e as outras só andam e refletem nas paredes. As
+// bolas que saem do campo voltam em máscaras de bits (uint64_t, daí o
+// limite de PHYS_BALLS_MAX).
+
+#define PHYS_BALLS_MAX 64
+
+typedef struct {
+  q16_t x[PHYS_BALLS_MAX];          // Canto superior esquerdo
+  q16_t y[PHYS_BALLS_MAX];
+  q16_t vx[PHYS_BALLS_MAX];         // Deslocamento por tick
+  q16_t vy[PHYS_BALLS_MAX];
+  uint16_t rally[PHYS_BALLS_MAX];   // Rebatidas desde o último saque da bola
+  q16_t size;
+  uint8_t count;
+} phys_balls_t;
+
+typedef struct {
+  unsigned events;                  // Combinação de phys_event_t de todas as bolas
+  uint64_t out_left, out_right;     // Bolas que saíram por cada lado
+  uint8_t candidates;               // Bolas que passaram pela colisão contínua
+} phys_balls_result_t;
+
+// Saque da bola i: centro horizontal, numa faixa vertical própria (as
+// bolas não saem empilhadas) e com inclinação que varia com i
+void phys_balls_serve(const phys_config_t *cfg, phys_balls_t *balls, unsigned i, int dir_x, int dir_y);
+void phys_balls_get(const phys_balls_t *balls, unsigned i, phys_ball_t *ball);
+void phys_balls_set(phys_balls_t *balls, unsigned i, const phys_ball_t *ball);
+void phys_balls_step(const phys_config_t *cfg, phys_balls_t *balls, const phys_box_t paddles[PHYS_PADDLE_COUNT],
+                     phys_balls_result_t *result);
+
+#endif
@@ -0,0 +1,105 @@
+#include <string.h>
+#include "profiler.h"
+#if PICO_ON_DEVICE
+#include "hardware/clocks.h"
+#else
+#include <time.h>
+#endif
+
+// Sem PROFILER_ENABLED não sobra nada: nem os anéis na RAM
+#if PROFILER_ENABLED
+
+profiler_ring_t profiler_rings[PROFILER_CORES];
+volatile bool profiler_running;
+
+#define PROFILER_ZONE_NAME(id, name) name,
+static const char *const profiler_zone_names[PROF_ZONE_COUNT] = { PROFILER_ZONES(PROFILER_ZONE_NAME) };
+#undef PROFILER_ZONE_NAME
+
+#if PICO_ON_DEVICE
+
+void profiler_init_core(void) {
+  systick_hw->csr = 0;
+  systick_hw->rvr = PROFILER_CYCLE_MASK;    // Volta inteira de 24 bits
+  systick_hw->cvr = 0;
+  systick_hw->csr = 0x5;                    // Ligado, relógio do processador, sem interrupção
+  profiler_running = true;
+}
+
+uint32_t profiler_cycle_hz(void) {
+  return clock_get_hz(clk_sys);
+}
+
+#else
+
+static uint64_t profiler_host_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+uint32_t profiler_core(void) {
+  return 0;
+}
+
+uint32_t profiler_time_us(void) {
+  return (uint32_t)(profiler_host_ns() / 1000);
+}
+
+uint32_t profiler_cycles(void) {
+  return (uint32_t)profiler_host_ns();
+}
+
+void profiler_init_core(void) {
+  profiler_running = true;
+}
+
+uint32_t profiler_cycle_hz(void) {
+  return 1000000000u;
+}
+
+#endif
+
+void profiler_reset(void) {
+  for (unsigned core = 0; core < PROFILER_CORES; ++core)
+    profiler_rings[core].head = 0;
+}
+
+static void profiler_put32(uint8_t *out, uint32_t value) {
+  for (int i = 0; i < 4; ++i)
+    out[i] = value >> (8 * i);
+}
+
+void profiler_dump(profiler_write_t write, void *ctx) {
+  uint8_t header[12] = { 'P', 'P', 'R', 'F', PROFILER_VERSION, PROF_ZONE_COUNT, PROFILER_CORES, 0 };
+  bool running = profiler_running;
+
+  profiler_running = false;
+  profiler_put32(&header[8], profiler_cycle_hz());
+  write(ctx, header, sizeof(header));
+  for (unsigned zone = 0; zone < PROF_ZONE_COUNT; ++zone) {
+    uint8_t len = strlen(profiler_zone_names[zone]);
+    write(ctx, &len, 1);
+    write(ctx, (const uint8_t *)profiler_zone_names[zone], len);
+  }
+
+  for (unsigned core = 0; core < PROFILER_CORES; ++core) {
+    const profiler_ring_t *ring = &profiler_rings[core];
+    uint32_t count = ring->head < PROFILER_EVENTS ? ring->head : PROFILER_EVENTS;
+    uint8_t word[8];
+    profiler_put32(word, count);
+    write(ctx, word, 4);
+    for (uint32_t i = ring->head - count; i != ring->head; ++i) {
+      const profiler_event_t *event = &ring->events[i % PROFILER_EVENTS];
+      profiler_put32(word, event->time_us);
+      profiler_put32(word + 4, event->tag);
+      write(ctx, word, sizeof(word));
+    }
+  }
+  write(ctx, (const uint8_t *)"FRPP", 4);
+
+  profiler_reset();
+  profiler_running = running;
+}
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "pico/stdlib.h"
+#if PICO_ON_DEVICE
+#include "hardware/structs/systick.h"
+#include "hardware/structs/timer.h"
+#endif
+
+// Perfil por zonas: PROF_BEGIN/PROF_END gravam um evento de 8 bytes num
+// anel em RAM, um anel por núcleo (sem travas). Cada evento leva o timer de
+// 1 us do RP2040 e os 24 bits de baixo do SysTick, que conta ciclos de
+// clk_sys (o M0+ não tem DWT); o conversor usa os ciclos entre eventos
+// próximos e o timer quando o SysTick pode ter dado a volta (~134 ms a
+// 125 MHz). Sem PROFILER_ENABLED, as macros somem do código. O anel guarda
+// os PROFILER_EVENTS eventos mais recentes de cada núcleo.
+//
+// Exportação (valores em little-endian):
+//   "PPRF" | versão (8) | zonas (8) | núcleos (8) | 0 | Hz dos ciclos (32)
+//   por zona: tamanho (8) + nome
+//   por núcleo: eventos (32) + eventos do mais antigo ao mais novo
+//   "FRPP"
+// Evento: tempo em us (32) | ciclos (bits 0-23), zona (24-30), fim (31).
+
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 0
+#endif
+
+#ifndef PROFILER_EVENTS
+#define PROFILER_EVENTS 1024                // Eventos por núcleo (potência de 2)
+#endif
+#define PROFILER_CORES 2
+#define PROFILER_VERSION 1
+#define PROFILER_CYCLE_MASK 0x00FFFFFFu
+#define PROFILER_ZONE_SHIFT 24
+#define PROFILER_END_BIT 0x80000000u
+
+// Zonas instrumentadas: nome no código e no trace (no máximo 128)
+#define PROFILER_ZONES(X)                                     \
+  X(PROF_PASSO_SIMULACAO, "passo_simulacao")                  \
+  X(PROF_ATUALIZAR_IA, "atualizar_ia")                        \
+  X(PROF_ATUALIZAR_BOLA, "atualizar_bola")                    \
+  X(PROF_RENDERIZAR_QUADRO, "renderizar_quadro")              \
+  X(PROF_DESENHAR_JOGO, "desenhar_jogo")                      \
+  X(PROF_COPIAR_CENA, "copiar_cena")                          \
+  X(PROF_SSD1306_FILL, "ssd1306_fill")                        \
+  X(PROF_SSD1306_DRAW_STRING, "ssd1306_draw_string")          \
+  X(PROF_SSD1306_SEND_DATA, "ssd1306_send_data")              \
+  X(PROF_SSD1306_SEND_DATA_ASYNC, "ssd1306_send_data_async")  \
+  X(PROF_SSD1306_WAIT, "ssd1306_wait")                        \
+  X(PROF_TRANSMITIR_QUADRO, "transmitir_quadro")
+
+#define PROFILER_ZONE_ENUM(id, name) id,
+typedef enum { PROFILER_ZONES(PROFILER_ZONE_ENUM) PROF_ZONE_COUNT } profiler_zone_t;
+#undef PROFILER_ZONE_ENUM
+
+typedef struct {
+  uint32_t time_us;
+  uint32_t tag;                             // Ciclos, zona e fim
+} profiler_event_t;
+
+typedef struct {
+  uint32_t head;                            // Eventos gravados desde o início (o índice é head % PROFILER_EVENTS)
+  profiler_event_t events[PROFILER_EVENTS];
+} profiler_ring_t;
+
+typedef void (*profiler_write_t)(void *ctx, const uint8_t *data, size_t len);
+
+extern profiler_ring_t profiler_rings[PROFILER_CORES];
+extern volatile bool profiler_running;
+
+#if PICO_ON_DEVICE
+static inline uint32_t profiler_core(void) { return get_core_num(); }
+static inline uint32_t profiler_time_us(void) { return timer_hw->timerawl; }
+// SysTick conta para baixo; invertido, os ciclos crescem como o tempo
+static inline uint32_t profiler_cycles(void) { return ~systick_hw->cvr; }
+#else
+uint32_t profiler_core(void);
+uint32_t profiler_time_us(void);
+uint32_t profiler_cycles(void);             // Nanossegundos de parede no host
+#endif
+
+static inline void profiler_record(uint32_t tag) {
+  if (!profiler_running)
+    return;
+  profiler_ring_t *ring = &profiler_rings[profiler_core()];
+  profiler_event_t *event = &ring->events[ring->head++ % PROFILER_EVENTS];
+  event->time_us = profiler_time_us();
+  event->tag = (profiler_cycles() & PROFILER_CYCLE_MASK) | tag;
+}
+
+// Liga o SysTick do núcleo que chama (cada núcleo tem o seu) e começa a gravar
+void profiler_init_core(void);
+void profiler_reset(void);
+uint32_t profiler_cycle_hz(void);
+// Pausa a gravação enquanto exporta; depois zera os anéis e continua
+void profiler_dump(profiler_write_t write, void *ctx);
+
+#if PROFILER_ENABLED
+#define PROF_INIT_CORE() profiler_init_core()
+#define PROF_BEGIN(zone) profiler_record((uint32_t)(zone) << PROFILER_ZONE_SHIFT)
+#define PROF_END(zone) profiler_record((uint32_t)(zone) << PROFILER_ZONE_SHIFT | PROFILER_END_BIT)
+#else
+#define PROF_INIT_CORE() ((void)0)
+#define PROF_BEGIN(zone) ((void)0)
+#define PROF_END(zone) ((void)0)
+#endif
+
+#endif
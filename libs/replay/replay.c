@@ -0,0 +1,186 @@
+#include <stdio.h>
+#include <string.h>
+#include "replay.h"
+
+#define REPLAY_FNV_OFFSET 2166136261u
+#define REPLAY_FNV_PRIME 16777619u
+
+void replay_init(replay_t *r, void *snapshot, size_t state_size, uint16_t *words, uint32_t capacity,
+                 replay_checkpoint_t *checkpoints, uint32_t checkpoint_capacity) {
+  r->snapshot = snapshot;
+  r->state_size = state_size;
+  r->words = words;
+  r->capacity = capacity;
+  r->checkpoints = checkpoints;
+  r->checkpoint_capacity = checkpoint_capacity;
+  r->len = r->checkpoints_len = r->ticks = 0;
+  r->final_hash = 0;
+  r->recording = r->full = false;
+}
+
+// FNV-1a; com hash = 0 começa do valor inicial padrão
+uint32_t replay_hash_bytes(uint32_t hash, const void *data, size_t len) {
+  const uint8_t *bytes = data;
+  if (!hash)
+    hash = REPLAY_FNV_OFFSET;
+  while (len--) {
+    hash ^= *bytes++;
+    hash *= REPLAY_FNV_PRIME;
+  }
+  return hash;
+}
+
+void replay_start(replay_t *r, const void *state) {
+  memcpy(r->snapshot, state, r->state_size);
+  r->len = r->checkpoints_len = r->ticks = 0;
+  r->final_hash = 0;
+  r->full = false;
+  r->recording = true;
+}
+
+// Registra a entrada do tick e o hash do estado depois dele. Retorna false
+// (e encerra a gravação) quando não há mais espaço.
+bool replay_record(replay_t *r, uint16_t input, uint32_t hash) {
+  if (!r->recording)
+    return false;
+
+  input &= REPLAY_INPUT_MASK;
+  uint16_t *last = r->len ? &r->words[r->len - 1] : NULL;
+  bool repeat = last && (*last & REPLAY_INPUT_MASK) == input && (*last >> 12) < REPLAY_RUN_MAX - 1;
+  bool checkpoint = (r->ticks + 1) % REPLAY_CHECKPOINT_TICKS == 0;
+
+  if ((!repeat && r->len == r->capacity) || (checkpoint && r->checkpoints_len == r->checkpoint_capacity)) {
+    r->recording = false;
+    r->full = true;
+    return false;
+  }
+
+  if (repeat)
+    *last += 1 << 12;
+  else
+    r->words[r->len++] = input;
+  if (checkpoint) {
+    r->checkpoints[r->checkpoints_len].tick = r->ticks;
+    r->checkpoints[r->checkpoints_len++].hash = hash;
+  }
+  r->ticks++;
+  r->final_hash = hash;
+  return true;
+}
+
+void replay_stop(replay_t *r) {
+  r->recording = false;
+}
+
+// Reproduz a sessão sobre state (sobrescrito com o instantâneo inicial)
+void replay_run(const replay_t *r, void *state, replay_step_t step, replay_hash_t hash, replay_result_t *result) {
+  uint32_t tick = 0, next = 0;
+
+  memset(result, 0, sizeof(*result));
+  memcpy(state, r->snapshot, r->state_size);
+
+  for (uint32_t i = 0; i < r->len && tick < r->ticks; ++i) {
+    uint16_t input = r->words[i] & REPLAY_INPUT_MASK;
+    uint32_t repeat = (r->words[i] >> 12) + 1;
+
+    while (repeat-- && tick < r->ticks) {
+      step(state, input);
+      uint32_t h = hash(state);
+      result->chain = replay_hash_bytes(result->chain, &h, sizeof(h));
+
+      uint32_t expected = h;
+      if (next < r->checkpoints_len && r->checkpoints[next].tick == tick) {
+        expected = r->checkpoints[next++].hash;
+        result->checked++;
+      } else if (tick + 1 == r->ticks) {
+        expected = r->final_hash;
+        result->checked++;
+      }
+      if (h != expected) {
+        if (!result->mismatches)
+          result->first_mismatch_tick = tick;
+        result->mismatches++;
+      }
+      tick++;
+    }
+  }
+  result->ticks = tick;
+}
+
+// Texto para copiar pelo stdio: cabeçalho, instantâneo serializado, palavras
+// e pontos de verificação, em hexadecimal, uma seção por linha
+void replay_dump(const replay_t *r, FILE *out, const uint8_t *snapshot, size_t snapshot_len) {
+  fprintf(out, "replay v%u ticks %lu words %lu checkpoints %lu state %lu final %08lx\n", REPLAY_FORMAT_VERSION,
+         (unsigned long)r->ticks, (unsigned long)r->len, (unsigned long)r->checkpoints_len,
+         (unsigned long)snapshot_len, (unsigned long)r->final_hash);
+  for (size_t i = 0; i < snapshot_len; ++i)
+    fprintf(out, "%02x", snapshot[i]);
+  fprintf(out, "\n");
+  for (uint32_t i = 0; i < r->len; ++i)
+    fprintf(out, "%04x", r->words[i]);
+  fprintf(out, "\n");
+  for (uint32_t i = 0; i < r->checkpoints_len; ++i)
+    fprintf(out, "%08lx%08lx", (unsigned long)r->checkpoints[i].tick, (unsigned long)r->checkpoints[i].hash);
+  fprintf(out, "\n");
+}
+
+static bool replay_hex(const char *hex, uint8_t *out, size_t len) {
+  for (size_t i = 0; i < len; ++i) {
+    unsigned v;
+    if (sscanf(hex + 2 * i, "%2x", &v) != 1)
+      return false;
+    out[i] = v;
+  }
+  return true;
+}
+
+// Linhas antes do cabeçalho (log do stdio) são ignoradas
+bool replay_load(replay_t *r, FILE *in, uint8_t *snapshot, size_t capacity, size_t *snapshot_len) {
+  char line[128];
+  unsigned version = 0;
+  unsigned long ticks, len, points, state, final;
+  int c;
+
+  while (fgets(line, sizeof(line), in)) {
+    bool whole = strchr(line, '\n') != NULL;
+    if (sscanf(line, "replay v%u", &version) == 1)
+      break;
+    while (!whole && (c = fgetc(in)) != EOF && c != '\n')
+      ;
+  }
+  if (version != REPLAY_FORMAT_VERSION) {
+    if (version)
+      fprintf(stderr, "gravação no formato v%u; este programa lê v%u\n", version, REPLAY_FORMAT_VERSION);
+    return false;
+  }
+  if (sscanf(line, "replay v%*u ticks %lu words %lu checkpoints %lu state %lu final %lx", &ticks, &len, &points,
+             &state, &final) != 5 ||
+      state > capacity || len > r->capacity || points > r->checkpoint_capacity)
+    return false;
+
+  // Cada seção numa linha só, lida aos pedaços de tamanho fixo
+  char hex[17] = { 0 };
+  for (unsigned long i = 0; i < state; ++i)
+    if (fscanf(in, " %2c", hex) != 1 || !replay_hex(hex, &snapshot[i], 1))
+      return false;
+  for (unsigned long i = 0; i < len; ++i) {
+    uint8_t b[2];
+    if (fscanf(in, " %4c", hex) != 1 || !replay_hex(hex, b, 2))
+      return false;
+    r->words[i] = b[0] << 8 | b[1];
+  }
+  for (unsigned long i = 0; i < points; ++i) {
+    unsigned long tick, hash;
+    if (fscanf(in, " %16c", hex) != 1 || sscanf(hex, "%8lx%8lx", &tick, &hash) != 2)
+      return false;
+    r->checkpoints[i].tick = tick;
+    r->checkpoints[i].hash = hash;
+  }
+  r->ticks = ticks;
+  r->len = len;
+  r->checkpoints_len = points;
+  r->final_hash = final;
+  r->recording = r->full = false;
+  *snapshot_len = state;
+  return true;
+}
@@ -0,0 +1,69 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// Gravação e reprodução determinística de uma sessão: guarda um instantâneo
+// do estado no início e a entrada de cada tick (12 bits), compactada em
+// palavras de 16 bits com repetição (4 bits de contagem), e o hash do estado
+// a cada REPLAY_CHECKPOINT_TICKS ticks. A reprodução roda o passo da
+// simulação sobre o instantâneo com as entradas gravadas, o mais rápido
+// possível, confere os hashes e mantém um hash encadeado de todos os ticks,
+// que identifica a sessão inteira (para comparar duas versões do código).
+//
+// O texto de replay_dump leva o instantâneo já serializado por quem chama
+// (campos de largura fixa, little-endian), não os bytes crus da struct, que
+// mudam com o tamanho dos enums e o preenchimento do compilador.
+
+#define REPLAY_INPUT_MASK 0x0FFF
+#define REPLAY_RUN_MAX 16                   // Ticks iguais por palavra
+#define REPLAY_CHECKPOINT_TICKS 64
+#define REPLAY_FORMAT_VERSION 2             // v1 guardava a struct crua
+
+typedef void (*replay_step_t)(void *state, uint16_t input);
+typedef uint32_t (*replay_hash_t)(const void *state);
+
+typedef struct {
+  uint32_t tick;
+  uint32_t hash;
+} replay_checkpoint_t;
+
+typedef struct {
+  uint8_t *snapshot;
+  size_t state_size;
+  uint16_t *words;
+  uint32_t capacity, len;
+  replay_checkpoint_t *checkpoints;
+  uint32_t checkpoint_capacity, checkpoints_len;
+  uint32_t ticks;
+  uint32_t final_hash;                      // Hash do estado após o último tick gravado
+  bool recording;
+  bool full;
+} replay_t;
+
+typedef struct {
+  uint32_t ticks;
+  uint32_t checked;                         // Pontos de verificação conferidos
+  uint32_t mismatches;
+  uint32_t first_mismatch_tick;
+  uint32_t chain;                           // Hash encadeado de todos os ticks
+} replay_result_t;
+
+// snapshot precisa ter state_size bytes; words e checkpoints, as capacidades dadas
+void replay_init(replay_t *r, void *snapshot, size_t state_size, uint16_t *words, uint32_t capacity,
+                 replay_checkpoint_t *checkpoints, uint32_t checkpoint_capacity);
+void replay_start(replay_t *r, const void *state);
+bool replay_record(replay_t *r, uint16_t input, uint32_t hash);
+void replay_stop(replay_t *r);
+void replay_run(const replay_t *r, void *state, replay_step_t step, replay_hash_t hash, replay_result_t *result);
+
+uint32_t replay_hash_bytes(uint32_t hash, const void *data, size_t len);
+void replay_dump(const replay_t *r, FILE *out, const uint8_t *snapshot, size_t snapshot_len);
+// Lê o texto de replay_dump: palavras e pontos em r, instantâneo serializado
+// em snapshot (até capacity bytes). Recusa outra versão do formato.
+bool replay_load(replay_t *r, FILE *in, uint8_t *snapshot, size_t capacity, size_t *snapshot_len);
+
+#endif
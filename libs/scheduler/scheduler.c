@@ -0,0 +1,207 @@
+#include <stdio.h>
+#include <string.h>
+#include "scheduler.h"
+
+// Ticks atrasados executados de uma vez antes de desistir e descartá-los
+#define SCHED_MAX_CATCHUP 4
+
+static const char *const sched_stage_names[SCHED_STAGE_COUNT] = {
+  "entrada", "ia", "fisica", "raster", "envio"
+};
+
+void sched_init(sched_t *s, uint32_t tick_us, uint32_t frame_us, sched_clock_t clock, void *clock_ctx) {
+  memset(s, 0, sizeof(*s));
+  s->clock = clock;
+  s->clock_ctx = clock_ctx;
+  s->tick_us = tick_us;
+  s->frame_us = frame_us;
+  s->max_catchup = SCHED_MAX_CATCHUP;
+  s->next_tick = s->next_frame = sched_now(s);
+  sched_reset_stats(s);
+}
+
+uint64_t sched_now(const sched_t *s) {
+  return s->clock(s->clock_ctx);
+}
+
+// Quantos ticks de simulação venceram até agora. Os prazos avançam em
+// múltiplos exatos de tick_us, então o atraso de um passo não se acumula
+// nos seguintes. Se o atraso passar de max_catchup ticks, o excesso é
+// descartado e contado como prazo perdido.
+uint32_t sched_ticks_due(sched_t *s) {
+  uint64_t now = sched_now(s);
+  if (now < s->next_tick)
+    return 0;
+
+  uint64_t due = (now - s->next_tick) / s->tick_us + 1;
+  if (due > s->max_catchup) {
+    s->missed_ticks += due - s->max_catchup;
+    due = s->max_catchup;
+    s->next_tick = now + s->tick_us;
+  } else {
+    s->next_tick += due * s->tick_us;
+  }
+  s->ticks += due;
+  return due;
+}
+
+// Indica se um quadro deve ser desenhado agora. Quadros cujo prazo já
+// passou inteiro são pulados (contados em dropped_frames).
+bool sched_frame_due(sched_t *s) {
+  uint64_t now = sched_now(s);
+  if (now < s->next_frame)
+    return false;
+
+  uint64_t late = (now - s->next_frame) / s->frame_us;
+  s->dropped_frames += late;
+  s->next_frame += (late + 1) * s->frame_us;
+
+  if (s->frames)
+    s->frame_times[s->frames & (SCHED_HISTORY - 1)] = now - s->last_frame_start;
+  s->last_frame_start = now;
+  s->frames++;
+  return true;
+}
+
+uint64_t sched_next_deadline(const sched_t *s) {
+  return s->next_tick < s->next_frame ? s->next_tick : s->next_frame;
+}
+
+// Troca a cadência (ex.: modo de espera em baixa taxa). Os prazos recomeçam
+// agora, sem contar como atraso o intervalo da cadência anterior.
+void sched_set_periods(sched_t *s, uint32_t tick_us, uint32_t frame_us) {
+  s->tick_us = tick_us;
+  s->frame_us = frame_us;
+  s->next_tick = s->next_frame = sched_now(s);
+}
+
+// O quadro vencido não mudou em relação ao último desenhado e foi pulado
+void sched_frame_unchanged(sched_t *s) {
+  s->unchanged_frames++;
+}
+
+void sched_sleep_begin(sched_t *s, unsigned core) {
+  s->duty[core].sleep_start = sched_now(s);
+}
+
+// Soma o sono à janela corrente; as janelas que terminaram no meio do sono
+// (ou antes dele, com o núcleo ocupado) são fechadas com a parte que lhes cabe
+void sched_sleep_end(sched_t *s, unsigned core) {
+  sched_duty_t *d = &s->duty[core];
+  uint64_t now = sched_now(s);
+  uint64_t from = d->sleep_start > d->window_start ? d->sleep_start : d->window_start;
+
+  d->total_slept_us += now - from;
+  while (now >= d->window_start + SCHED_DUTY_WINDOW_US) {
+    uint64_t end = d->window_start + SCHED_DUTY_WINDOW_US;
+    if (from < end) {
+      d->window_slept_us += end - from;
+      from = end;
+    }
+    d->last_active_permille = 1000 - (uint64_t)d->window_slept_us * 1000 / SCHED_DUTY_WINDOW_US;
+    d->last_wakeups = d->window_wakeups;
+    d->window_start = end;
+    d->window_slept_us = 0;
+    d->window_wakeups = 0;
+  }
+  d->window_slept_us += now - from;
+  d->window_wakeups++;
+  d->sleeps++;
+}
+
+void sched_stage_begin(sched_t *s, sched_stage_t stage) {
+  s->stage_start[stage] = sched_now(s);
+}
+
+void sched_stage_end(sched_t *s, sched_stage_t stage) {
+  uint32_t elapsed = sched_now(s) - s->stage_start[stage];
+  sched_stage_stats_t *st = &s->stages[stage];
+  st->count++;
+  st->total_us += elapsed;
+  if (elapsed > st->max_us)
+    st->max_us = elapsed;
+}
+
+void sched_report(const sched_t *s, sched_report_t *r) {
+  memset(r, 0, sizeof(*r));
+  r->frames = s->frames;
+  r->ticks = s->ticks;
+  r->missed_ticks = s->missed_ticks;
+  r->dropped_frames = s->dropped_frames;
+  r->unchanged_frames = s->unchanged_frames;
+
+  uint64_t now = sched_now(s);
+  for (int core = 0; core < SCHED_CORES; ++core) {
+    const sched_duty_t *d = &s->duty[core];
+    uint64_t elapsed = now - d->total_start;
+    r->active_permille[core] = d->last_active_permille;
+    r->wakeups_per_s[core] = d->last_wakeups;
+    r->average_active_permille[core] = elapsed ? 1000 - d->total_slept_us * 1000 / elapsed : 1000;
+  }
+
+  for (int i = 0; i < SCHED_STAGE_COUNT; ++i) {
+    const sched_stage_stats_t *st = &s->stages[i];
+    r->stage_avg_us[i] = st->count ? st->total_us / st->count : 0;
+    r->stage_max_us[i] = st->max_us;
+  }
+
+  // Intervalos entre quadros consecutivos, do mais antigo guardado ao atual
+  uint32_t n = s->frames > 1 ? s->frames - 1 : 0;
+  if (n > SCHED_HISTORY - 1)
+    n = SCHED_HISTORY - 1;
+  if (!n)
+    return;
+
+  uint32_t sorted[SCHED_HISTORY];
+  uint64_t total = 0;
+  for (uint32_t i = 0; i < n; ++i) {
+    uint32_t t = s->frame_times[(s->frames - 1 - i) & (SCHED_HISTORY - 1)];
+    uint32_t j = i;
+    for (; j > 0 && sorted[j - 1] > t; --j)
+      sorted[j] = sorted[j - 1];
+    sorted[j] = t;
+    total += t;
+  }
+  r->frame_min_us = sorted[0];
+  r->frame_max_us = sorted[n - 1];
+  r->frame_avg_us = total / n;
+  r->frame_p99_us = sorted[(n * 99) / 100 < n ? (n * 99) / 100 : n - 1];
+}
+
+void sched_print_report(const sched_t *s) {
+  sched_report_t r;
+  sched_report(s, &r);
+  printf("quadros %lu ticks %lu | ticks perdidos %lu quadros pulados %lu\n",
+         (unsigned long)r.frames, (unsigned long)r.ticks,
+         (unsigned long)r.missed_ticks, (unsigned long)r.dropped_frames);
+  printf("quadros iguais (sem envio) %lu\n", (unsigned long)r.unchanged_frames);
+  for (int core = 0; core < SCHED_CORES; ++core)
+    if (s->duty[core].sleeps)
+      printf("nucleo %d ativo: %lu.%lu%% no ultimo segundo (%lu despertares), %lu.%lu%% em media\n", core,
+             (unsigned long)r.active_permille[core] / 10, (unsigned long)r.active_permille[core] % 10,
+             (unsigned long)r.wakeups_per_s[core], (unsigned long)r.average_active_permille[core] / 10,
+             (unsigned long)r.average_active_permille[core] % 10);
+  printf("quadro us: min %lu med %lu p99 %lu max %lu\n",
+         (unsigned long)r.frame_min_us, (unsigned long)r.frame_avg_us,
+         (unsigned long)r.frame_p99_us, (unsigned long)r.frame_max_us);
+  for (int i = 0; i < SCHED_STAGE_COUNT; ++i)
+    if (s->stages[i].count)
+      printf("  %-8s med %5lu us max %5lu us\n", sched_stage_names[i],
+             (unsigned long)r.stage_avg_us[i], (unsigned long)r.stage_max_us[i]);
+}
+
+void sched_reset_stats(sched_t *s) {
+  memset(s->stages, 0, sizeof(s->stages));
+  memset(s->frame_times, 0, sizeof(s->frame_times));
+  s->frames = s->ticks = 0;
+  s->missed_ticks = s->dropped_frames = 0;
+  s->unchanged_frames = 0;
+
+  uint64_t now = sched_now(s);
+  for (int core = 0; core < SCHED_CORES; ++core) {
+    sched_duty_t *d = &s->duty[core];
+    memset(d, 0, sizeof(*d));
+    d->window_start = d->total_start = d->sleep_start = now;
+    d->last_active_permille = 1000;
+  }
+}
@@ -0,0 +1,94 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Agendador de passo fixo: a simulação avança em ticks de tick_us com prazos
+// absolutos (acumulador), e a renderização roda em frame_us, podendo pular
+// quadros quando atrasa. A fonte de tempo é injetada para permitir testes
+// determinísticos fora da placa.
+
+#define SCHED_HISTORY 128                                   // Quadros guardados para o cálculo do p99 (potência de 2)
+#define SCHED_CORES 2                                       // Núcleos com contagem de sono própria
+#define SCHED_DUTY_WINDOW_US 1000000                        // Janela do ciclo de trabalho (1 s)
+
+typedef uint64_t (*sched_clock_t)(void *ctx);
+
+typedef enum {
+  SCHED_STAGE_INPUT,
+  SCHED_STAGE_AI,
+  SCHED_STAGE_PHYSICS,
+  SCHED_STAGE_RASTER,
+  SCHED_STAGE_FLUSH,
+  SCHED_STAGE_COUNT
+} sched_stage_t;
+
+typedef struct {
+  uint32_t count;
+  uint32_t max_us;
+  uint64_t total_us;
+} sched_stage_stats_t;
+
+// Ciclo de trabalho de um núcleo: fração do tempo fora de
+// sched_sleep_begin/sched_sleep_end, por janela de um segundo
+typedef struct {
+  uint64_t window_start;
+  uint64_t sleep_start;
+  uint32_t window_slept_us;
+  uint32_t window_wakeups;
+  uint32_t last_active_permille;                            // Última janela completa
+  uint32_t last_wakeups;
+  uint64_t total_slept_us;
+  uint64_t total_start;
+  uint32_t sleeps;                                          // Desde sched_reset_stats; 0: núcleo que não usa este agendador
+} sched_duty_t;
+
+typedef struct {
+  sched_clock_t clock;
+  void *clock_ctx;
+  uint32_t tick_us, frame_us, max_catchup;
+  uint64_t next_tick, next_frame;
+  uint64_t last_frame_start;
+  uint64_t stage_start[SCHED_STAGE_COUNT];
+  sched_stage_stats_t stages[SCHED_STAGE_COUNT];
+  uint32_t frame_times[SCHED_HISTORY];
+  uint32_t frames, ticks;
+  uint32_t missed_ticks, dropped_frames;
+  uint32_t unchanged_frames;                                // Quadros iguais ao anterior, sem desenho nem envio
+  sched_duty_t duty[SCHED_CORES];
+} sched_t;
+
+typedef struct {
+  uint32_t frames, ticks;
+  uint32_t missed_ticks, dropped_frames;
+  uint32_t unchanged_frames;
+  uint32_t active_permille[SCHED_CORES];                    // Último segundo completo
+  uint32_t wakeups_per_s[SCHED_CORES];
+  uint32_t average_active_permille[SCHED_CORES];            // Desde sched_reset_stats
+  uint32_t frame_min_us, frame_avg_us, frame_p99_us, frame_max_us;
+  uint32_t stage_avg_us[SCHED_STAGE_COUNT];
+  uint32_t stage_max_us[SCHED_STAGE_COUNT];
+} sched_report_t;
+
+void sched_init(sched_t *s, uint32_t tick_us, uint32_t frame_us, sched_clock_t clock, void *clock_ctx);
+uint64_t sched_now(const sched_t *s);
+uint32_t sched_ticks_due(sched_t *s);
+bool sched_frame_due(sched_t *s);
+uint64_t sched_next_deadline(const sched_t *s);
+void sched_set_periods(sched_t *s, uint32_t tick_us, uint32_t frame_us);
+void sched_frame_unchanged(sched_t *s);
+
+// Em volta de cada sono do núcleo (WFI, sleep_until...)
+void sched_sleep_begin(sched_t *s, unsigned core);
+void sched_sleep_end(sched_t *s, unsigned core);
+
+void sched_stage_begin(sched_t *s, sched_stage_t stage);
+void sched_stage_end(sched_t *s, sched_stage_t stage);
+
+void sched_report(const sched_t *s, sched_report_t *r);
+// Só os núcleos que dormiram e as etapas que rodaram com este agendador
+void sched_print_report(const sched_t *s);
+void sched_reset_stats(sched_t *s);
+
+#endif
@@ -0,0 +1,85 @@
+#include <string.h>
+#include "spsc.h"
+
+void spsc_init(spsc_queue_t *q, void *storage, size_t slot_size, uint32_t capacity) {
+  q->slots = storage;
+  q->slot_size = slot_size;
+  q->mask = capacity - 1;
+  atomic_init(&q->head, 0);
+  atomic_init(&q->tail, 0);
+}
+
+// Chamado só pelo produtor. Retorna false se a fila estiver cheia.
+bool spsc_push(spsc_queue_t *q, const void *item) {
+  uint32_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+  uint32_t tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+  if (head - tail > q->mask)
+    return false;
+  memcpy(&q->slots[(head & q->mask) * q->slot_size], item, q->slot_size);
+  atomic_store_explicit(&q->head, head + 1, memory_order_release);
+  return true;
+}
+
+// Chamado só pelo consumidor. Retira o item mais antigo.
+bool spsc_pop(spsc_queue_t *q, void *item) {
+  uint32_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+  uint32_t head = atomic_load_explicit(&q->head, memory_order_acquire);
+  if (head == tail)
+    return false;
+  memcpy(item, &q->slots[(tail & q->mask) * q->slot_size], q->slot_size);
+  atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+  return true;
+}
+
+// Chamado só pelo consumidor. Retira o item mais recente e descarta os
+// anteriores. O produtor não alcança o slot head - 1 enquanto tail não
+// avançar, então a cópia é segura.
+bool spsc_pop_latest(spsc_queue_t *q, void *item) {
+  uint32_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+  uint32_t head = atomic_load_explicit(&q->head, memory_order_acquire);
+  if (head == tail)
+    return false;
+  memcpy(item, &q->slots[((head - 1) & q->mask) * q->slot_size], q->slot_size);
+  atomic_store_explicit(&q->tail, head, memory_order_release);
+  return true;
+}
+
+void spsc_latest_init(spsc_latest_t *m, void *storage, size_t slot_size) {
+  m->slots = storage;
+  m->slot_size = slot_size;
+  atomic_init(&m->latest, 0);
+  atomic_init(&m->reading, SPSC_LATEST_SLOTS);
+  m->taken = 0;
+}
+
+// Chamado só pelo produtor. Nunca espera o consumidor.
+void spsc_latest_publish(spsc_latest_t *m, const void *item) {
+  uint32_t latest = atomic_load_explicit(&m->latest, memory_order_relaxed);
+  uint32_t reading = atomic_load(&m->reading);
+  uint32_t slot = 0;
+  while (slot == (latest & 3) || slot == reading)
+    slot++;
+  memcpy(&m->slots[slot * m->slot_size], item, m->slot_size);
+  atomic_store(&m->latest, (((latest >> 2) + 1) << 2) | slot);
+}
+
+// Chamado só pelo consumidor. Copia o item mais recente; false se nada foi
+// publicado desde a última leitura. Se o produtor publicar entre o anúncio
+// e a conferência, tenta de novo com o novo slot; se não, o produtor já vê
+// o anúncio antes de escolher onde escrever.
+bool spsc_latest_take(spsc_latest_t *m, void *item) {
+  uint32_t latest = atomic_load(&m->latest);
+  for (;;) {
+    if ((latest >> 2) == m->taken)
+      return false;
+    atomic_store(&m->reading, latest & 3);
+    uint32_t again = atomic_load(&m->latest);
+    if (again == latest)
+      break;
+    latest = again;
+  }
+  memcpy(item, &m->slots[(latest & 3) * m->slot_size], m->slot_size);
+  atomic_store(&m->reading, SPSC_LATEST_SLOTS);
+  m->taken = latest >> 2;
+  return true;
+}
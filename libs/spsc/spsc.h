@@ -0,0 +1,48 @@
+#ifndef SPSC_H
+#define SPSC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+// Fila sem trava de um produtor e um consumidor (ex.: núcleo 0 -> núcleo 1).
+// Cada lado só escreve o seu próprio índice, então bastam leituras/escritas
+// atômicas com acquire/release, disponíveis no Cortex-M0+ (sem LDREX/STREX)
+// e em qualquer plataforma com C11.
+typedef struct {
+  uint8_t *slots;
+  size_t slot_size;
+  uint32_t mask;
+  _Atomic uint32_t head;
+  _Atomic uint32_t tail;
+} spsc_queue_t;
+
+// capacity precisa ser potência de 2; storage precisa ter capacity * slot_size bytes
+void spsc_init(spsc_queue_t *q, void *storage, size_t slot_size, uint32_t capacity);
+bool spsc_push(spsc_queue_t *q, const void *item);
+bool spsc_pop(spsc_queue_t *q, void *item);
+bool spsc_pop_latest(spsc_queue_t *q, void *item);
+
+// Caixa de correio "o último vence" entre um produtor e um consumidor, em
+// três slots: o produtor sempre escreve num slot que não é o publicado nem
+// o que o consumidor está lendo, então publicar nunca falha nem descarta o
+// item novo, e o consumidor sempre lê o mais recente, inteiro. Sem
+// leitura-modificação-escrita: o consumidor anuncia o slot que vai ler e
+// confere se ele ainda é o publicado (ordem seq_cst dos dois lados).
+#define SPSC_LATEST_SLOTS 3
+
+typedef struct {
+  uint8_t *slots;
+  size_t slot_size;
+  _Atomic uint32_t latest;          // Slot publicado (2 bits) e número do item
+  _Atomic uint32_t reading;         // Slot em leitura, ou SPSC_LATEST_SLOTS
+  uint32_t taken;                   // Número do último item lido (só o consumidor)
+} spsc_latest_t;
+
+// storage precisa ter SPSC_LATEST_SLOTS * slot_size bytes
+void spsc_latest_init(spsc_latest_t *m, void *storage, size_t slot_size);
+void spsc_latest_publish(spsc_latest_t *m, const void *item);
+bool spsc_latest_take(spsc_latest_t *m, void *item);
+
+#endif
@@ -1,118 +1,513 @@
 
+#include <string.h>
 #include "ssd1306.h"
 #include "font.h"
+#include "libs/profiler/profiler.h"
 
-void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+// Custo fixo, em bytes no barramento, de abrir uma janela de envio: a lista
+// de 6 comandos (endereço + controle + 6) e o cabeçalho da transação de dados
+#define SSD1306_WINDOW_COST 10
+
+// Comandos por transação em ssd1306_command_list (listas maiores são divididas)
+#define SSD1306_COMMAND_LIST_MAX 32
+
+// Geometria e buffers do painel. Na variante fixa (SSD1306_FIXED) são
+// constantes e deslocamentos dentro do próprio ssd1306_t, e o compilador
+// reduz os índices a deslocamentos de bits e máscaras.
+#if SSD1306_FIXED
+#define SSD_WIDTH(ssd) SSD1306_FIXED_WIDTH
+#define SSD_HEIGHT(ssd) SSD1306_FIXED_HEIGHT
+#define SSD_PAGES(ssd) SSD1306_FIXED_PAGES
+#define SSD_BUFSIZE(ssd) SSD1306_FIXED_BUFSIZE
+#define SSD_RAM(ssd) (&(ssd)->ram_storage[SSD1306_FIXED_LEAD])
+#define SSD_SHADOW(ssd) (&(ssd)->shadow_storage[SSD1306_FIXED_LEAD])
+#else
+#define SSD_WIDTH(ssd) ((ssd)->width)
+#define SSD_HEIGHT(ssd) ((ssd)->height)
+#define SSD_PAGES(ssd) ((ssd)->pages)
+#define SSD_BUFSIZE(ssd) ((ssd)->bufsize)
+#define SSD_RAM(ssd) ((ssd)->ram_buffer)
+#define SSD_SHADOW(ssd) ((ssd)->shadow_buffer)
+#endif
+
+#ifdef SSD1306_FIXED_ADDRESS
+#define SSD_ADDRESS(ssd) SSD1306_FIXED_ADDRESS
+#else
+#define SSD_ADDRESS(ssd) ((ssd)->address)
+#endif
+
+// Prepara o painel e seus buffers. Retorna false se a geometria não
+// corresponder à fixada no build ou se faltar memória para os buffers.
+bool ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+#if SSD1306_FIXED
+  if (width != SSD1306_FIXED_WIDTH || height != SSD1306_FIXED_HEIGHT)
+    return false;
+#endif
   ssd->width = width;
   ssd->height = height;
   ssd->pages = height / 8U;
   ssd->address = address;
   ssd->i2c_port = i2c;
+  ssd->transport = &ssd1306_i2c_transport;
+  ssd->bus = NULL;
+  ssd->external_vcc = external_vcc;
   ssd->bufsize = ssd->pages * ssd->width + 1;
-  ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
+#if SSD1306_FIXED
+  memset(ssd->ram_storage, 0, sizeof(ssd->ram_storage));
+  memset(ssd->shadow_storage, 0, sizeof(ssd->shadow_storage));
+  ssd->ram_buffer = SSD_RAM(ssd);
+  ssd->shadow_buffer = SSD_SHADOW(ssd);
+  ssd->tx_buffer = ssd->tx_storage;
+  ssd->dma_buffer = ssd->dma_storage;
+  ssd->dma_capacity = SSD1306_FIXED_DMA_CAPACITY;
+#else
+  // 3 bytes de folga antes do byte de controle deixam a área de pixels
+  // (ram_buffer + 1) alinhada em 4 bytes
+  uint8_t *ram = calloc(ssd->bufsize + 3, sizeof(uint8_t));
+  ssd->shadow_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
+  ssd->tx_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
+  if (!ram || !ssd->shadow_buffer || !ssd->tx_buffer) {
+    free(ram);
+    free(ssd->shadow_buffer);
+    free(ssd->tx_buffer);
+    ssd->ram_buffer = ssd->shadow_buffer = ssd->tx_buffer = NULL;
+    return false;
+  }
+  ssd->ram_buffer = ram + 3;
+  ssd->dma_buffer = NULL;
+  ssd->dma_capacity = 0;
+#endif
   ssd->ram_buffer[0] = 0x40;
-  ssd->port_buffer[0] = 0x80;
+  ssd->tx_buffer[0] = 0x40;
+  ssd->shadow_valid = false;
+  ssd->dma_channel = -1;
+  ssd->dma_len = 0;
+  return true;
 }
 
+// Troca o transporte do painel (o padrão é o I2C de ssd1306_init). bus é o
+// contexto do transporte, como um ssd1306_spi_t já inicializado.
+void ssd1306_set_transport(ssd1306_t *ssd, const ssd1306_transport_t *transport, void *bus) {
+  ssd1306_wait(ssd);
+  ssd->transport = transport;
+  ssd->bus = bus;
+  ssd1306_invalidate(ssd);
+}
+
+// Espera a transferência em curso e libera o canal de DMA e, na variante
+// dinâmica, os buffers
+void ssd1306_deinit(ssd1306_t *ssd) {
+  ssd1306_wait(ssd);
+  if (ssd->dma_channel >= 0)
+    dma_channel_unclaim(ssd->dma_channel);
+  ssd->dma_channel = -1;
+#if !SSD1306_FIXED
+  if (ssd->ram_buffer)
+    free(ssd->ram_buffer - 3);
+  free(ssd->shadow_buffer);
+  free(ssd->tx_buffer);
+  free(ssd->dma_buffer);
+  ssd->ram_buffer = ssd->shadow_buffer = ssd->tx_buffer = NULL;
+  ssd->dma_buffer = NULL;
+  ssd->dma_capacity = 0;
+#endif
+}
+
+// Sequência de inicialização, enviada numa única transação. O multiplex e o
+// arranjo dos pinos COM dependem da altura: painéis de 32 linhas usam COM
+// sequencial, os de 64, alternado.
 void ssd1306_config(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_DISP | 0x00);
-  ssd1306_command(ssd, SET_MEM_ADDR);
-  ssd1306_command(ssd, 0x01);
-  ssd1306_command(ssd, SET_DISP_START_LINE | 0x00);
-  ssd1306_command(ssd, SET_SEG_REMAP | 0x01);
-  ssd1306_command(ssd, SET_MUX_RATIO);
-  ssd1306_command(ssd, HEIGHT - 1);
-  ssd1306_command(ssd, SET_COM_OUT_DIR | 0x08);
-  ssd1306_command(ssd, SET_DISP_OFFSET);
-  ssd1306_command(ssd, 0x00);
-  ssd1306_command(ssd, SET_COM_PIN_CFG);
-  ssd1306_command(ssd, 0x12);
-  ssd1306_command(ssd, SET_DISP_CLK_DIV);
-  ssd1306_command(ssd, 0x80);
-  ssd1306_command(ssd, SET_PRECHARGE);
-  ssd1306_command(ssd, 0xF1);
-  ssd1306_command(ssd, SET_VCOM_DESEL);
-  ssd1306_command(ssd, 0x30);
-  ssd1306_command(ssd, SET_CONTRAST);
-  ssd1306_command(ssd, 0xFF);
-  ssd1306_command(ssd, SET_ENTIRE_ON);
-  ssd1306_command(ssd, SET_NORM_INV);
-  ssd1306_command(ssd, SET_CHARGE_PUMP);
-  ssd1306_command(ssd, 0x14);
-  ssd1306_command(ssd, SET_DISP | 0x01);
+  const uint8_t sequence[] = {
+    SET_DISP | 0x00,
+    SET_MEM_ADDR, 0x01,
+    SET_DISP_START_LINE | 0x00,
+    SET_SEG_REMAP | 0x01,
+    SET_MUX_RATIO, SSD_HEIGHT(ssd) - 1,
+    SET_COM_OUT_DIR | 0x08,
+    SET_DISP_OFFSET, 0x00,
+    SET_COM_PIN_CFG, SSD_HEIGHT(ssd) == 64 ? 0x12 : 0x02,
+    SET_DISP_CLK_DIV, 0x80,
+    SET_PRECHARGE, ssd->external_vcc ? 0x22 : 0xF1,
+    SET_VCOM_DESEL, 0x30,
+    SET_CONTRAST, 0xFF,
+    SET_ENTIRE_ON,
+    SET_NORM_INV,
+    SET_CHARGE_PUMP, ssd->external_vcc ? 0x10 : 0x14,
+    SET_DISP | 0x01,
+  };
+  ssd1306_command_list(ssd, sequence, sizeof(sequence));
+  ssd1306_invalidate(ssd);
 }
 
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
-  ssd->port_buffer[1] = command;
+  ssd1306_wait(ssd);
+  ssd->transport->commands(ssd, &command, 1);
+}
+
+// Envia uma sequência de comandos (com seus argumentos) de uma vez
+void ssd1306_command_list(ssd1306_t *ssd, const uint8_t *commands, size_t count) {
+  ssd1306_wait(ssd);
+  ssd->transport->commands(ssd, commands, count);
+}
+
+// Corrente dos segmentos (brilho), de 0 a 255; ssd1306_config usa 255. O
+// consumo do painel cai quase na mesma proporção.
+void ssd1306_contrast(ssd1306_t *ssd, uint8_t value) {
+  const uint8_t commands[] = { SET_CONTRAST, value };
+  ssd1306_command_list(ssd, commands, sizeof(commands));
+}
+
+// Transporte I2C. Comandos vão numa só transação: o byte de controle 0x00
+// (Co = 0, D/C# = 0) vale para todos os bytes até o STOP. Listas maiores
+// que SSD1306_COMMAND_LIST_MAX são divididas.
+static void ssd1306_i2c_commands(ssd1306_t *ssd, const uint8_t *commands, size_t count) {
+  uint8_t buffer[SSD1306_COMMAND_LIST_MAX + 1];
+
+  buffer[0] = 0x00;
+  while (count) {
+    size_t chunk = count < SSD1306_COMMAND_LIST_MAX ? count : SSD1306_COMMAND_LIST_MAX;
+    memcpy(&buffer[1], commands, chunk);
+    i2c_write_blocking(ssd->i2c_port, SSD_ADDRESS(ssd), buffer, chunk + 1, false);
+    commands += chunk;
+    count -= chunk;
+  }
+}
+
+// O byte reservado buffer[0] já é o controle de dados (0x40, ver ssd1306_init)
+static void ssd1306_i2c_data(ssd1306_t *ssd, const uint8_t *buffer, size_t len) {
   i2c_write_blocking(
     ssd->i2c_port,
-    ssd->address,
-    ssd->port_buffer,
-    2,
+    SSD_ADDRESS(ssd),
+    buffer,
+    len,
     false
   );
 }
 
-void ssd1306_send_data(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_COL_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->width - 1);
-  ssd1306_command(ssd, SET_PAGE_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->pages - 1);
-  i2c_write_blocking(
-    ssd->i2c_port,
-    ssd->address,
-    ssd->ram_buffer,
-    ssd->bufsize,
-    false
+static void ssd1306_i2c_queue_byte(ssd1306_t *ssd, uint8_t byte, bool stop) {
+  ssd->dma_buffer[ssd->dma_len++] = byte | (stop ? I2C_IC_DATA_CMD_STOP_BITS : 0);
+}
+
+// Cada segmento vira uma transação em palavras de IC_DATA_CMD: byte de
+// controle, os bytes e o bit STOP no último, que faz o controlador I2C
+// encerrar e reiniciar as transferências sozinho, sem intervenção da CPU
+static void ssd1306_i2c_queue(ssd1306_t *ssd, const uint8_t *bytes, size_t count, bool command) {
+  ssd1306_i2c_queue_byte(ssd, command ? 0x00 : 0x40, false);
+  for (size_t i = 0; i < count; ++i)
+    ssd1306_i2c_queue_byte(ssd, bytes[i], false);
+  ssd->dma_buffer[ssd->dma_len - 1] |= I2C_IC_DATA_CMD_STOP_BITS;
+}
+
+static void ssd1306_i2c_start(ssd1306_t *ssd) {
+  if (ssd->dma_channel < 0)
+    ssd->dma_channel = dma_claim_unused_channel(true);
+
+  i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+  hw->enable = 0;
+  hw->tar = SSD_ADDRESS(ssd);
+  hw->enable = 1;
+
+  dma_channel_config config = dma_channel_get_default_config(ssd->dma_channel);
+  channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+  channel_config_set_read_increment(&config, true);
+  channel_config_set_write_increment(&config, false);
+  channel_config_set_dreq(&config, i2c_get_dreq(ssd->i2c_port, true));
+  dma_channel_configure(
+    ssd->dma_channel,
+    &config,
+    &hw->data_cmd,
+    ssd->dma_buffer,
+    ssd->dma_len,
+    true
   );
 }
 
+// A transferência só termina quando o DMA esvaziou o buffer e o controlador
+// I2C terminou de transmitir o que restou na FIFO
+static bool ssd1306_i2c_busy(ssd1306_t *ssd) {
+  if (ssd->dma_channel < 0)
+    return false;
+  if (dma_channel_is_busy(ssd->dma_channel))
+    return true;
+  i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+  return !(hw->status & I2C_IC_STATUS_TFE_BITS) || (hw->status & I2C_IC_STATUS_ACTIVITY_BITS);
+}
+
+const ssd1306_transport_t ssd1306_i2c_transport = {
+  .commands = ssd1306_i2c_commands,
+  .data = ssd1306_i2c_data,
+  .queue = ssd1306_i2c_queue,
+  .start = ssd1306_i2c_start,
+  .busy = ssd1306_i2c_busy,
+  .segment_overhead = 1,
+};
+
+// Máscara das páginas da coluna x que diferem do último quadro enviado
+static uint8_t ssd1306_dirty_pages(const ssd1306_t *ssd, uint8_t x) {
+  uint16_t index = 1 + x * SSD_PAGES(ssd);
+  uint8_t mask = 0;
+#if SSD1306_FIXED
+  // Coluna alinhada e de tamanho constante: a comparação inteira vira um
+  // par de leituras de palavra, e colunas iguais (a maioria) saem aqui
+  if (!memcmp(&SSD_RAM(ssd)[index], &SSD_SHADOW(ssd)[index], SSD1306_FIXED_PAGES))
+    return 0;
+#endif
+  for (uint8_t page = 0; page < SSD_PAGES(ssd); ++page)
+    if (SSD_RAM(ssd)[index + page] != SSD_SHADOW(ssd)[index + page])
+      mask |= 1 << page;
+  return mask;
+}
+
+static uint8_t ssd1306_first_page(uint8_t mask) {
+  uint8_t page = 0;
+  while (!(mask & 0x01)) {
+    mask >>= 1;
+    ++page;
+  }
+  return page;
+}
+
+static uint8_t ssd1306_last_page(uint8_t mask) {
+  uint8_t page = 7;
+  while (!(mask & 0x80)) {
+    mask <<= 1;
+    --page;
+  }
+  return page;
+}
+
+static uint8_t ssd1306_page_span(uint8_t mask) {
+  return ssd1306_last_page(mask) - ssd1306_first_page(mask) + 1;
+}
+
+// Copia a janela de colunas c0..c1 e páginas p0..p1 para a cópia sombra
+static void ssd1306_commit_window(ssd1306_t *ssd, uint8_t c0, uint8_t c1, uint8_t p0, uint8_t p1) {
+  uint8_t span = p1 - p0 + 1;
+  for (uint8_t x = c0; x <= c1; ++x) {
+    uint16_t index = 1 + x * SSD_PAGES(ssd) + p0;
+    memcpy(&SSD_SHADOW(ssd)[index], &SSD_RAM(ssd)[index], span);
+  }
+}
+
+// Envia a janela de colunas c0..c1 e páginas p0..p1 e atualiza a cópia sombra.
+// Com o endereçamento vertical (SET_MEM_ADDR 0x01) o controlador percorre as
+// páginas de cada coluna antes de avançar, a mesma ordem do ram_buffer.
+static bool ssd1306_send_window(ssd1306_t *ssd, uint8_t c0, uint8_t c1, uint8_t p0, uint8_t p1) {
+  const uint8_t *data = ssd->tx_buffer;
+  size_t len = 1;
+  uint8_t span = p1 - p0 + 1;
+
+  if (span == SSD_PAGES(ssd) && c0 == 0 && c1 == SSD_WIDTH(ssd) - 1) {
+    data = SSD_RAM(ssd);
+    len = SSD_BUFSIZE(ssd);
+  } else {
+    for (uint8_t x = c0; x <= c1; ++x) {
+      memcpy(&ssd->tx_buffer[len], &SSD_RAM(ssd)[1 + x * SSD_PAGES(ssd) + p0], span);
+      len += span;
+    }
+  }
+  ssd1306_commit_window(ssd, c0, c1, p0, p1);
+
+  const uint8_t window[] = { SET_COL_ADDR, c0, c1, SET_PAGE_ADDR, p0, p1 };
+  ssd->transport->commands(ssd, window, sizeof(window));
+  ssd->transport->data(ssd, data, len);
+  return true;
+}
+
+// Percorre as regiões do buffer que mudaram desde o último envio.
+// Colunas sujas vizinhas são agrupadas na mesma janela sempre que reenviar
+// os bytes intermediários custa menos que abrir uma nova janela.
+// Retorna false se emit recusar alguma janela.
+static bool ssd1306_for_each_window(ssd1306_t *ssd, bool (*emit)(ssd1306_t *, uint8_t, uint8_t, uint8_t, uint8_t)) {
+  if (!ssd->shadow_valid) {
+    ssd->shadow_valid = true;
+    return emit(ssd, 0, SSD_WIDTH(ssd) - 1, 0, SSD_PAGES(ssd) - 1);
+  }
+
+  uint8_t c0 = 0, c1 = 0, pages = 0;
+  for (uint8_t x = 0; x < SSD_WIDTH(ssd); ++x) {
+    uint8_t mask = ssd1306_dirty_pages(ssd, x);
+    if (!mask)
+      continue;
+    if (pages) {
+      uint8_t merged = pages | mask;
+      uint16_t merged_cost = ssd1306_page_span(merged) * (x - c0 + 1);
+      uint16_t split_cost = ssd1306_page_span(pages) * (c1 - c0 + 1) + SSD1306_WINDOW_COST + ssd1306_page_span(mask);
+      if (merged_cost <= split_cost) {
+        pages = merged;
+        c1 = x;
+        continue;
+      }
+      if (!emit(ssd, c0, c1, ssd1306_first_page(pages), ssd1306_last_page(pages)))
+        return false;
+    }
+    c0 = c1 = x;
+    pages = mask;
+  }
+  if (pages)
+    return emit(ssd, c0, c1, ssd1306_first_page(pages), ssd1306_last_page(pages));
+  return true;
+}
+
+void ssd1306_send_data(ssd1306_t *ssd) {
+  PROF_BEGIN(PROF_SSD1306_SEND_DATA);
+  ssd1306_wait(ssd);
+  ssd1306_for_each_window(ssd, ssd1306_send_window);
+  PROF_END(PROF_SSD1306_SEND_DATA);
+}
+
+// Codifica a janela para o envio assíncrono: um segmento com a lista de
+// comandos da janela e outro com os dados, no formato do transporte
+static bool ssd1306_queue_window(ssd1306_t *ssd, uint8_t c0, uint8_t c1, uint8_t p0, uint8_t p1) {
+  const uint8_t window[] = { SET_COL_ADDR, c0, c1, SET_PAGE_ADDR, p0, p1 };
+  uint8_t span = p1 - p0 + 1;
+  size_t len = (c1 - c0 + 1) * span;
+  if (ssd->dma_len + 2 * ssd->transport->segment_overhead + sizeof(window) + len > ssd->dma_capacity)
+    return false;
+
+  const uint8_t *data = ssd->tx_buffer + 1;
+  if (span == SSD_PAGES(ssd) && c0 == 0 && c1 == SSD_WIDTH(ssd) - 1) {
+    data = SSD_RAM(ssd) + 1;
+  } else {
+    uint8_t *out = ssd->tx_buffer + 1;
+    for (uint8_t x = c0; x <= c1; ++x, out += span)
+      memcpy(out, &SSD_RAM(ssd)[1 + x * SSD_PAGES(ssd) + p0], span);
+  }
+  ssd->transport->queue(ssd, window, sizeof(window), true);
+  ssd->transport->queue(ssd, data, len, false);
+  ssd1306_commit_window(ssd, c0, c1, p0, p1);
+  return true;
+}
+
+// Inicia o envio das regiões alteradas por DMA e retorna imediatamente.
+// O ram_buffer (buffer de trás) fica livre para o próximo quadro assim que a
+// função retorna; o quadro em trânsito vive no dma_buffer (buffer da frente),
+// que só é trocado pelo próximo quadro depois que a transferência termina.
+void ssd1306_send_data_async(ssd1306_t *ssd) {
+  PROF_BEGIN(PROF_SSD1306_SEND_DATA_ASYNC);
+  ssd1306_wait(ssd);
+
+#if !SSD1306_FIXED
+  // Sem memória para o buffer do DMA, o quadro vai pelo envio bloqueante
+  if (!ssd->dma_buffer) {
+    ssd->dma_buffer = calloc(SSD_BUFSIZE(ssd) + 64, sizeof(uint16_t));
+    if (!ssd->dma_buffer) {
+      ssd1306_send_data(ssd);
+      PROF_END(PROF_SSD1306_SEND_DATA_ASYNC);
+      return;
+    }
+    ssd->dma_capacity = SSD_BUFSIZE(ssd) + 64;
+  }
+#endif
+  ssd->dma_len = 0;
+  if (!ssd1306_for_each_window(ssd, ssd1306_queue_window)) {
+    ssd->dma_len = 0;
+    ssd1306_invalidate(ssd);
+    ssd1306_for_each_window(ssd, ssd1306_queue_window);
+  }
+  if (ssd->dma_len)
+    ssd->transport->start(ssd);
+  PROF_END(PROF_SSD1306_SEND_DATA_ASYNC);
+}
+
+bool ssd1306_is_busy(ssd1306_t *ssd) {
+  return ssd->transport->busy(ssd);
+}
+
+void ssd1306_wait(ssd1306_t *ssd) {
+  PROF_BEGIN(PROF_SSD1306_WAIT);
+  while (ssd1306_is_busy(ssd))
+    tight_loop_contents();
+  PROF_END(PROF_SSD1306_WAIT);
+}
+
+// Força o próximo ssd1306_send_data a enviar o quadro inteiro
+void ssd1306_invalidate(ssd1306_t *ssd) {
+  ssd->shadow_valid = false;
+}
+
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
-  uint16_t index = (y >> 3) + (x << 3) + 1;
+  if (x >= SSD_WIDTH(ssd) || y >= SSD_HEIGHT(ssd))
+    return;
+  uint16_t index = (y >> 3) + x * SSD_PAGES(ssd) + 1;
   uint8_t pixel = (y & 0b111);
   if (value)
-    ssd->ram_buffer[index] |= (1 << pixel);
+    SSD_RAM(ssd)[index] |= (1 << pixel);
   else
-    ssd->ram_buffer[index] &= ~(1 << pixel);
+    SSD_RAM(ssd)[index] &= ~(1 << pixel);
 }
 
-/*
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-  uint8_t byte = value ? 0xFF : 0x00;
-  for (uint8_t i = 1; i < ssd->bufsize; ++i)
-    ssd->ram_buffer[i] = byte;
-}*/
+// O buffer é organizado em colunas: os bytes de uma coluna ficam contíguos,
+// um por página, com o bit 0 na linha de cima. Os traços abaixo escrevem
+// bytes ou máscaras inteiras nesse formato em vez de pixel a pixel, e
+// descartam o que estiver fora da tela.
 
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-    // Itera por todas as posições do display
-    for (uint8_t y = 0; y < ssd->height; ++y) {
-        for (uint8_t x = 0; x < ssd->width; ++x) {
-            ssd1306_pixel(ssd, x, y, value);
-        }
-    }
+// Máscara dos bits da página que ficam entre as linhas y0 e y1 (inclusive)
+static inline uint8_t ssd1306_span_mask(uint8_t y0, uint8_t y1) {
+  return (0xFF << (y0 & 7)) & (0xFF >> (7 - (y1 & 7)));
 }
 
+static inline void ssd1306_apply(uint8_t *byte, uint8_t mask, bool value) {
+  if (value)
+    *byte |= mask;
+  else
+    *byte &= ~mask;
+}
 
+// Preenche as linhas y0..y1 da coluna x; exige x < width e y0 <= y1 < height
+static void ssd1306_vspan(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
+  uint8_t *column = &SSD_RAM(ssd)[1 + x * SSD_PAGES(ssd)];
+  uint8_t p0 = y0 >> 3, p1 = y1 >> 3;
 
-void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
-  for (uint8_t x = left; x < left + width; ++x) {
-    ssd1306_pixel(ssd, x, top, value);
-    ssd1306_pixel(ssd, x, top + height - 1, value);
-  }
-  for (uint8_t y = top; y < top + height; ++y) {
-    ssd1306_pixel(ssd, left, y, value);
-    ssd1306_pixel(ssd, left + width - 1, y, value);
+  if (p0 == p1) {
+    ssd1306_apply(&column[p0], ssd1306_span_mask(y0, y1), value);
+    return;
   }
+  ssd1306_apply(&column[p0], 0xFF << (y0 & 7), value);
+  for (uint8_t page = p0 + 1; page < p1; ++page)
+    column[page] = value ? 0xFF : 0x00;
+  ssd1306_apply(&column[p1], 0xFF >> (7 - (y1 & 7)), value);
+}
+
+// Aplica a mesma máscara de página nas colunas x0..x1; exige x0 <= x1 < width
+static void ssd1306_hspan(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t page, uint8_t mask, bool value) {
+  uint8_t *byte = &SSD_RAM(ssd)[1 + x0 * SSD_PAGES(ssd) + page];
+  for (uint8_t x = x0; x <= x1; ++x, byte += SSD_PAGES(ssd))
+    ssd1306_apply(byte, mask, value);
+}
+
+// A área de pixels começa alinhada em 4 bytes (ver ssd1306_init), então a
+// limpeza é feita em palavras de 32 bits
+void ssd1306_fill(ssd1306_t *ssd, bool value) {
+  PROF_BEGIN(PROF_SSD1306_FILL);
+  uint32_t word = value ? 0xFFFFFFFFu : 0x00000000u;
+  uint32_t *dst = (uint32_t *)&SSD_RAM(ssd)[1];
+  size_t words = (SSD_BUFSIZE(ssd) - 1) / sizeof(uint32_t);
+  for (size_t i = 0; i < words; ++i)
+    dst[i] = word;
+  for (size_t i = 1 + words * sizeof(uint32_t); i < SSD_BUFSIZE(ssd); ++i)
+    SSD_RAM(ssd)[i] = (uint8_t)word;
+  PROF_END(PROF_SSD1306_FILL);
+}
+
+void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
+  if (!width || !height || left >= SSD_WIDTH(ssd) || top >= SSD_HEIGHT(ssd))
+    return;
+  uint8_t right = (left + width - 1 < SSD_WIDTH(ssd)) ? left + width - 1 : SSD_WIDTH(ssd) - 1;
+  uint8_t bottom = (top + height - 1 < SSD_HEIGHT(ssd)) ? top + height - 1 : SSD_HEIGHT(ssd) - 1;
 
   if (fill) {
-    for (uint8_t x = left + 1; x < left + width - 1; ++x) {
-      for (uint8_t y = top + 1; y < top + height - 1; ++y) {
-        ssd1306_pixel(ssd, x, y, value);
-      }
-    }
+    for (uint8_t x = left; x <= right; ++x)
+      ssd1306_vspan(ssd, x, top, bottom, value);
+    return;
   }
+
+  ssd1306_hspan(ssd, left, right, top >> 3, 1 << (top & 7), value);
+  if (bottom == top + height - 1)
+    ssd1306_hspan(ssd, left, right, bottom >> 3, 1 << (bottom & 7), value);
+  ssd1306_vspan(ssd, left, top, bottom, value);
+  if (right == left + width - 1)
+    ssd1306_vspan(ssd, right, top, bottom, value);
 }
 
 void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value) {
@@ -144,69 +539,195 @@ void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1
 }
 
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
-  for (uint8_t x = x0; x <= x1; ++x)
-    ssd1306_pixel(ssd, x, y, value);
+  if (x0 > x1 || x0 >= SSD_WIDTH(ssd) || y >= SSD_HEIGHT(ssd))
+    return;
+  if (x1 >= SSD_WIDTH(ssd))
+    x1 = SSD_WIDTH(ssd) - 1;
+  ssd1306_hspan(ssd, x0, x1, y >> 3, 1 << (y & 7), value);
 }
 
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
-  for (uint8_t y = y0; y <= y1; ++y)
-    ssd1306_pixel(ssd, x, y, value);
+  if (y0 > y1 || x >= SSD_WIDTH(ssd) || y0 >= SSD_HEIGHT(ssd))
+    return;
+  if (y1 >= SSD_HEIGHT(ssd))
+    y1 = SSD_HEIGHT(ssd) - 1;
+  ssd1306_vspan(ssd, x, y0, y1, value);
 }
 
+// Copia um sprite de 1 bit por pixel no mesmo formato do buffer (colunas de
+// (height + 7) / 8 bytes, bit 0 em cima). Só os bits em 1 do sprite são
+// escritos, com a cor value; partes fora da tela são recortadas.
+void ssd1306_blit(ssd1306_t *ssd, const uint8_t *sprite, uint8_t width, uint8_t height, int x, int y, bool value) {
+  uint8_t src_pages = (height + 7) / 8;
+  uint8_t last_mask = 0xFF >> ((8 - (height & 7)) & 7);
+  int page = (y >= 0) ? y / 8 : -((7 - y) / 8);
+  uint8_t shift = y - page * 8;
 
-// Função para desenhar um caractere no display SSD1306
-void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
-{
-    uint16_t index = 0;
+  for (uint8_t col = 0; col < width; ++col) {
+    int dx = x + col;
+    if (dx < 0 || dx >= SSD_WIDTH(ssd))
+      continue;
+    uint8_t *column = &SSD_RAM(ssd)[1 + dx * SSD_PAGES(ssd)];
+    const uint8_t *src = &sprite[col * src_pages];
 
-    // Verifica se é uma letra maiúscula (A-Z)
-    if (c >= 'A' && c <= 'Z')
-    {
-        index = (c - 'A' + 11) * 8; // Offset para letras maiúsculas
-    }
-    // Verifica se é uma letra minúscula (a-z)
-    else if (c >= 'a' && c <= 'z')
-    {
-        index = (c - 'a' + 37) * 8; // Offset para letras minúsculas (após as maiúsculas)
-    }
-    // Verifica se é um dígito (0-9)
-    else if (c >= '0' && c <= '9')
-    {
-        index = (c - '0' + 1) * 8; // Offset para dígitos
-    }
-    else
-    {
-        // Se o caractere não for suportado, exibe um espaço (ou outro caractere padrão)
-        index = 0;
+    for (uint8_t sp = 0; sp < src_pages; ++sp) {
+      uint8_t bits = (sp == src_pages - 1) ? src[sp] & last_mask : src[sp];
+      int dp = page + sp;
+      if (!bits)
+        continue;
+      if (dp >= 0 && dp < SSD_PAGES(ssd))
+        ssd1306_apply(&column[dp], bits << shift, value);
+      if (shift && dp + 1 >= 0 && dp + 1 < SSD_PAGES(ssd))
+        ssd1306_apply(&column[dp + 1], bits >> (8 - shift), value);
     }
+  }
+}
 
-    // Desenha o caractere no display, assumindo uma matriz de 8x8 pixels por caractere
-    for (uint8_t i = 0; i < 8; ++i)
-    {
-        uint8_t line = font[index + i];
-        for (uint8_t j = 0; j < 8; ++j)
-        {
-            // Verifica se o bit j de 'line' está setado e desenha o pixel
-            ssd1306_pixel(ssd, x + i, y + j, (line & (1 << j)) ? 1 : 0);
-        }
-    }
+
+// Glifo do caractere c: acesso direto pela tabela ASCII, com os caracteres
+// fora de ' '..'~' desenhados como espaço
+static inline uint8_t ssd1306_glyph(char c) {
+  uint8_t index = (uint8_t)c - FONT_FIRST;
+  return index < FONT_GLYPHS ? index : 0;
+}
+
+// Escreve colunas opacas de 8 linhas (um byte cada, no formato do buffer)
+// a partir de (x, y). Com y múltiplo de 8 cada coluna é um único byte;
+// senão, cada coluna cai em duas páginas e entra com duas escritas
+// mascaradas. Colunas e páginas fora da tela são recortadas.
+static void ssd1306_put_columns(ssd1306_t *ssd, const uint8_t *columns, int count, int x, int y) {
+  int page = (y >= 0) ? y / 8 : -((7 - y) / 8);
+  uint8_t shift = y - page * 8;
+  int first = x < 0 ? -x : 0;
+  int last = count < SSD_WIDTH(ssd) - x ? count : SSD_WIDTH(ssd) - x;
+
+  if (first >= last || page >= SSD_PAGES(ssd) || page < -1 || (page < 0 && !shift))
+    return;
+
+  uint8_t *dst = &SSD_RAM(ssd)[1 + (x + first) * SSD_PAGES(ssd) + page];
+  if (!shift) {
+    for (int i = first; i < last; ++i, dst += SSD_PAGES(ssd))
+      *dst = columns[i];
+    return;
+  }
+
+  uint8_t low_mask = 0xFF << shift;
+  uint8_t high_mask = 0xFF >> (8 - shift);
+  bool low = page >= 0;
+  bool high = page + 1 < SSD_PAGES(ssd);
+  for (int i = first; i < last; ++i, dst += SSD_PAGES(ssd)) {
+    if (low)
+      dst[0] = (dst[0] & ~low_mask) | (columns[i] << shift);
+    if (high)
+      dst[1] = (dst[1] & ~high_mask) | (columns[i] >> (8 - shift));
+  }
+}
+
+// Função para desenhar um caractere no display SSD1306
+void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
+{
+  ssd1306_put_columns(ssd, font[ssd1306_glyph(c)], FONT_WIDTH, x, y);
 }
 
 // Função para desenhar uma string
 void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y)
 {
+  PROF_BEGIN(PROF_SSD1306_DRAW_STRING);
   while (*str)
   {
     ssd1306_draw_char(ssd, *str++, x, y);
     x += 8;
-    if (x + 8 >= ssd->width)
+    if (x + 8 >= SSD_WIDTH(ssd))
     {
       x = 0;
       y += 8;
     }
-    if (y + 8 >= ssd->height)
+    if (y + 8 >= SSD_HEIGHT(ssd))
     {
       break;
     }
   }
-}
\ No newline at end of file
+  PROF_END(PROF_SSD1306_DRAW_STRING);
+}
+
+// Texto com a fonte proporcional: cada glifo ocupa só as colunas acesas
+// mais uma coluna de espaço. Retorna o x depois do último caractere.
+uint8_t ssd1306_draw_string_prop(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y)
+{
+  static const uint8_t gap = 0;
+
+  while (*str && x < SSD_WIDTH(ssd))
+  {
+    uint8_t glyph = ssd1306_glyph(*str++);
+    const uint8_t *span = font_span[glyph];
+    ssd1306_put_columns(ssd, &font[glyph][span[0]], span[1], x, y);
+    x += span[1];
+    if (*str)
+      ssd1306_put_columns(ssd, &gap, 1, x++, y);
+  }
+  return x;
+}
+
+// Largura em pixels que o texto ocupa
+uint16_t ssd1306_text_width(const char *str, bool proportional)
+{
+  uint16_t width = 0;
+
+  for (; *str; ++str)
+    width += proportional ? font_span[ssd1306_glyph(*str)][1] + (str[1] ? 1 : 0) : FONT_WIDTH;
+  return width;
+}
+
+// Pré-renderiza o texto em colunas prontas para o buffer, para textos que
+// mudam pouco (como o placar) serem redesenhados sem consultar a fonte.
+// O que passar de SSD1306_TEXT_MAX_COLUMNS colunas é descartado.
+void ssd1306_text_render(ssd1306_text_t *text, const char *str, bool proportional)
+{
+  uint8_t width = 0;
+
+  for (; *str && width < SSD1306_TEXT_MAX_COLUMNS; ++str)
+  {
+    uint8_t index = ssd1306_glyph(*str);
+    const uint8_t *glyph = font[index];
+    uint8_t first = proportional ? font_span[index][0] : 0;
+    uint8_t count = proportional ? font_span[index][1] + (str[1] ? 1 : 0) : FONT_WIDTH;
+
+    if (count > SSD1306_TEXT_MAX_COLUMNS - width)
+      count = SSD1306_TEXT_MAX_COLUMNS - width;
+    for (uint8_t i = 0; i < count; ++i)
+      text->columns[width++] = first + i < FONT_WIDTH ? glyph[first + i] : 0;
+  }
+  text->width = width;
+}
+
+void ssd1306_draw_text(ssd1306_t *ssd, const ssd1306_text_t *text, int x, int y)
+{
+  ssd1306_put_columns(ssd, text->columns, text->width, x, y);
+}
+
+// Copia para dst a parte de src que começa na coluna x e na página page,
+// do tamanho de dst (o que passar de src fica apagado). Com flip, as colunas
+// vão em ordem inversa. Serve para espelhar ou dividir uma cena entre
+// painéis: cada coluna é um bloco contíguo de páginas nos dois buffers.
+void ssd1306_copy_view(ssd1306_t *dst, const ssd1306_t *src, uint8_t x, uint8_t page, bool flip)
+{
+  uint8_t pages = page < SSD_PAGES(src) ? SSD_PAGES(src) - page : 0;
+  if (pages > SSD_PAGES(dst))
+    pages = SSD_PAGES(dst);
+
+  for (uint8_t col = 0; col < SSD_WIDTH(dst); ++col)
+  {
+    uint8_t *out = &SSD_RAM(dst)[1 + col * SSD_PAGES(dst)];
+    unsigned sx = x + (flip ? SSD_WIDTH(dst) - 1 - col : col);
+
+    if (sx < SSD_WIDTH(src))
+    {
+      memcpy(out, &SSD_RAM(src)[1 + sx * SSD_PAGES(src) + page], pages);
+      memset(out + pages, 0, SSD_PAGES(dst) - pages);
+    }
+    else
+    {
+      memset(out, 0, SSD_PAGES(dst));
+    }
+  }
+}
@@ -1,10 +1,37 @@
+#ifndef SSD1306_H
+#define SSD1306_H
+
 #include <stdlib.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
+#include "hardware/dma.h"
 
 #define WIDTH 128
 #define HEIGHT 64
 
+// Variante de geometria fixa: definindo SSD1306_FIXED_WIDTH e
+// SSD1306_FIXED_HEIGHT no build (e, opcionalmente, SSD1306_FIXED_ADDRESS),
+// todos os painéis têm essa geometria, os buffers passam a morar dentro do
+// ssd1306_t (nada de heap) e as contas de índice viram constantes.
+#if defined(SSD1306_FIXED_WIDTH) != defined(SSD1306_FIXED_HEIGHT)
+#error "SSD1306_FIXED_WIDTH e SSD1306_FIXED_HEIGHT devem ser definidos juntos"
+#endif
+
+#ifdef SSD1306_FIXED_WIDTH
+#define SSD1306_FIXED 1
+#if SSD1306_FIXED_HEIGHT % 8 || SSD1306_FIXED_HEIGHT > 64 || SSD1306_FIXED_WIDTH > 128
+#error "geometria fixa inválida: altura múltipla de 8 até 64, largura até 128"
+#endif
+#define SSD1306_FIXED_PAGES (SSD1306_FIXED_HEIGHT / 8)
+#define SSD1306_FIXED_BUFSIZE (SSD1306_FIXED_WIDTH * SSD1306_FIXED_PAGES + 1)
+#define SSD1306_FIXED_DMA_CAPACITY (SSD1306_FIXED_BUFSIZE + 64)
+// Folga antes do byte de controle: deixa a área de pixels alinhada em 8
+// bytes, ou seja, cada coluna de 8 páginas numa palavra dupla
+#define SSD1306_FIXED_LEAD 7
+#else
+#define SSD1306_FIXED 0
+#endif
+
 typedef enum {
   SET_CONTRAST = 0x81,
   SET_ENTIRE_ON = 0xA4,
@@ -25,19 +52,68 @@ typedef enum {
   SET_CHARGE_PUMP = 0x8D
 } ssd1306_command_t;
 
+typedef struct ssd1306 ssd1306_t;
+
+// Transporte entre o driver e o controlador. Todos entregam comandos e dados
+// com a mesma semântica: commands e data são bloqueantes; queue codifica um
+// segmento (comandos ou dados) em palavras no ssd->dma_buffer, start
+// dispara o envio de dma_buffer[0..dma_len) e busy informa se ele terminou.
 typedef struct {
+  // Lista de comandos com seus argumentos
+  void (*commands)(ssd1306_t *ssd, const uint8_t *commands, size_t count);
+  // Dados em buffer[1..len); buffer[0] é reservado ao transporte (0x40)
+  void (*data)(ssd1306_t *ssd, const uint8_t *buffer, size_t len);
+  void (*queue)(ssd1306_t *ssd, const uint8_t *bytes, size_t count, bool command);
+  void (*start)(ssd1306_t *ssd);
+  bool (*busy)(ssd1306_t *ssd);
+  uint8_t segment_overhead;   // Palavras extras que queue gasta por segmento
+} ssd1306_transport_t;
+
+// I2C com DMA para IC_DATA_CMD (padrão de ssd1306_init)
+extern const ssd1306_transport_t ssd1306_i2c_transport;
+
+struct ssd1306 {
   uint8_t width, height, pages, address;
   i2c_inst_t *i2c_port;
+  const ssd1306_transport_t *transport;
+  void *bus;                  // Contexto do transporte (ex.: ssd1306_spi_t)
   bool external_vcc;
   uint8_t *ram_buffer;
+  uint8_t *shadow_buffer;
+  uint8_t *tx_buffer;
+  bool shadow_valid;
+  int dma_channel;
+  uint16_t *dma_buffer;
+  size_t dma_len, dma_capacity;
   size_t bufsize;
-  uint8_t port_buffer[2];
-} ssd1306_t;
+#if SSD1306_FIXED
+  uint8_t ram_storage[SSD1306_FIXED_LEAD + SSD1306_FIXED_BUFSIZE] __attribute__((aligned(8)));
+  uint8_t shadow_storage[SSD1306_FIXED_LEAD + SSD1306_FIXED_BUFSIZE] __attribute__((aligned(8)));
+  uint8_t tx_storage[SSD1306_FIXED_BUFSIZE] __attribute__((aligned(4)));
+  uint16_t dma_storage[SSD1306_FIXED_DMA_CAPACITY] __attribute__((aligned(4)));
+#endif
+};
+
+// Texto pré-renderizado: colunas de 8 linhas já no formato do buffer
+#define SSD1306_TEXT_MAX_COLUMNS 128
 
-void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
+typedef struct {
+  uint8_t width;
+  uint8_t columns[SSD1306_TEXT_MAX_COLUMNS];
+} ssd1306_text_t;
+
+bool ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
+void ssd1306_deinit(ssd1306_t *ssd);
+void ssd1306_set_transport(ssd1306_t *ssd, const ssd1306_transport_t *transport, void *bus);
 void ssd1306_config(ssd1306_t *ssd);
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);
+void ssd1306_command_list(ssd1306_t *ssd, const uint8_t *commands, size_t count);
+void ssd1306_contrast(ssd1306_t *ssd, uint8_t value);
 void ssd1306_send_data(ssd1306_t *ssd);
+void ssd1306_invalidate(ssd1306_t *ssd);
+void ssd1306_send_data_async(ssd1306_t *ssd);
+bool ssd1306_is_busy(ssd1306_t *ssd);
+void ssd1306_wait(ssd1306_t *ssd);
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
 void ssd1306_fill(ssd1306_t *ssd, bool value);
@@ -45,5 +121,13 @@ void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint
 void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value);
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value);
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value);
+void ssd1306_blit(ssd1306_t *ssd, const uint8_t *sprite, uint8_t width, uint8_t height, int x, int y, bool value);
 void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y);
-void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
\ No newline at end of file
+void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
+uint8_t ssd1306_draw_string_prop(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
+uint16_t ssd1306_text_width(const char *str, bool proportional);
+void ssd1306_text_render(ssd1306_text_t *text, const char *str, bool proportional);
+void ssd1306_draw_text(ssd1306_t *ssd, const ssd1306_text_t *text, int x, int y);
+void ssd1306_copy_view(ssd1306_t *dst, const ssd1306_t *src, uint8_t x, uint8_t page, bool flip);
+
+#endif
@@ -0,0 +1,141 @@
+#include "ssd1306_spi.h"
+
+#if PICO_ON_DEVICE
+#include "hardware/clocks.h"
+#include "ssd1306_spi.pio.h"
+#endif
+
+// Segmento em palavras do programa PIO. No SPI não há cabeçalho nem STOP:
+// a troca de D/C# entre palavras já separa comandos de dados.
+void ssd1306_spi_queue(ssd1306_t *ssd, const uint8_t *bytes, size_t count, bool command) {
+  uint16_t *out = &ssd->dma_buffer[ssd->dma_len];
+  for (size_t i = 0; i < count; ++i)
+    out[i] = ssd1306_spi_word(bytes[i], command);
+  ssd->dma_len += count;
+}
+
+#if PICO_ON_DEVICE
+
+static inline uint32_t ssd1306_spi_stall_mask(const ssd1306_spi_t *spi) {
+  return 1u << (PIO_FDEBUG_TXSTALL_LSB + spi->sm);
+}
+
+// Espera o FIFO esvaziar e a máquina de estados parar sem dados, ou seja,
+// o último bit já saiu. TXSTALL só é limpo com o FIFO vazio: o flag sobe
+// de novo enquanto a máquina espera dados, e limpo antes dele esvaziar
+// poderia subir num intervalo entre palavras.
+static void ssd1306_spi_wait_idle(const ssd1306_spi_t *spi) {
+  while (!pio_sm_is_tx_fifo_empty(spi->pio, spi->sm))
+    tight_loop_contents();
+  spi->pio->fdebug = ssd1306_spi_stall_mask(spi);
+  while (!(spi->pio->fdebug & ssd1306_spi_stall_mask(spi)))
+    tight_loop_contents();
+}
+
+// A palavra de 16 bits vai na metade de cima do OSR, que desloca para a esquerda
+static void ssd1306_spi_write(const ssd1306_spi_t *spi, const uint8_t *bytes, size_t count, bool command) {
+  for (size_t i = 0; i < count; ++i)
+    pio_sm_put_blocking(spi->pio, spi->sm, (uint32_t)ssd1306_spi_word(bytes[i], command) << 16);
+  ssd1306_spi_wait_idle(spi);
+}
+
+static void ssd1306_spi_commands(ssd1306_t *ssd, const uint8_t *commands, size_t count) {
+  ssd1306_spi_write(ssd->bus, commands, count, true);
+}
+
+// buffer[0] é o byte de controle do I2C, que não existe no SPI
+static void ssd1306_spi_data(ssd1306_t *ssd, const uint8_t *buffer, size_t len) {
+  ssd1306_spi_write(ssd->bus, buffer + 1, len - 1, false);
+}
+
+// Escritas de 16 bits no TXF são replicadas nas duas metades da palavra,
+// e o programa consome só a de cima
+static void ssd1306_spi_start(ssd1306_t *ssd) {
+  ssd1306_spi_t *spi = ssd->bus;
+  if (ssd->dma_channel < 0)
+    ssd->dma_channel = dma_claim_unused_channel(true);
+
+  spi->drained = false;
+  dma_channel_config config = dma_channel_get_default_config(ssd->dma_channel);
+  channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+  channel_config_set_read_increment(&config, true);
+  channel_config_set_write_increment(&config, false);
+  channel_config_set_dreq(&config, pio_get_dreq(spi->pio, spi->sm, true));
+  dma_channel_configure(
+    ssd->dma_channel,
+    &config,
+    &spi->pio->txf[spi->sm],
+    ssd->dma_buffer,
+    ssd->dma_len,
+    true
+  );
+}
+
+// Ocupado enquanto o DMA anda ou o FIFO tem palavras. Um TXSTALL desse
+// período pode ser de antes do envio ou de um DMA que atrasou (a máquina
+// esvaziou o FIFO no meio do envio), então só depois dos dois o flag é
+// limpo, uma vez, e o envio termina quando ele voltar a subir: a última
+// palavra saiu do OSR.
+static bool ssd1306_spi_busy(ssd1306_t *ssd) {
+  ssd1306_spi_t *spi = ssd->bus;
+  if (ssd->dma_channel < 0)
+    return false;
+  if (dma_channel_is_busy(ssd->dma_channel) || !pio_sm_is_tx_fifo_empty(spi->pio, spi->sm))
+    return true;
+  if (!spi->drained) {
+    spi->pio->fdebug = ssd1306_spi_stall_mask(spi);
+    spi->drained = true;
+  }
+  return !(spi->pio->fdebug & ssd1306_spi_stall_mask(spi));
+}
+
+const ssd1306_transport_t ssd1306_spi_transport = {
+  .commands = ssd1306_spi_commands,
+  .data = ssd1306_spi_data,
+  .queue = ssd1306_spi_queue,
+  .start = ssd1306_spi_start,
+  .busy = ssd1306_spi_busy,
+  .segment_overhead = 0,
+};
+
+// Carrega o programa, configura os pinos e reinicia o controlador (RES# em
+// nível baixo por pelo menos 3 us). CS# fica sempre ativo: o painel é o
+// único dispositivo no barramento.
+void ssd1306_spi_init(ssd1306_spi_t *spi, PIO pio, uint8_t pin_sck, uint8_t pin_dc, uint8_t pin_cs,
+                      uint8_t pin_reset, uint32_t baud) {
+  spi->pio = pio;
+  spi->pin_sck = pin_sck;
+  spi->pin_dc = pin_dc;
+  spi->pin_cs = pin_cs;
+  spi->pin_reset = pin_reset;
+  spi->drained = true;
+
+  gpio_init(pin_cs);
+  gpio_set_dir(pin_cs, GPIO_OUT);
+  gpio_put(pin_cs, 0);
+  gpio_init(pin_reset);
+  gpio_set_dir(pin_reset, GPIO_OUT);
+  gpio_put(pin_reset, 0);
+  sleep_us(10);
+  gpio_put(pin_reset, 1);
+  sleep_us(10);
+
+  uint offset = pio_add_program(pio, &ssd1306_spi_program);
+  spi->sm = pio_claim_unused_sm(pio, true);
+  pio_gpio_init(pio, pin_sck);
+  pio_gpio_init(pio, pin_dc);
+  pio_gpio_init(pio, pin_dc + 1);
+  pio_sm_set_consecutive_pindirs(pio, spi->sm, pin_sck, 1, true);
+  pio_sm_set_consecutive_pindirs(pio, spi->sm, pin_dc, 2, true);
+
+  pio_sm_config config = ssd1306_spi_program_get_default_config(offset);
+  sm_config_set_out_pins(&config, pin_dc, 2);
+  sm_config_set_sideset_pins(&config, pin_sck);
+  sm_config_set_out_shift(&config, false, true, 16);
+  sm_config_set_fifo_join(&config, PIO_FIFO_JOIN_TX);
+  sm_config_set_clkdiv(&config, (float)clock_get_hz(clk_sys) / (2.0f * baud));
+  pio_sm_init(pio, spi->sm, offset, &config);
+  pio_sm_set_enabled(pio, spi->sm, true);
+}
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef SSD1306_SPI_H
+#define SSD1306_SPI_H
+
+#include "ssd1306.h"
+
+#if PICO_ON_DEVICE
+#include "hardware/pio.h"
+#endif
+
+// Transporte SPI de 4 fios (SCK, MOSI, D/C#, CS#) gerado por um programa PIO
+// (ssd1306_spi.pio). O nível de D/C# vai junto de cada byte no FIFO, então
+// comandos e dados se alternam no mesmo envio por DMA, como no I2C. O
+// SSD1306 aceita SCK de até 10 MHz. MOSI precisa ser o pino seguinte a D/C#.
+
+#define SSD1306_SPI_BAUD 10000000
+
+typedef struct {
+#if PICO_ON_DEVICE
+  PIO pio;
+  uint sm;
+  bool drained;               // TXSTALL já limpo depois do fim do DMA do envio
+#endif
+  uint8_t pin_sck, pin_dc, pin_cs, pin_reset;
+} ssd1306_spi_t;
+
+// Palavra do programa PIO: o bit i do byte vai no bit 2i + 1 (MOSI) e os
+// bits pares levam D/C# (0 em comandos, 1 em dados)
+static inline uint16_t ssd1306_spi_word(uint8_t byte, bool command) {
+  uint16_t bits = byte;
+  bits = (bits | bits << 4) & 0x0F0F;
+  bits = (bits | bits << 2) & 0x3333;
+  bits = (bits | bits << 1) & 0x5555;
+  return (bits << 1) | (command ? 0x0000 : 0x5555);
+}
+
+void ssd1306_spi_queue(ssd1306_t *ssd, const uint8_t *bytes, size_t count, bool command);
+
+#if PICO_ON_DEVICE
+extern const ssd1306_transport_t ssd1306_spi_transport;
+
+void ssd1306_spi_init(ssd1306_spi_t *spi, PIO pio, uint8_t pin_sck, uint8_t pin_dc, uint8_t pin_cs,
+                      uint8_t pin_reset, uint32_t baud);
+#endif
+
+#endif
@@ -21,177 +21,528 @@
 #include <stdio.h>                                                                                              // Biblioteca padrão de entrada/saída
 #include <stdlib.h>                                                                                             // Biblioteca padrão de funções gerais
 #include <string.h>                                                                                             // Biblioteca para manipulação de strings
+#include <stdatomic.h>                                                                                          // Pedidos do núcleo 0 ao agendador do núcleo 1
 #include "pico/stdlib.h"                                                                                        // Biblioteca específica do Raspberry Pi Pico
 #include "hardware/i2c.h"                                                                                       // Biblioteca para comunicação I2C
-#include "hardware/adc.h"                                                                                       // Biblioteca para conversão analógica-digital
+#include "hardware/uart.h"                                                                                      // UART do enlace entre placas
+#include "hardware/irq.h"                                                                                       // Interrupção de recepção da UART
+#include "hardware/sync.h"                                                                                      // WFE/SEV para dormir entre prazos
+#include "pico/unique_id.h"                                                                                     // Id da placa, para sortear os lados no enlace
+#include "pico/multicore.h"                                                                                     // Biblioteca para uso do segundo núcleo
 #include "libs/ssd1306/ssd1306.h"                                                                               // Biblioteca do display SSD1306
-#include "libs/ssd1306/font.h"                                                                                  // Biblioteca de fontes para o display
-
-// Dimensões da tela
-#define LARGURA 128                                                                                             // Largura total do display em pixels
-#define ALTURA 64                                                                                               // Altura total do display em pixels
-
-// Dimensões da raquete
-#define LARGURA_RAQUETE 4                                                                                       // Largura horizontal da raquete
-#define ALTURA_RAQUETE 16                                                                                       // Altura vertical da raquete  
-#define VELOCIDADE_RAQUETE 2                                                                                    // Velocidade de movimento das raquetes
-
-// Parâmetros da bola
-#define TAMANHO_BOLA 4                                                                                          // Tamanho do lado do quadrado da bola
-#define VELOCIDADE_BOLA 2                                                                                       // Velocidade base de movimento da bola
-
-// Definições de GPIO
-#define PINO_SDA 14                                                                                             // Pino GPIO para SDA (dados I2C)
-#define PINO_SCL 15                                                                                             // Pino GPIO para SCL (clock I2C)
-#define JOYSTICK_Y 27                                                                                           // Pino ADC para eixo Y do joystick
-
-// Inicialização do display
-ssd1306_t disp;                                                                                                 // Estrutura de controle do display OLED
-
-// Estrutura do estado do jogo
-struct EstadoJogo {
-    int jogador_y;                                                                                              // Posição Y da raquete do jogador
-    int ia_y;                                                                                                   // Posição Y da raquete da IA
-    int direcao_ia;                                                                                             // Direção atual do movimento da IA
-    int bola_x;                                                                                                 // Posição X atual da bola
-    int bola_y;                                                                                                 // Posição Y atual da bola
-    int bola_dx;                                                                                                // Direção horizontal da bola (+/- velocidade)
-    int bola_dy;                                                                                                // Direção vertical da bola (+/- velocidade)
-    int pontuacao_jogador;                                                                                      // Pontos acumulados pelo jogador
-    int pontuacao_ia;                                                                                           // Pontos acumulados pela IA
+#include "libs/ssd1306/ssd1306_spi.h"                                                                           // Transporte SPI do display (PIO)
+#include "jogo.h"                                                                                               // Estado e regras do jogo
+#include "libs/spsc/spsc.h"                                                                                     // Fila sem trava entre os núcleos
+#include "libs/scheduler/scheduler.h"                                                                           // Agendador de passo fixo e telemetria de quadros
+#include "libs/netplay/netplay.h"                                                                               // Partida entre duas placas com rollback
+#include "libs/fbstream/fbstream.h"                                                                             // Quadros comprimidos para o visualizador no host
+
+// Painéis: um só, o mesmo quadro em dois, ou a cena dividida em dois painéis de 128x32 (metade de cima e
+// de baixo). O segundo painel fica no i2c0 (GP4/GP5), deixando GP0/GP1 livres para a UART.
+#define PAINEL_UNICO 0
+#define PAINEIS_ESPELHO 1
+#define PAINEIS_DIVIDIDO 2
+#define MODO_PAINEIS PAINEL_UNICO
+
+// Transporte do painel principal: o I2C da BitDogLab ou um painel SPI de 4 fios (PIO a 10 MHz, ~28x mais
+// rápido por quadro inteiro). No SPI, MOSI é o pino seguinte ao D/C#.
+#define DISPLAY_I2C 0
+#define DISPLAY_SPI 1
+#define TRANSPORTE_DISPLAY DISPLAY_I2C
+#define SPI_SCK 18
+#define SPI_DC 19                                                                                               // MOSI no GPIO 20
+#define SPI_CS 17
+#define SPI_RESET 16
+
+// Adversário: a IA ou outra placa ligada pela UART0 (GP0 TX e GP1 RX, cruzados entre as placas, e GND comum).
+// Em rede só as entradas do joystick trafegam; as duas placas simulam a mesma partida e a raquete local
+// responde sem atraso, corrigindo a previsão da remota por rollback. Cada placa joga com a raquete que lhe
+// cabe no sorteio (id da placa), e as duas veem a mesma cena.
+#define JOGO_CONTRA_IA 0
+#define JOGO_EM_REDE 1
+#define MODO_JOGO JOGO_CONTRA_IA
+#define UART_REDE uart0
+#define UART_REDE_TX 0
+#define UART_REDE_RX 1
+#define UART_REDE_BAUD 115200                                                                                   // ~190 bytes por tick a 60Hz; o jogo usa ~20
+#define BOLAS 1                                                                                                 // 1: partida clássica; 2 a PHYS_BALLS_MAX (64): multibola
+#define CAPACIDADE_RX_REDE 256                                                                                  // Bytes recebidos entre dois ticks (potência de 2)
+
+typedef struct {
+    i2c_inst_t* i2c;                                                                                            // Controlador I2C do painel
+    uint8_t pino_sda, pino_scl;
+    uint8_t altura;                                                                                             // 64 ou 32 linhas
+    uint8_t pagina;                                                                                             // Primeira página da cena mostrada
+    bool espelhado;                                                                                             // Colunas em ordem inversa
+} painel_config_t;
+
+static const painel_config_t config_paineis[] = {
+#if MODO_PAINEIS == PAINEIS_DIVIDIDO
+    { i2c1, 14, 15, 32, 0, false },                                                                             // Metade de cima
+    { i2c0, 4, 5, 32, 4, false },                                                                               // Metade de baixo
+#else
+    { i2c1, 14, 15, 64, 0, false },                                                                             // Painel da BitDogLab
+#if MODO_PAINEIS == PAINEIS_ESPELHO
+    { i2c0, 4, 5, 64, 0, false },                                                                               // Cópia do primeiro
+#endif
+#endif
 };
+#define NUM_PAINEIS (sizeof(config_paineis) / sizeof(config_paineis[0]))
+
+#if MODO_PAINEIS == PAINEIS_DIVIDIDO && SSD1306_FIXED
+#error "PAINEIS_DIVIDIDO mistura painéis de 32 e 64 linhas: use o driver de geometria dinâmica"
+#endif
+
+// Modo de execução
+#define PIPELINE_DOIS_NUCLEOS 1                                                                                 // 1: simulação no núcleo 0, renderização e display no núcleo 1
+#define PERIODO_SIMULACAO_US 16667                                                                              // Passo fixo da simulação (60Hz)
+#define PERIODO_QUADRO_US 16667                                                                                 // Período alvo de renderização (quadros atrasados são pulados)
+#define CAPACIDADE_GRAVACAO 8192                                                                                // Palavras de entrada gravadas (16 KB, até 16 ticks cada)
+#define PONTOS_GRAVACAO 1024                                                                                    // Hashes de verificação (um a cada 64 ticks)
+#define ECONOMIA_ENERGIA 1                                                                                      // 1: dorme em WFE entre prazos, pula quadros iguais e entra em demonstração parado
+#define MODO_ESPERA (ECONOMIA_ENERGIA && MODO_JOGO == JOGO_CONTRA_IA)                                           // Em rede as duas placas seguem em lockstep, sem demonstração
+
+// Displays: cada painel tem o seu estado; a cena é desenhada uma vez e copiada para os demais
+static ssd1306_t paineis[NUM_PAINEIS];                                                                          // Estruturas de controle dos displays OLED
+#if TRANSPORTE_DISPLAY == DISPLAY_SPI
+static ssd1306_spi_t spi_display;                                                                               // Máquina de estados PIO do painel principal
+#endif
+#if MODO_PAINEIS == PAINEIS_DIVIDIDO
+static ssd1306_t tela;                                                                                          // Cena inteira, só em memória
+static ssd1306_t* const cena = &tela;
+#else
+static ssd1306_t* const cena = &paineis[0];                                                                     // O primeiro painel já tem o tamanho da cena
+#endif
+
+// Último instantâneo do estado do jogo (núcleo 0 -> núcleo 1); o núcleo 1 sempre desenha o mais recente
+static struct EstadoJogo quadros[SPSC_LATEST_SLOTS];                                                            // Publicado, em leitura e o que está sendo escrito
+static spsc_latest_t ultimo_quadro;                                                                             // Caixa "o último vence": publicar nunca descarta o instantâneo novo
+
+// Agendamento e telemetria: cada núcleo só escreve no próprio agendador
+static sched_t agendador;                                                                                       // Ticks do núcleo 0 (e quadros, com um núcleo só) e tempos por etapa
+#if PIPELINE_DOIS_NUCLEOS
+static sched_t agendador_quadros;                                                                               // Prazos de quadro e tempos de desenho/envio, do núcleo 1
+static sched_t* const agenda_quadros = &agendador_quadros;
+static _Atomic uint32_t periodo_quadro_pedido = PERIODO_QUADRO_US;                                              // Cadência pedida pelo núcleo 0; o núcleo 1 aplica no próprio agendador
+static _Atomic uint32_t zeragens_pedidas = 0;                                                                   // Comandos 'r'; o núcleo 1 zera a própria telemetria quando o número muda
+#else
+static sched_t* const agenda_quadros = &agendador;
+#endif
+
+// Economia de energia
+static struct Laco laco;                                                                                        // Partida, pausa pelo SEL, inatividade do joystick e IA da demonstração
+static struct Apresentacao apresentacao;                                                                        // Último quadro enviado e contraste, do núcleo do display
+static volatile uint8_t contraste_pedido = CONTRASTE_NORMAL;                                                    // Pedido pelo núcleo 0, aplicado pelo núcleo do display
+
+// Modo espectador: cada quadro desenhado sai pelo stdio (USB CDC, ou UART com pico_enable_stdio_uart)
+static fbstream_t captura;                                                                                      // Último quadro enviado e contadores
+static volatile bool captura_pedida = false;                                                                    // Comando 'c' no núcleo 0; o núcleo do display transmite
+
+// Gravação da sessão em RAM para reprodução determinística
+static struct EstadoJogo gravacao_inicio;                                                                       // Instantâneo do estado no início da gravação
+static struct EstadoJogo gravacao_reproducao;                                                                   // Estado de trabalho da reprodução
+static uint16_t gravacao_entradas[CAPACIDADE_GRAVACAO];                                                         // Entradas por tick, compactadas
+static replay_checkpoint_t gravacao_pontos[PONTOS_GRAVACAO];                                                    // Hashes do estado a cada 64 ticks
+static replay_t gravacao;
+
+#if MODO_JOGO == JOGO_EM_REDE
+// Enlace entre as placas: a interrupção da UART enche a fila e o laço da simulação a esvazia
+static uint8_t rede_rx[CAPACIDADE_RX_REDE];
+static spsc_queue_t fila_rx_rede;
+static uint8_t rede_instantaneos[NETPLAY_SNAPSHOTS][sizeof(struct EstadoJogo)];                                 // Estado antes de cada tick que pode ser refeito
+static netplay_t rede;
+#endif
 
 void inicializar_display() {
-    i2c_init(i2c1, 400000);                                                                                     // Inicializa interface I2C a 400kHz
-    gpio_set_function(PINO_SDA, GPIO_FUNC_I2C);                                                                 // Configura pino SDA para função I2C
-    gpio_set_function(PINO_SCL, GPIO_FUNC_I2C);                                                                 // Configura pino SCL para função I2C
-    gpio_pull_up(PINO_SDA);                                                                                     // Habilita resistor pull-up no SDA
-    gpio_pull_up(PINO_SCL);                                                                                     // Habilita resistor pull-up no SCL
+    for (unsigned i = 0; i < NUM_PAINEIS; ++i) {
+        const painel_config_t* config = &config_paineis[i];
+#if TRANSPORTE_DISPLAY == DISPLAY_SPI
+        if (i == 0) {
+            if (!ssd1306_init(&paineis[0], LARGURA, config->altura, false, 0x3C, NULL)) {
+                panic("display 0: geometria ou memoria");
+            }
+            ssd1306_spi_init(&spi_display, pio0, SPI_SCK, SPI_DC, SPI_CS, SPI_RESET, SSD1306_SPI_BAUD);
+            ssd1306_set_transport(&paineis[0], &ssd1306_spi_transport, &spi_display);                           // Comandos e dados pelo PIO
+            ssd1306_config(&paineis[0]);
+            continue;
+        }
+#endif
+        i2c_init(config->i2c, 400000);                                                                          // Inicializa interface I2C a 400kHz
+        gpio_set_function(config->pino_sda, GPIO_FUNC_I2C);                                                     // Configura pino SDA para função I2C
+        gpio_set_function(config->pino_scl, GPIO_FUNC_I2C);                                                     // Configura pino SCL para função I2C
+        gpio_pull_up(config->pino_sda);                                                                         // Habilita resistor pull-up no SDA
+        gpio_pull_up(config->pino_scl);                                                                         // Habilita resistor pull-up no SCL
+
+        if (!ssd1306_init(&paineis[i], LARGURA, config->altura, false, 0x3C, config->i2c)) {                    // Inicializa display com endereço 0x3C
+            panic("display %u: geometria ou memoria", i);                                                       // Geometria fora da fixada no build ou sem heap
+        }
+        ssd1306_config(&paineis[i]);                                                                            // Configuração adicional do display
+    }
+#if MODO_PAINEIS == PAINEIS_DIVIDIDO
+    if (!ssd1306_init(&tela, LARGURA, ALTURA, false, 0x3C, NULL)) {                                             // Cena sem barramento
+        panic("cena: sem memoria");
+    }
+#endif
+    ssd1306_fill(cena, false);                                                                                  // Limpa o display (preenche com preto)
+}
+
+// Copia a cena para os painéis que não a desenham diretamente
+void copiar_cena() {
+    PROF_BEGIN(PROF_COPIAR_CENA);
+    for (unsigned i = 0; i < NUM_PAINEIS; ++i) {
+        if (&paineis[i] != cena) {
+            ssd1306_copy_view(&paineis[i], cena, 0, config_paineis[i].pagina, config_paineis[i].espelhado);
+        }
+    }
+    PROF_END(PROF_COPIAR_CENA);
+}
+
+uint64_t relogio_placa(void* contexto) {
+    return time_us_64();                                                                                        // Microssegundos desde o boot (timer do RP2040)
+}
+
+#if MODO_JOGO == JOGO_EM_REDE
+void uart_rede_irq() {
+    while (uart_is_readable(UART_REDE)) {
+        uint8_t byte = uart_getc(UART_REDE);
+        spsc_push(&fila_rx_rede, &byte);                                                                        // Fila cheia: o byte se perde e o CRC descarta o pacote
+    }
+}
+
+size_t ler_rede(void* io, uint8_t* dados, size_t tamanho) {
+    size_t lidos = 0;
+    while (lidos < tamanho && spsc_pop(&fila_rx_rede, &dados[lidos])) {                                        // Só o que já chegou, sem esperar
+        lidos++;
+    }
+    return lidos;
+}
 
-    ssd1306_init(&disp, LARGURA, ALTURA, false, 0x3C, i2c1);                                                    // Inicializa display com endereço 0x3C
-    ssd1306_config(&disp);                                                                                      // Configuração adicional do display
-    ssd1306_fill(&disp, false);                                                                                 // Limpa o display (preenche com preto)
-    ssd1306_send_data(&disp);                                                                                   // Envia buffer para o display
+void escrever_rede(void* io, const uint8_t* dados, size_t tamanho) {
+    uart_write_blocking(UART_REDE, dados, tamanho);                                                             // Cabe no FIFO de 32 bytes na maior parte dos ticks
 }
 
-void inicializar_jogo(struct EstadoJogo* estado) {
-    estado->jogador_y = (ALTURA - ALTURA_RAQUETE) / 2;                                                          // Centraliza raquete do jogador verticalmente
-    estado->ia_y = (ALTURA - ALTURA_RAQUETE) / 2;                                                               // Centraliza raquete da IA verticalmente
-    estado->bola_x = LARGURA / 2;                                                                               // Posiciona bola no centro horizontal
-    estado->bola_y = ALTURA / 2;                                                                                // Posiciona bola no centro vertical
-    estado->bola_dx = -VELOCIDADE_BOLA;                                                                         // Define direção inicial da bola para esquerda
-    estado->bola_dy = VELOCIDADE_BOLA;                                                                          // Define direção vertical inicial para baixo
-    estado->direcao_ia = 1;                                                                                     // Direção inicial da IA
-    estado->pontuacao_jogador = 0;                                                                              // Zera pontuação do jogador
-    estado->pontuacao_ia = 0;                                                                                   // Zera pontuação da IA
+void inicializar_rede(struct EstadoJogo* estado) {
+    pico_unique_board_id_t id;
+    pico_get_unique_board_id(&id);
+    uint32_t nonce = 2166136261u;                                                                               // FNV-1a do id da placa
+    for (unsigned i = 0; i < PICO_UNIQUE_BOARD_ID_SIZE_BYTES; ++i) {
+        nonce = (nonce ^ id.id[i]) * 16777619u;
+    }
+
+    spsc_init(&fila_rx_rede, rede_rx, 1, CAPACIDADE_RX_REDE);
+    netplay_init(&rede, estado, sizeof(*estado), &rede_instantaneos[0][0], passo_em_rede, hash_estado,
+                 ler_rede, escrever_rede, NULL, nonce);
+
+    uart_init(UART_REDE, UART_REDE_BAUD);
+    gpio_set_function(UART_REDE_TX, GPIO_FUNC_UART);
+    gpio_set_function(UART_REDE_RX, GPIO_FUNC_UART);
+    uart_set_fifo_enabled(UART_REDE, true);
+    irq_set_exclusive_handler(UART0_IRQ, uart_rede_irq);
+    irq_set_enabled(UART0_IRQ, true);
+    uart_set_irq_enables(UART_REDE, true, false);                                                               // Interrupção só na recepção
 }
+#endif
 
-void ler_joystick(struct EstadoJogo* estado) {
-    adc_select_input(1);                                                                                        // Seleciona canal ADC1 (GPIO27)
-    uint16_t valor_adc = adc_read();                                                                            // Lê valor bruto do ADC (0-4095)
-    estado->jogador_y = (ALTURA - ALTURA_RAQUETE) - (valor_adc * (ALTURA - ALTURA_RAQUETE)) / 4096;             // Mapeia valor ADC para posição Y
+int64_t acordar_nucleos(alarm_id_t id, void* dados) {
+    __sev();                                                                                                    // Tira os dois núcleos do WFE
+    return 0;
 }
 
-void atualizar_ia(struct EstadoJogo* estado) {
-    if (estado->ia_y + ALTURA_RAQUETE / 2 < estado->bola_y) {                                                   // Se centro da raquete está abaixo da bola
-        estado->ia_y += VELOCIDADE_RAQUETE;                                                                     // Move raquete para baixo
-    } else if (estado->ia_y + ALTURA_RAQUETE / 2 > estado->bola_y) {                                            // Se centro da raquete está acima da bola
-        estado->ia_y -= VELOCIDADE_RAQUETE;                                                                     // Move raquete para cima
+// Dorme até o prazo, contando o sono no agendador do núcleo. Com ECONOMIA_ENERGIA o núcleo para em WFE e
+// um alarme do timer manda o evento no prazo; interrupções (ADC a cada bloco de 64 amostras, ~4 ms, e USB)
+// e o SEV do outro núcleo também o acordam, e o sono termina antes do prazo se acordar (opcional) disser
+// que sim. Um evento que chegue entre o teste e o WFE fica registrado e o WFE retorna na hora. Retorna
+// true se acordou antes do prazo.
+bool dormir_ate(sched_t* agenda, uint64_t prazo, bool (*acordar)(void)) {
+    unsigned nucleo = get_core_num();
+    bool antes = false;
+    sched_sleep_begin(agenda, nucleo);                                                                          // Tempo dormindo, para o ciclo de trabalho
+#if ECONOMIA_ENERGIA
+    alarm_id_t alarme = add_alarm_at(from_us_since_boot(prazo), acordar_nucleos, NULL, false);
+    while (time_us_64() < prazo) {
+        if (acordar && acordar()) {
+            antes = true;
+            break;
+        }
+        __wfe();
+    }
+    if (alarme > 0) {
+        cancel_alarm(alarme);
     }
+#else
+    sleep_until(from_us_since_boot(prazo));
+#endif
+    sched_sleep_end(agenda, nucleo);
+    return antes;
+}
 
-    if (estado->ia_y < 0) estado->ia_y = 0;                                                                     // Limita movimento superior da raquete
-    if (estado->ia_y > ALTURA - ALTURA_RAQUETE) estado->ia_y = ALTURA - ALTURA_RAQUETE;                         // Limita movimento inferior
+// Na demonstração, o núcleo 0 acorda assim que mexem no joystick
+bool acordar_na_demonstracao(void) {
+    return laco.espera.ativa && joystick_mexeu(&laco.espera, input_latest());
 }
 
-void atualizar_bola(struct EstadoJogo* estado) {
-    estado->bola_x += estado->bola_dx;                                                                          // Atualiza posição horizontal da bola
-    estado->bola_y += estado->bola_dy;                                                                          // Atualiza posição vertical da bola
+void passo_simulacao(struct EstadoJogo* estado) {
+    PROF_BEGIN(PROF_PASSO_SIMULACAO);
+#if MODO_JOGO == JOGO_EM_REDE
+    sched_stage_begin(&agendador, SCHED_STAGE_INPUT);
+    uint16_t entrada = valor_joystick();                                                                        // Entrada local, aplicada já neste tick
+    sched_stage_end(&agendador, SCHED_STAGE_INPUT);
+
+    sched_stage_begin(&agendador, SCHED_STAGE_PHYSICS);
+    netplay_tick(&rede, entrada);                                                                               // Recebe, refaz ticks previstos errado, simula e envia
+    sched_stage_end(&agendador, SCHED_STAGE_PHYSICS);                                                         // Sem IA; gravação só contra a IA
+#else
+    sched_stage_begin(&agendador, SCHED_STAGE_INPUT);
+    uint16_t entrada = ler_joystick(estado);                                                                    // Lê entrada do jogador
+    sched_stage_end(&agendador, SCHED_STAGE_INPUT);
 
-    if (estado->bola_y <= 0 || estado->bola_y >= ALTURA - TAMANHO_BOLA) {                                       // Verifica colisão com bordas superior/inferior
-        estado->bola_dy *= -1;                                                                                  // Inverte direção vertical
+    sched_stage_begin(&agendador, SCHED_STAGE_AI);
+    atualizar_ia(estado);                                                                                       // Atualiza IA
+    sched_stage_end(&agendador, SCHED_STAGE_AI);
+
+    sched_stage_begin(&agendador, SCHED_STAGE_PHYSICS);
+    atualizar_bola(estado);                                                                                     // Atualiza física da bola
+    sched_stage_end(&agendador, SCHED_STAGE_PHYSICS);
+
+    if (gravacao.recording) {
+        replay_record(&gravacao, entrada, hash_estado(estado));                                                 // Entrada do tick e hash do estado resultante
     }
+#endif
+    PROF_END(PROF_PASSO_SIMULACAO);
+}
+
+// Troca a cadência de ticks e de quadros. Com dois núcleos, o de quadros é pedido ao núcleo 1, que o
+// aplica no próprio agendador
+void mudar_cadencia(uint32_t periodo_tick, uint32_t periodo_quadro) {
+#if PIPELINE_DOIS_NUCLEOS
+    sched_set_periods(&agendador, periodo_tick, periodo_tick);                                                  // Só os ticks; os quadros são do agendador do núcleo 1
+    atomic_store(&periodo_quadro_pedido, periodo_quadro);
+    __sev();                                                                                                    // Tira o núcleo 1 do WFE para aplicar já
+#else
+    sched_set_periods(&agendador, periodo_tick, periodo_quadro);
+#endif
+}
 
-    if (estado->bola_x <= LARGURA_RAQUETE &&                                                                    // Verifica colisão com raquete do jogador
-        estado->bola_y + TAMANHO_BOLA >= estado->jogador_y && 
-        estado->bola_y <= estado->jogador_y + ALTURA_RAQUETE) {
-        estado->bola_dx *= -1;                                                                                  // Inverte direção horizontal
+// Pausa pelo SEL e troca entre a partida e a demonstração conforme a atividade no joystick
+void verificar_atividade(struct EstadoJogo* estado) {
+    if (!verificar_espera(&laco, estado, time_us_64(), input_latest())) {
+        return;
+    }
+    if (laco.espera.ativa) {
+        mudar_cadencia(PERIODO_ESPERA_US, PERIODO_ESPERA_US);                                                   // Demonstração em baixa taxa
+        contraste_pedido = CONTRASTE_ESPERA;
+        if (gravacao.recording) {                                                                               // Os ticks da demonstração não são gravados; a gravação termina no último tick da partida
+            replay_stop(&gravacao);
+            printf("gravacao encerrada pela demonstracao: %lu ticks em %lu palavras\n", (unsigned long)gravacao.ticks,
+                   (unsigned long)gravacao.len);
+        }
+    } else {
+        mudar_cadencia(PERIODO_SIMULACAO_US, PERIODO_QUADRO_US);                                                // Partida nova já no próximo tick
+        contraste_pedido = CONTRASTE_NORMAL;
     }
+}
 
-    if (estado->bola_x >= LARGURA - LARGURA_RAQUETE - TAMANHO_BOLA &&                                           // Verifica colisão com raquete da IA
-        estado->bola_y + TAMANHO_BOLA >= estado->ia_y && 
-        estado->bola_y <= estado->ia_y + ALTURA_RAQUETE) {
-        estado->bola_dx *= -1;                                                                                  // Inverte direção horizontal
+// Exporta em binário (perfil, quadros), sem a conversão de \n para \r\n do stdio
+void escrever_binario(void* contexto, const uint8_t* dados, size_t tamanho) {
+    while (tamanho--) {
+        putchar_raw(*dados++);
     }
+}
 
-    if (estado->bola_x < 0) {                                                                                   // Bola passou pela raquete esquerda
-        estado->pontuacao_ia++;                                                                                 // Incrementa pontuação da IA
-        estado->jogador_y = (ALTURA - ALTURA_RAQUETE) / 2;                                                      // Reposiciona raquete do jogador
-        estado->ia_y = (ALTURA - ALTURA_RAQUETE) / 2;                                                           // Reposiciona raquete da IA
-        estado->bola_x = LARGURA / 2;                                                                           // Reposiciona bola no centro X
-        estado->bola_y = ALTURA / 2;                                                                            // Reposiciona bola no centro Y
-        estado->bola_dx = -VELOCIDADE_BOLA;                                                                     // Reinicia direção horizontal
-        estado->bola_dy = VELOCIDADE_BOLA;                                                                      // Reinicia direção vertical
+// Envia a cena recém-desenhada como diferença comprimida contra o último quadro enviado; ao ligar, o
+// primeiro vai inteiro. O DMA do envio ao painel só lê o buffer, então os dois podem correr juntos.
+void transmitir_quadro(void) {
+    static bool transmitindo = false;
+    if (captura_pedida != transmitindo) {
+        transmitindo = captura_pedida;
+        if (transmitindo) {
+            fbstream_init(&captura, cena->width, cena->pages, escrever_binario, NULL);
+        }
     }
-    if (estado->bola_x > LARGURA) {                                                                             // Bola passou pela raquete direita
-        estado->pontuacao_jogador++;                                                                            // Incrementa pontuação do jogador
-        estado->jogador_y = (ALTURA - ALTURA_RAQUETE) / 2;                                                      // Reposiciona raquete do jogador
-        estado->ia_y = (ALTURA - ALTURA_RAQUETE) / 2;                                                           // Reposiciona raquete da IA
-        estado->bola_x = LARGURA / 2;                                                                           // Reposiciona bola no centro X
-        estado->bola_y = ALTURA / 2;                                                                            // Reposiciona bola no centro Y
-        estado->bola_dx = VELOCIDADE_BOLA;                                                                      // Reinicia direção horizontal
-        estado->bola_dy = VELOCIDADE_BOLA;                                                                      // Reinicia direção vertical
+    if (transmitindo) {
+        PROF_BEGIN(PROF_TRANSMITIR_QUADRO);
+        fbstream_frame(&captura, cena->ram_buffer + 1, (uint16_t)(time_us_64() / 1000));                        // Sem o byte de controle 0x40
+        PROF_END(PROF_TRANSMITIR_QUADRO);
     }
 }
 
-void desenhar_tela_inicial() {
-    ssd1306_fill(&disp, false);                                                                                 // Limpa o buffer do display
-    
-    ssd1306_draw_string(&disp, "EMBARCATECH", (LARGURA/2) - 44, (ALTURA/2) - 10);                               // Desenha texto centralizado
-    ssd1306_draw_string(&disp, "GAME", (LARGURA/2) - 16, (ALTURA/2) + 2);                                       // Desenha subtítulo
-    
-    ssd1306_send_data(&disp);                                                                                   // Atualiza display com novo buffer
+void renderizar_quadro(struct EstadoJogo* estado) {
+    PROF_BEGIN(PROF_RENDERIZAR_QUADRO);
+    sched_stage_begin(agenda_quadros, SCHED_STAGE_RASTER);
+    desenhar_jogo(cena, estado);                                                                                // Rasteriza a cena no buffer
+    copiar_cena();                                                                                              // Espelha ou divide entre os painéis
+    sched_stage_end(agenda_quadros, SCHED_STAGE_RASTER);
+
+    sched_stage_begin(agenda_quadros, SCHED_STAGE_FLUSH);
+    for (unsigned i = 0; i < NUM_PAINEIS; ++i) {
+        ssd1306_send_data_async(&paineis[i]);                                                                   // Envia por DMA sem bloquear; cada barramento em paralelo
+    }
+    sched_stage_end(agenda_quadros, SCHED_STAGE_FLUSH);
+    transmitir_quadro();                                                                                        // Modo espectador, se ligado
+    PROF_END(PROF_RENDERIZAR_QUADRO);
 }
 
-void desenhar_jogo(struct EstadoJogo* estado) {
-    ssd1306_fill(&disp, false);                                                                                 // Limpa o buffer do display
-    
-    ssd1306_rect(&disp, estado->jogador_y, 0, LARGURA_RAQUETE, ALTURA_RAQUETE, true, true);                     // Desenha raquete do jogador
-    ssd1306_rect(&disp, estado->ia_y, LARGURA - LARGURA_RAQUETE, LARGURA_RAQUETE, ALTURA_RAQUETE, true, true);  // Desenha raquete da IA
-    
-    ssd1306_rect(&disp, 0, 0, LARGURA, ALTURA, true, false);                                                    // Desenha borda do campo
+// Aplica o contraste pedido e desenha o quadro, a não ser que a cena seja igual à do último enviado
+void mostrar_quadro(struct EstadoJogo* quadro) {
+    if (apresentar_quadro(&apresentacao, quadro, contraste_pedido, paineis, NUM_PAINEIS, agenda_quadros)) {
+        renderizar_quadro(quadro);
+    }
+}
 
-    for (int x = 0; x < LARGURA; x += 8) {                                                                      // Desenha linha central tracejada
-        ssd1306_rect(&disp, x, ALTURA / 1 - 1, 3, 2, true, true); 
+void processar_comandos(struct EstadoJogo* estado) {
+    int comando = getchar_timeout_us(0);                                                                        // Lê um comando do stdio sem bloquear
+    if (comando == 't') {
+#if PIPELINE_DOIS_NUCLEOS
+        printf("nucleo 0 (ticks):\n");
+#endif
+        sched_print_report(&agendador);                                                                         // Imprime tempos de quadro e por etapa
+#if PIPELINE_DOIS_NUCLEOS
+        printf("nucleo 1 (quadros):\n");
+        sched_print_report(&agendador_quadros);                                                                 // Só leitura; os campos podem estar um quadro defasados
+#endif
+    } else if (comando == 'r') {
+        sched_reset_stats(&agendador);                                                                          // Zera a telemetria
+#if PIPELINE_DOIS_NUCLEOS
+        atomic_fetch_add(&zeragens_pedidas, 1);                                                                 // O núcleo 1 zera a dele
+#endif
+    } else if (comando == 'g') {
+        replay_start(&gravacao, estado);                                                                        // Começa a gravar a partir do estado atual
+        printf("gravando\n");
+    } else if (comando == 's') {
+        replay_stop(&gravacao);                                                                                 // Encerra a gravação
+        printf("gravacao: %lu ticks em %lu palavras%s\n", (unsigned long)gravacao.ticks,
+               (unsigned long)gravacao.len, gravacao.full ? " (memoria cheia)" : "");
+    } else if (comando == 'v') {
+        replay_result_t resultado;                                                                              // Reproduz o mais rápido possível e confere os hashes
+        uint64_t inicio = time_us_64();
+        replay_run(&gravacao, &gravacao_reproducao, reproduzir_passo, hash_estado, &resultado);
+        uint64_t duracao = time_us_64() - inicio;
+        printf("reproducao: %lu ticks em %lu us, %lu verificacoes, %lu divergencias (primeira no tick %lu), hash %08lx\n",
+               (unsigned long)resultado.ticks, (unsigned long)duracao, (unsigned long)resultado.checked,
+               (unsigned long)resultado.mismatches, (unsigned long)resultado.first_mismatch_tick,
+               (unsigned long)resultado.chain);
+    } else if (comando == 'd') {
+        static uint8_t instantaneo[TAMANHO_ESTADO_SERIALIZADO];                                                 // Texto para o host (bench_replay -i), com o instantâneo portátil
+        replay_dump(&gravacao, stdout, instantaneo, serializar_estado(&gravacao_inicio, instantaneo));
+    } else if (comando == 'c') {
+        captura_pedida = !captura_pedida;                                                                       // host/fbview decodifica a captura
+        const fbstream_stats_t* e = &captura.stats;
+        if (!captura_pedida && e->frames) {
+            printf("captura: %lu quadros (%lu inteiros), %lu bytes/quadro, max %lu, %lu:1\n", (unsigned long)e->frames,
+                   (unsigned long)e->keyframes, (unsigned long)(e->sent_bytes / e->frames), (unsigned long)e->max_packet,
+                   (unsigned long)(e->raw_bytes / e->sent_bytes));
+        }
+#if PROFILER_ENABLED
+    } else if (comando == 'p') {
+        profiler_dump(escrever_binario, NULL);                                                                  // Anéis dos dois núcleos (host/prof2chrome converte)
+        stdio_flush();
+#endif
+#if MODO_JOGO == JOGO_EM_REDE
+    } else if (comando == 'n') {
+        const netplay_stats_t* e = &rede.stats;                                                                 // Estado do enlace entre as placas
+        printf("rede: %s jogador %u, tick %lu (confirmado %lu), %lu paradas, %lu rollbacks (%lu ticks refeitos, max %lu), "
+               "%lu/%lu bytes env/rec, %lu pacotes ruins, %lu verificacoes, %lu divergencias\n",
+               rede.connected ? "conectado" : "aguardando", rede.local, (unsigned long)rede.tick,
+               (unsigned long)netplay_confirmed(&rede), (unsigned long)e->stalls, (unsigned long)e->rollbacks,
+               (unsigned long)e->resimulated, (unsigned long)e->max_resimulated, (unsigned long)e->bytes_sent,
+               (unsigned long)e->bytes_received, (unsigned long)e->bad_packets, (unsigned long)e->hash_checks,
+               (unsigned long)e->desyncs);
+#endif
     }
+}
 
-    ssd1306_rect(&disp, estado->bola_y, estado->bola_x, TAMANHO_BOLA, TAMANHO_BOLA, true, true);                // Desenha bola
-    
-    char placar[16];                                                                                            // Buffer para texto do placar
-    snprintf(placar, sizeof(placar), "%d - %d", estado->pontuacao_jogador, estado->pontuacao_ia);               // Formata placar
-    ssd1306_draw_string(&disp, placar, LARGURA/2 - 16, 5);                                                      // Desenha placar na posição calculada
-    
-    ssd1306_send_data(&disp);                                                                                   // Atualiza display com novo buffer
+#if PIPELINE_DOIS_NUCLEOS
+// O núcleo 1 acorda antes do prazo quando o núcleo 0 pede outra cadência (fim da demonstração)
+bool cadencia_pedida(void) {
+    return atomic_load(&periodo_quadro_pedido) != agendador_quadros.frame_us;
+}
+
+void nucleo1_renderizar() {
+    PROF_INIT_CORE();                                                                                           // SysTick do núcleo 1
+    static struct EstadoJogo quadro;                                                                            // Cópia local do último estado publicado (fora da pilha de 2 KB do núcleo 1)
+    uint32_t zeragens = 0;
+    sched_init(&agendador_quadros, PERIODO_QUADRO_US, PERIODO_QUADRO_US, relogio_placa, NULL);                  // Agendador só deste núcleo; os ticks não são usados
+    spsc_latest_take(&ultimo_quadro, &quadro);                                                                  // Primeiro instantâneo, publicado antes do lançamento
+    while (1) {                                                                                                 // Loop de renderização do núcleo 1
+        uint32_t periodo = atomic_load(&periodo_quadro_pedido);
+        if (periodo != agendador_quadros.frame_us) {
+            sched_set_periods(&agendador_quadros, periodo, periodo);                                            // Cadência pedida pelo núcleo 0 (demonstração ou partida)
+        }
+        uint32_t pedidas = atomic_load(&zeragens_pedidas);
+        if (pedidas != zeragens) {
+            zeragens = pedidas;
+            sched_reset_stats(&agendador_quadros);                                                              // Comando 'r' no núcleo 0
+        }
+        if (sched_frame_due(&agendador_quadros)) {                                                              // Só desenha quando vence o prazo do quadro
+            spsc_latest_take(&ultimo_quadro, &quadro);                                                          // Instantâneo mais recente; sem um novo, fica o anterior (quadro igual)
+            mostrar_quadro(&quadro);                                                                            // Rasteriza e envia ao display, se mudou
+        }
+        dormir_ate(&agendador_quadros, agendador_quadros.next_frame, cadencia_pedida);                          // Dorme até o próximo quadro ou até o núcleo 0 trocar a cadência
+    }
 }
+#endif
 
 int main() {
     stdio_init_all();                                                                                           // Inicializa todas as interfaces padrão
+    PROF_INIT_CORE();                                                                                           // SysTick do núcleo 0 (perfil por zonas, se compilado)
     inicializar_display();                                                                                      // Configura hardware do display
-    adc_init();                                                                                                 // Inicializa módulo ADC
-    adc_gpio_init(JOYSTICK_Y);                                                                                  // Configura pino do joystick como ADC
+    input_init(&configuracao_joystick);                                                                         // ADC em round-robin por DMA, fora do laço do jogo
 
-    desenhar_tela_inicial();                                                                                    // Exibe tela inicial
-    sleep_ms(3000);                                                                                             // Aguarda 3 segundos
+    desenhar_tela_inicial(cena);                                                                                // Exibe tela inicial
+    copiar_cena();
+    for (unsigned i = 0; i < NUM_PAINEIS; ++i) {
+        ssd1306_send_data(&paineis[i]);
+    }
+    absolute_time_t fim_abertura = make_timeout_time_ms(3000);                                                  // Aguarda 3 segundos ou o botão SEL
+    while (!input_latest().select && !time_reached(fim_abertura)) {
+        sleep_ms(10);
+    }
     
-    struct EstadoJogo estado;                                                                                   // Cria instância do estado do jogo
+    static struct EstadoJogo estado;                                                                            // Estado do jogo (~1,3 KB com as bolas da multibola, fora da pilha)
+#if BOLAS > 1
+    inicializar_multibola(&estado, BOLAS);                                                                      // Várias bolas em jogo ao mesmo tempo
+#else
     inicializar_jogo(&estado);                                                                                  // Inicializa valores do jogo
+#endif
+#if MODO_JOGO == JOGO_EM_REDE
+    inicializar_rede(&estado);                                                                                  // Mesmo estado inicial nas duas placas
+#endif
+    iniciar_laco(&laco, MODO_ESPERA, MODO_JOGO == JOGO_CONTRA_IA, time_us_64(), input_latest());                // Conta a inatividade a partir daqui
+    iniciar_apresentacao(&apresentacao, ECONOMIA_ENERGIA);                                                      // Antes do núcleo 1 começar a desenhar
     
+    replay_init(&gravacao, &gravacao_inicio, sizeof(gravacao_inicio), gravacao_entradas, CAPACIDADE_GRAVACAO,
+                gravacao_pontos, PONTOS_GRAVACAO);                                                              // Gravação parada até o comando 'g'
+    sched_init(&agendador, PERIODO_SIMULACAO_US, PERIODO_QUADRO_US, relogio_placa, NULL);                       // Prazos começam a contar agora (os quadros, no núcleo 1)
+
+#if PIPELINE_DOIS_NUCLEOS
+    spsc_latest_init(&ultimo_quadro, quadros, sizeof(struct EstadoJogo));                                       // Prepara a caixa entre os núcleos
+    spsc_latest_publish(&ultimo_quadro, &estado);                                                               // Estado inicial para o primeiro quadro
+    multicore_launch_core1(nucleo1_renderizar);                                                                 // Núcleo 1 passa a cuidar do display
+
+    while (1) {                                                                                                 // Loop de simulação do núcleo 0
+        uint32_t passos = sched_ticks_due(&agendador);                                                          // Ticks vencidos desde a última volta
+        while (passos--) {
+            passo_jogo(&laco, &estado, passo_simulacao);                                                        // Entrada, IA e física em passo fixo (nada se pausado)
+            spsc_latest_publish(&ultimo_quadro, &estado);                                                       // Publica o instantâneo, substituindo o que o núcleo 1 ainda não leu
+        }
+        verificar_atividade(&estado);                                                                           // Pausa, ou entra ou sai da demonstração
+        processar_comandos(&estado);                                                                            // Telemetria lida aqui; campos do núcleo 1 podem estar um quadro defasados
+        dormir_ate(&agendador, agendador.next_tick, acordar_na_demonstracao);                                   // Dorme até o próximo passo; na demonstração, até mexerem no joystick
+    }
+#else
     while (1) {                                                                                                 // Loop principal do jogo
-        ler_joystick(&estado);                                                                                  // Lê entrada do jogador
-        atualizar_ia(&estado);                                                                                  // Atualiza IA
-        atualizar_bola(&estado);                                                                                // Atualiza física da bola
-        desenhar_jogo(&estado);                                                                                 // Renderiza cena
-        sleep_ms(16);                                                                                           // Controla FPS (~60Hz)
+        uint32_t passos = sched_ticks_due(&agendador);                                                          // Ticks vencidos desde a última volta
+        while (passos--) {
+            passo_jogo(&laco, &estado, passo_simulacao);                                                        // Entrada, IA e física em passo fixo (nada se pausado)
+        }
+        verificar_atividade(&estado);                                                                           // Pausa, ou entra ou sai da demonstração
+        if (sched_frame_due(&agendador)) {                                                                      // Renderiza só no prazo do quadro
+            mostrar_quadro(&estado);
+        }
+        processar_comandos(&estado);                                                                            // Atende pedidos de telemetria pelo stdio
+        dormir_ate(&agendador, sched_next_deadline(&agendador), acordar_na_demonstracao);                       // Dorme até o próximo prazo
     }
+#endif
     
     return 0;
-}
\ No newline at end of file
+}